@@ -0,0 +1,285 @@
+#include "ColumnTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cwchar>
+
+namespace jojogame
+{
+CColumnTable::CColumnTable()
+{
+}
+
+CColumnTable::~CColumnTable()
+{
+}
+
+int CColumnTable::GetColumnCount() const
+{
+    return static_cast<int>(_columns.size());
+}
+
+int CColumnTable::GetRowCount() const
+{
+    return _rowCount;
+}
+
+int CColumnTable::GetViewRowCount() const
+{
+    return static_cast<int>(_view.size());
+}
+
+int CColumnTable::GetViewRow(int viewIndex) const
+{
+    if (viewIndex < 0 || viewIndex >= static_cast<int>(_view.size()))
+    {
+        return -1;
+    }
+
+    return _view[viewIndex];
+}
+
+int CColumnTable::GetColumnType(int columnIndex) const
+{
+    if (columnIndex < 0 || columnIndex >= static_cast<int>(_columns.size()))
+    {
+        return -1;
+    }
+
+    return _columns[columnIndex].type;
+}
+
+double CColumnTable::GetNumber(int rowIndex, int columnIndex) const
+{
+    if (!IsValidCell(rowIndex, columnIndex) || _columns[columnIndex].type != COLUMN_TABLE_NUMBER)
+    {
+        return 0.0;
+    }
+
+    return _columns[columnIndex].numbers[rowIndex];
+}
+
+std::wstring CColumnTable::GetString(int rowIndex, int columnIndex) const
+{
+    if (!IsValidCell(rowIndex, columnIndex) || _columns[columnIndex].type != COLUMN_TABLE_STRING)
+    {
+        return L"";
+    }
+
+    return _columns[columnIndex].strings[rowIndex];
+}
+
+std::wstring CColumnTable::GetText(int rowIndex, int columnIndex) const
+{
+    if (!IsValidCell(rowIndex, columnIndex))
+    {
+        return L"";
+    }
+
+    auto &column = _columns[columnIndex];
+    if (column.type == COLUMN_TABLE_STRING)
+    {
+        return column.strings[rowIndex];
+    }
+
+    wchar_t text[32];
+    double value = column.numbers[rowIndex];
+    if (value == std::floor(value) && std::fabs(value) < 1e15)
+    {
+        swprintf(text, 32, L"%.0f", value);
+    }
+    else
+    {
+        swprintf(text, 32, L"%g", value);
+    }
+
+    return text;
+}
+
+bool CColumnTable::IsValidCell(int rowIndex, int columnIndex) const
+{
+    return rowIndex >= 0 && rowIndex < _rowCount && columnIndex >= 0 &&
+           columnIndex < static_cast<int>(_columns.size());
+}
+
+void CColumnTable::SetNumber(int rowIndex, int columnIndex, double value)
+{
+    if (IsValidCell(rowIndex, columnIndex) && _columns[columnIndex].type == COLUMN_TABLE_NUMBER)
+    {
+        _columns[columnIndex].numbers[rowIndex] = value;
+    }
+}
+
+void CColumnTable::SetString(int rowIndex, int columnIndex, std::wstring value)
+{
+    if (IsValidCell(rowIndex, columnIndex) && _columns[columnIndex].type == COLUMN_TABLE_STRING)
+    {
+        _columns[columnIndex].strings[rowIndex] = std::move(value);
+    }
+}
+
+int CColumnTable::AddNumberColumn()
+{
+    ColumnTableColumn column;
+    column.type = COLUMN_TABLE_NUMBER;
+    column.numbers.resize(_rowCount, 0.0);
+    _columns.push_back(std::move(column));
+
+    return static_cast<int>(_columns.size()) - 1;
+}
+
+int CColumnTable::AddStringColumn()
+{
+    ColumnTableColumn column;
+    column.type = COLUMN_TABLE_STRING;
+    column.strings.resize(_rowCount);
+    _columns.push_back(std::move(column));
+
+    return static_cast<int>(_columns.size()) - 1;
+}
+
+int CColumnTable::AddRow()
+{
+    for (auto &column : _columns)
+    {
+        if (column.type == COLUMN_TABLE_NUMBER)
+        {
+            column.numbers.push_back(0.0);
+        }
+        else
+        {
+            column.strings.emplace_back();
+        }
+    }
+
+    return _rowCount++;
+}
+
+void CColumnTable::Clear()
+{
+    for (auto &column : _columns)
+    {
+        column.numbers.clear();
+        column.strings.clear();
+    }
+
+    _rowCount = 0;
+    _view.clear();
+}
+
+bool CColumnTable::AddSortKey(int columnIndex, bool isAscending)
+{
+    if (columnIndex < 0 || columnIndex >= static_cast<int>(_columns.size()))
+    {
+        return false;
+    }
+
+    _sortKeys.push_back(ColumnTableSortKey{columnIndex, isAscending});
+    return true;
+}
+
+void CColumnTable::ClearSortKeys()
+{
+    _sortKeys.clear();
+}
+
+bool CColumnTable::AddPrefixFilter(int columnIndex, std::wstring prefix)
+{
+    if (GetColumnType(columnIndex) != COLUMN_TABLE_STRING)
+    {
+        return false;
+    }
+
+    _filters.push_back(ColumnTableFilter{columnIndex, std::move(prefix), 0.0, 0.0});
+    return true;
+}
+
+bool CColumnTable::AddRangeFilter(int columnIndex, double minimum, double maximum)
+{
+    if (GetColumnType(columnIndex) != COLUMN_TABLE_NUMBER)
+    {
+        return false;
+    }
+
+    _filters.push_back(ColumnTableFilter{columnIndex, L"", minimum, maximum});
+    return true;
+}
+
+void CColumnTable::ClearFilters()
+{
+    _filters.clear();
+}
+
+void CColumnTable::Update()
+{
+    _view.clear();
+    _view.reserve(_rowCount);
+    for (int i = 0; i < _rowCount; ++i)
+    {
+        if (_IsMatched(i))
+        {
+            _view.push_back(i);
+        }
+    }
+
+    // 같은 값끼리는 원래 순서를 지켜야 열을 차례로 눌러 정렬할 때 앞의 결과가 남는다.
+    if (!_sortKeys.empty())
+    {
+        std::stable_sort(_view.begin(), _view.end(), [this](int left, int right)
+        {
+            return _Compare(left, right) < 0;
+        });
+    }
+}
+
+bool CColumnTable::_IsMatched(int rowIndex) const
+{
+    for (auto &filter : _filters)
+    {
+        auto &column = _columns[filter.columnIndex];
+        if (column.type == COLUMN_TABLE_STRING)
+        {
+            if (column.strings[rowIndex].compare(0, filter.prefix.size(), filter.prefix) != 0)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            double value = column.numbers[rowIndex];
+            if (value < filter.minimum || value > filter.maximum)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+int CColumnTable::_Compare(int leftRow, int rightRow) const
+{
+    for (auto &key : _sortKeys)
+    {
+        auto &column = _columns[key.columnIndex];
+        int result;
+        if (column.type == COLUMN_TABLE_STRING)
+        {
+            result = column.strings[leftRow].compare(column.strings[rightRow]);
+        }
+        else
+        {
+            double left = column.numbers[leftRow];
+            double right = column.numbers[rightRow];
+            result = left < right ? -1 : (left > right ? 1 : 0);
+        }
+
+        if (result != 0)
+        {
+            return key.isAscending ? result : -result;
+        }
+    }
+
+    return 0;
+}
+} // namespace jojogame
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace jojogame
+{
+enum COLUMN_TABLE_TYPE
+{
+    COLUMN_TABLE_NUMBER = 0,
+    COLUMN_TABLE_STRING = 1,
+};
+
+struct ColumnTableColumn
+{
+    int type;
+    std::vector<double> numbers;
+    std::vector<std::wstring> strings;
+};
+
+struct ColumnTableSortKey
+{
+    int columnIndex;
+    bool isAscending;
+};
+
+struct ColumnTableFilter
+{
+    int columnIndex;
+    std::wstring prefix;
+    double minimum;
+    double maximum;
+};
+
+// 열 단위로 값을 저장하고 정렬/필터 결과는 행 번호 배열(view)로만 들고 있는다. 행, 열 모두 0 부터 센다.
+class CColumnTable
+{
+public:
+    CColumnTable();
+    virtual ~CColumnTable();
+
+    int GetColumnCount() const;
+    int GetRowCount() const;
+    int GetViewRowCount() const;
+    int GetViewRow(int viewIndex) const;
+    int GetColumnType(int columnIndex) const;
+    double GetNumber(int rowIndex, int columnIndex) const;
+    std::wstring GetString(int rowIndex, int columnIndex) const;
+    std::wstring GetText(int rowIndex, int columnIndex) const;
+    bool IsValidCell(int rowIndex, int columnIndex) const;
+
+    void SetNumber(int rowIndex, int columnIndex, double value);
+    void SetString(int rowIndex, int columnIndex, std::wstring value);
+
+    int AddNumberColumn();
+    int AddStringColumn();
+    int AddRow();
+    void Clear();
+
+    bool AddSortKey(int columnIndex, bool isAscending);
+    void ClearSortKeys();
+    bool AddPrefixFilter(int columnIndex, std::wstring prefix);
+    bool AddRangeFilter(int columnIndex, double minimum, double maximum);
+    void ClearFilters();
+    void Update();
+
+private:
+    bool _IsMatched(int rowIndex) const;
+    int _Compare(int leftRow, int rightRow) const;
+
+    int _rowCount = 0;
+    std::vector<ColumnTableColumn> _columns;
+    std::vector<ColumnTableSortKey> _sortKeys;
+    std::vector<ColumnTableFilter> _filters;
+    std::vector<int> _view;
+};
+} // namespace jojogame
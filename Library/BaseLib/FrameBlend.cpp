@@ -0,0 +1,83 @@
+#include "FrameBlend.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define JOJO_FRAME_BLEND_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace jojogame
+{
+static inline uint32_t BlendPixel(uint32_t from, uint32_t to, uint32_t fromWeight, uint32_t toWeight)
+{
+    // 두 가중치의 합이 256 이라 채널마다 16비트 안에서 끝난다.
+    uint32_t redBlue = ((from & 0x00FF00FF) * fromWeight + (to & 0x00FF00FF) * toWeight) >> 8;
+    uint32_t alphaGreen = (((from >> 8) & 0x00FF00FF) * fromWeight + ((to >> 8) & 0x00FF00FF) * toWeight) >> 8;
+
+    return (redBlue & 0x00FF00FF) | ((alphaGreen & 0x00FF00FF) << 8);
+}
+
+void CrossfadePixels(uint32_t *dest, const uint32_t *from, const uint32_t *to, size_t count, int weight)
+{
+    weight = weight < 0 ? 0 : (weight > 256 ? 256 : weight);
+    uint32_t toWeight = uint32_t(weight);
+    uint32_t fromWeight = 256 - toWeight;
+    size_t i = 0;
+
+#ifdef JOJO_FRAME_BLEND_SSE2
+    __m128i zero = _mm_setzero_si128();
+    __m128i fromWeights = _mm_set1_epi16(short(fromWeight));
+    __m128i toWeights = _mm_set1_epi16(short(toWeight));
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i fromPixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from + i));
+        __m128i toPixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(to + i));
+
+        __m128i low = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(fromPixels, zero), fromWeights),
+                                    _mm_mullo_epi16(_mm_unpacklo_epi8(toPixels, zero), toWeights));
+        __m128i high = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(fromPixels, zero), fromWeights),
+                                     _mm_mullo_epi16(_mm_unpackhi_epi8(toPixels, zero), toWeights));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i),
+                         _mm_packus_epi16(_mm_srli_epi16(low, 8), _mm_srli_epi16(high, 8)));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        dest[i] = BlendPixel(from[i], to[i], fromWeight, toWeight);
+    }
+}
+
+void FadePixels(uint32_t *dest, const uint32_t *source, size_t count, uint32_t color, int weight)
+{
+    weight = weight < 0 ? 0 : (weight > 256 ? 256 : weight);
+    uint32_t colorWeight = uint32_t(weight);
+    uint32_t sourceWeight = 256 - colorWeight;
+    size_t i = 0;
+
+#ifdef JOJO_FRAME_BLEND_SSE2
+    // 색 쪽은 매 픽셀 같으므로 가중치를 곱한 값을 미리 만들어 둔다.
+    __m128i zero = _mm_setzero_si128();
+    __m128i sourceWeights = _mm_set1_epi16(short(sourceWeight));
+    __m128i colorTerm = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_set1_epi32(int(color)), zero),
+                                        _mm_set1_epi16(short(colorWeight)));
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i sourcePixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+
+        __m128i low = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(sourcePixels, zero), sourceWeights), colorTerm);
+        __m128i high = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(sourcePixels, zero), sourceWeights), colorTerm);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i),
+                         _mm_packus_epi16(_mm_srli_epi16(low, 8), _mm_srli_epi16(high, 8)));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        dest[i] = BlendPixel(source[i], color, sourceWeight, colorWeight);
+    }
+}
+} // namespace jojogame
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace jojogame
+{
+// weight 는 0 ~ 256 이고 256 이면 뒤쪽(to, color) 만 남는다.
+void CrossfadePixels(uint32_t *dest, const uint32_t *from, const uint32_t *to, size_t count, int weight);
+void FadePixels(uint32_t *dest, const uint32_t *source, size_t count, uint32_t color, int weight);
+} // namespace jojogame
@@ -0,0 +1,214 @@
+#include "FrameBuffer.h"
+
+namespace jojogame
+{
+CFrameBuffer::CFrameBuffer()
+{
+}
+
+CFrameBuffer::CFrameBuffer(int width, int height)
+{
+    Resize(width, height);
+}
+
+CFrameBuffer::CFrameBuffer(uint32_t *pixels, int width, int height, int pitch)
+{
+    Attach(pixels, width, height, pitch);
+}
+
+CFrameBuffer::~CFrameBuffer()
+{
+}
+
+int CFrameBuffer::GetWidth() const
+{
+    return _width;
+}
+
+int CFrameBuffer::GetHeight() const
+{
+    return _height;
+}
+
+int CFrameBuffer::GetPitch() const
+{
+    return _pitch;
+}
+
+uint32_t *CFrameBuffer::GetPixels()
+{
+    return _pixels;
+}
+
+uint32_t *CFrameBuffer::GetRow(int y)
+{
+    return _pixels + size_t(y) * _pitch;
+}
+
+const uint32_t *CFrameBuffer::GetRow(int y) const
+{
+    return _pixels + size_t(y) * _pitch;
+}
+
+FrameRect CFrameBuffer::GetBounds() const
+{
+    return FrameRect{0, 0, _width, _height};
+}
+
+void CFrameBuffer::Resize(int width, int height)
+{
+    _width = width > 0 ? width : 0;
+    _height = height > 0 ? height : 0;
+    _pitch = _width;
+
+    _buffer.assign(size_t(_width) * _height, 0);
+    _pixels = _buffer.empty() ? nullptr : _buffer.data();
+}
+
+void CFrameBuffer::Attach(uint32_t *pixels, int width, int height, int pitch)
+{
+    _buffer.clear();
+    _pixels = pixels;
+    _width = width;
+    _height = height;
+    _pitch = pitch;
+}
+
+void CFrameBuffer::Clear(uint32_t color)
+{
+    FillRect(GetBounds(), color);
+}
+
+void CFrameBuffer::FillRect(const FrameRect &rect, uint32_t color)
+{
+    FrameRect fillRect;
+    if (_pixels == nullptr || !IntersectFrameRect(fillRect, rect, GetBounds()))
+    {
+        return;
+    }
+
+    for (int y = fillRect.top; y < fillRect.bottom; ++y)
+    {
+        auto row = GetRow(y);
+        for (int x = fillRect.left; x < fillRect.right; ++x)
+        {
+            row[x] = color;
+        }
+    }
+}
+
+void CFrameBuffer::BlendCoverage(int x, int y, const uint8_t *coverage, int coveragePitch, int width, int height,
+                                 uint32_t color, const FrameRect &clipingRect)
+{
+    FrameRect clip;
+    FrameRect drawRect{x, y, x + width, y + height};
+    if (_pixels == nullptr || !IntersectFrameRect(clip, clipingRect, GetBounds()) ||
+        !IntersectFrameRect(drawRect, drawRect, clip))
+    {
+        return;
+    }
+
+    uint32_t opacity = color >> 24;
+    uint32_t red = (color >> 16) & 0xFF;
+    uint32_t green = (color >> 8) & 0xFF;
+    uint32_t blue = color & 0xFF;
+
+    for (int drawY = drawRect.top; drawY < drawRect.bottom; ++drawY)
+    {
+        auto row = GetRow(drawY);
+        auto coverageRow = coverage + size_t(drawY - y) * coveragePitch;
+        for (int drawX = drawRect.left; drawX < drawRect.right; ++drawX)
+        {
+            uint32_t alpha = coverageRow[drawX - x];
+            if (opacity != 255)
+            {
+                alpha = (alpha * opacity + 127) / 255;
+            }
+            if (alpha == 0)
+            {
+                continue;
+            }
+
+            if (alpha == 255)
+            {
+                row[drawX] = 0xFF000000 | (red << 16) | (green << 8) | blue;
+                continue;
+            }
+
+            uint32_t pixel = row[drawX];
+            uint32_t inverse = 255 - alpha;
+            uint32_t resultRed = (red * alpha + ((pixel >> 16) & 0xFF) * inverse + 127) / 255;
+            uint32_t resultGreen = (green * alpha + ((pixel >> 8) & 0xFF) * inverse + 127) / 255;
+            uint32_t resultBlue = (blue * alpha + (pixel & 0xFF) * inverse + 127) / 255;
+            uint32_t resultAlpha = alpha + ((pixel >> 24) * inverse + 127) / 255;
+
+            row[drawX] = (resultAlpha << 24) | (resultRed << 16) | (resultGreen << 8) | resultBlue;
+        }
+    }
+}
+
+void CFrameBuffer::DrawImage(const CFrameBuffer &source, int sourceX, int sourceY, const FrameRect &destRect,
+                             uint8_t opacity, const FrameRect &clipingRect, const PixelLookup *lookup)
+{
+    FrameRect clip;
+    FrameRect drawRect;
+    if (_pixels == nullptr || opacity == 0 || !IntersectFrameRect(clip, clipingRect, GetBounds()) ||
+        !IntersectFrameRect(drawRect, destRect, clip))
+    {
+        return;
+    }
+
+    // 원본 범위를 벗어나는 부분은 그리지 않는다.
+    FrameRect sourceRect{destRect.left - sourceX, destRect.top - sourceY,
+                         destRect.left - sourceX + source.GetWidth(), destRect.top - sourceY + source.GetHeight()};
+    if (!IntersectFrameRect(drawRect, drawRect, sourceRect))
+    {
+        return;
+    }
+
+    uint32_t inverse = 255 - opacity;
+    for (int drawY = drawRect.top; drawY < drawRect.bottom; ++drawY)
+    {
+        auto row = GetRow(drawY);
+        auto sourceRow = source.GetRow(drawY - destRect.top + sourceY) + (sourceX - destRect.left);
+        for (int drawX = drawRect.left; drawX < drawRect.right; ++drawX)
+        {
+            uint32_t sourcePixel = sourceRow[drawX];
+            if ((sourcePixel >> 24) == 0)
+            {
+                continue;
+            }
+
+            if (lookup != nullptr)
+            {
+                sourcePixel = (sourcePixel & 0xFF000000) | (uint32_t(lookup->red[(sourcePixel >> 16) & 0xFF]) << 16) |
+                              (uint32_t(lookup->green[(sourcePixel >> 8) & 0xFF]) << 8) |
+                              lookup->blue[sourcePixel & 0xFF];
+            }
+
+            uint32_t pixel = row[drawX];
+            if (opacity == 255)
+            {
+                row[drawX] = (pixel & 0xFF000000) | (sourcePixel & 0x00FFFFFF);
+                continue;
+            }
+
+            uint32_t resultRed = (((sourcePixel >> 16) & 0xFF) * opacity + ((pixel >> 16) & 0xFF) * inverse + 127) / 255;
+            uint32_t resultGreen = (((sourcePixel >> 8) & 0xFF) * opacity + ((pixel >> 8) & 0xFF) * inverse + 127) / 255;
+            uint32_t resultBlue = ((sourcePixel & 0xFF) * opacity + (pixel & 0xFF) * inverse + 127) / 255;
+
+            row[drawX] = (pixel & 0xFF000000) | (resultRed << 16) | (resultGreen << 8) | resultBlue;
+        }
+    }
+}
+
+bool CFrameBuffer::IntersectFrameRect(FrameRect &result, const FrameRect &a, const FrameRect &b)
+{
+    result.left = a.left > b.left ? a.left : b.left;
+    result.top = a.top > b.top ? a.top : b.top;
+    result.right = a.right < b.right ? a.right : b.right;
+    result.bottom = a.bottom < b.bottom ? a.bottom : b.bottom;
+
+    return result.left < result.right && result.top < result.bottom;
+}
+} // namespace jojogame
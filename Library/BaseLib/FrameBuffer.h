@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace jojogame
+{
+struct FrameRect
+{
+    int left;
+    int top;
+    int right;
+    int bottom;
+};
+
+// 채널별 색 변환 표 (밝기, 색조 등을 그릴 때 적용한다)
+struct PixelLookup
+{
+    uint8_t red[256];
+    uint8_t green[256];
+    uint8_t blue[256];
+};
+
+// 0xAARRGGBB (메모리 순서 B, G, R, A) 픽셀 버퍼
+// BlendCoverage 의 color 알파는 전체 불투명도, DrawImage 의 원본 알파 0 은 투명(마스크)으로 본다.
+class CFrameBuffer
+{
+public:
+    CFrameBuffer();
+    CFrameBuffer(int width, int height);
+    CFrameBuffer(uint32_t *pixels, int width, int height, int pitch);
+    virtual ~CFrameBuffer();
+
+    int GetWidth() const;
+    int GetHeight() const;
+    int GetPitch() const;
+    uint32_t *GetPixels();
+    uint32_t *GetRow(int y);
+    const uint32_t *GetRow(int y) const;
+    FrameRect GetBounds() const;
+
+    void Resize(int width, int height);
+    void Attach(uint32_t *pixels, int width, int height, int pitch);
+
+    void Clear(uint32_t color);
+    void FillRect(const FrameRect &rect, uint32_t color);
+    void BlendCoverage(int x, int y, const uint8_t *coverage, int coveragePitch, int width, int height,
+                       uint32_t color, const FrameRect &clipingRect);
+    void DrawImage(const CFrameBuffer &source, int sourceX, int sourceY, const FrameRect &destRect, uint8_t opacity,
+                   const FrameRect &clipingRect, const PixelLookup *lookup = nullptr);
+
+    static bool IntersectFrameRect(FrameRect &result, const FrameRect &a, const FrameRect &b);
+
+private:
+    std::vector<uint32_t> _buffer;
+    uint32_t *_pixels = nullptr;
+    int _width = 0;
+    int _height = 0;
+    int _pitch = 0;
+};
+} // namespace jojogame
@@ -0,0 +1,216 @@
+#include "FrameScheduler.h"
+
+#include <chrono>
+
+namespace jojogame
+{
+int64_t CSteadyFrameClock::GetNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+CFrameScheduler::CFrameScheduler(std::unique_ptr<IFrameClock> clock) : _clock(std::move(clock))
+{
+    if (_clock == nullptr)
+    {
+        _clock = std::make_unique<CSteadyFrameClock>();
+    }
+}
+
+CFrameScheduler::~CFrameScheduler()
+{
+}
+
+int64_t CFrameScheduler::GetNow()
+{
+    return _clock->GetNow();
+}
+
+int64_t CFrameScheduler::GetTimestep() const
+{
+    return _timestep;
+}
+
+int CFrameScheduler::GetPacing() const
+{
+    return _pacing;
+}
+
+int CFrameScheduler::GetTargetFrameRate() const
+{
+    return _targetFrameRate;
+}
+
+int CFrameScheduler::GetRefreshRate() const
+{
+    return _refreshRate;
+}
+
+int CFrameScheduler::GetMaxCatchUpSteps() const
+{
+    return _maxCatchUpSteps;
+}
+
+int CFrameScheduler::GetCatchUpPolicy() const
+{
+    return _catchUpPolicy;
+}
+
+double CFrameScheduler::GetInterpolationAlpha() const
+{
+    // 늘려 쓰는 중에는 밀린 시간이 한 스텝보다 클 수 있다.
+    return _lag < _timestep ? double(_lag) / _timestep : 1.0;
+}
+
+int CFrameScheduler::GetSkippedUpdateCount() const
+{
+    return _skippedUpdateCount;
+}
+
+int CFrameScheduler::GetLateFrameCount() const
+{
+    return _lateFrameCount;
+}
+
+void CFrameScheduler::SetTimestep(int64_t timestep)
+{
+    _timestep = timestep > 0 ? timestep : 1;
+}
+
+void CFrameScheduler::SetPacing(int pacing)
+{
+    _pacing = pacing;
+    _nextRenderTime = _clock->GetNow();
+}
+
+void CFrameScheduler::SetTargetFrameRate(int frameRate)
+{
+    _targetFrameRate = frameRate > 0 ? frameRate : 1;
+}
+
+void CFrameScheduler::SetRefreshRate(int refreshRate)
+{
+    _refreshRate = refreshRate > 0 ? refreshRate : 60;
+}
+
+void CFrameScheduler::SetMaxCatchUpSteps(int steps)
+{
+    _maxCatchUpSteps = steps > 1 ? steps : 1;
+}
+
+void CFrameScheduler::SetCatchUpPolicy(int policy)
+{
+    _catchUpPolicy = policy;
+}
+
+void CFrameScheduler::ResetCounters()
+{
+    _skippedUpdateCount = 0;
+    _lateFrameCount = 0;
+}
+
+void CFrameScheduler::Start()
+{
+    _lastTime = _clock->GetNow();
+    _lag = 0;
+    _nextRenderTime = _lastTime;
+    _isRenderPending = true;
+}
+
+int CFrameScheduler::Advance()
+{
+    int64_t now = _clock->GetNow();
+    _lag += now - _lastTime;
+    _lastTime = now;
+
+    int64_t count = _lag / _timestep;
+    if (count > 1)
+    {
+        ++_lateFrameCount;
+    }
+
+    if (count > _maxCatchUpSteps)
+    {
+        if (_catchUpPolicy == FRAME_CATCH_UP_DILATE)
+        {
+            // 남은 시간은 다음 프레임들로 넘겨 천천히 따라잡되, 한 번에 넘기는 양은 제한한다.
+            int64_t maxLag = int64_t(_maxCatchUpSteps) * _timestep * 2;
+            _lag -= _maxCatchUpSteps * _timestep;
+            if (_lag > maxLag)
+            {
+                _skippedUpdateCount += int((_lag - maxLag) / _timestep);
+                _lag = maxLag;
+            }
+        }
+        else
+        {
+            _skippedUpdateCount += int(count - _maxCatchUpSteps);
+            _lag -= count * _timestep;
+        }
+
+        return _maxCatchUpSteps;
+    }
+
+    _lag -= count * _timestep;
+
+    return int(count);
+}
+
+bool CFrameScheduler::ShouldRender(bool isDirty)
+{
+    if (isDirty)
+    {
+        _isRenderPending = true;
+    }
+
+    if (!_isRenderPending)
+    {
+        return false;
+    }
+
+    return _pacing == FRAME_PACING_UNCAPPED || _clock->GetNow() >= _nextRenderTime;
+}
+
+void CFrameScheduler::OnRendered()
+{
+    _isRenderPending = false;
+
+    if (_pacing == FRAME_PACING_UNCAPPED)
+    {
+        return;
+    }
+
+    // 늦게 그렸으면 밀린 프레임을 몰아서 그리지 않고 지금부터 다시 간격을 센다.
+    int64_t now = _clock->GetNow();
+    _nextRenderTime += _GetRenderInterval();
+    if (_nextRenderTime <= now)
+    {
+        _nextRenderTime = now + _GetRenderInterval();
+    }
+}
+
+int64_t CFrameScheduler::GetWaitTime()
+{
+    int64_t now = _clock->GetNow();
+    int64_t deadline = _lastTime + (_timestep - _lag);
+
+    if (_isRenderPending)
+    {
+        if (_pacing == FRAME_PACING_UNCAPPED)
+        {
+            return 0;
+        }
+
+        deadline = _nextRenderTime < deadline ? _nextRenderTime : deadline;
+    }
+
+    return deadline > now ? deadline - now : 0;
+}
+
+int64_t CFrameScheduler::_GetRenderInterval() const
+{
+    int frameRate = _pacing == FRAME_PACING_VSYNC ? _refreshRate : _targetFrameRate;
+    return 1000000000LL / frameRate;
+}
+} // namespace jojogame
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace jojogame
+{
+enum FRAME_PACING
+{
+    FRAME_PACING_UNCAPPED = 0,
+    FRAME_PACING_VSYNC = 1,
+    FRAME_PACING_FIXED = 2,
+};
+
+enum FRAME_CATCH_UP
+{
+    FRAME_CATCH_UP_DROP = 0,
+    FRAME_CATCH_UP_DILATE = 1,
+};
+
+// 나노초 단위 시계 (테스트에서는 가짜 시계로 바꿔 끼운다)
+class IFrameClock
+{
+public:
+    virtual ~IFrameClock()
+    {
+    }
+
+    virtual int64_t GetNow() = 0;
+};
+
+class CSteadyFrameClock : public IFrameClock
+{
+public:
+    int64_t GetNow() override;
+};
+
+// 고정 간격 업데이트와 화면 갱신 시점을 정하고, 다음 할 일까지 쉴 시간을 알려 준다.
+class CFrameScheduler
+{
+public:
+    CFrameScheduler(std::unique_ptr<IFrameClock> clock = nullptr);
+    virtual ~CFrameScheduler();
+
+    int64_t GetNow();
+    int64_t GetTimestep() const;
+    int GetPacing() const;
+    int GetTargetFrameRate() const;
+    int GetRefreshRate() const;
+    int GetMaxCatchUpSteps() const;
+    int GetCatchUpPolicy() const;
+    double GetInterpolationAlpha() const;
+    int GetSkippedUpdateCount() const;
+    int GetLateFrameCount() const;
+
+    void SetTimestep(int64_t timestep);
+    void SetPacing(int pacing);
+    void SetTargetFrameRate(int frameRate);
+    void SetRefreshRate(int refreshRate);
+    void SetMaxCatchUpSteps(int steps);
+    void SetCatchUpPolicy(int policy);
+
+    void ResetCounters();
+
+    void Start();
+    int Advance();
+    bool ShouldRender(bool isDirty);
+    void OnRendered();
+    int64_t GetWaitTime();
+
+private:
+    int64_t _GetRenderInterval() const;
+
+    std::unique_ptr<IFrameClock> _clock;
+
+    int64_t _timestep = 16000000;
+    int64_t _lastTime = 0;
+    int64_t _lag = 0;
+
+    int _maxCatchUpSteps = 5;
+    int _catchUpPolicy = FRAME_CATCH_UP_DROP;
+    int _skippedUpdateCount = 0;
+    int _lateFrameCount = 0;
+
+    int _pacing = FRAME_PACING_UNCAPPED;
+    int _targetFrameRate = 60;
+    int _refreshRate = 60;
+    int64_t _nextRenderTime = 0;
+    bool _isRenderPending = true;
+};
+} // namespace jojogame
@@ -0,0 +1,128 @@
+#include "GlyphAtlas.h"
+
+#include <cstring>
+
+namespace jojogame
+{
+CGlyphAtlas::CGlyphAtlas(std::unique_ptr<IGlyphSource> source, int pageSize)
+    : _source(std::move(source)), _pageSize(pageSize)
+{
+}
+
+CGlyphAtlas::~CGlyphAtlas()
+{
+}
+
+int CGlyphAtlas::GetLineHeight() const
+{
+    return _source->GetLineHeight();
+}
+
+int CGlyphAtlas::GetPageCount() const
+{
+    return static_cast<int>(_pages.size());
+}
+
+int CGlyphAtlas::GetGlyphCount() const
+{
+    return static_cast<int>(_glyphs.size());
+}
+
+const GlyphInfo *CGlyphAtlas::GetGlyph(wchar_t ch)
+{
+    auto iter = _glyphs.find(ch);
+    if (iter != _glyphs.end())
+    {
+        return &iter->second;
+    }
+
+    GlyphInfo info{-1, 0, 0, 0, 0, 0, 0, 0};
+    GlyphBitmap bitmap{};
+    if (_source->RasterizeGlyph(ch, bitmap))
+    {
+        info.offsetX = bitmap.offsetX;
+        info.offsetY = bitmap.offsetY;
+        info.advance = bitmap.advance;
+
+        // 공백처럼 그릴 픽셀이 없는 글자는 진행 폭만 기억한다.
+        if (bitmap.width > 0 && bitmap.height > 0 && _Allocate(bitmap.width, bitmap.height, info))
+        {
+            auto &page = _pages[info.page];
+            for (int y = 0; y < bitmap.height; ++y)
+            {
+                memcpy(&page[size_t(info.y + y) * _pageSize + info.x], &bitmap.coverage[size_t(y) * bitmap.width],
+                       bitmap.width);
+            }
+        }
+    }
+
+    return &_glyphs.emplace(ch, info).first->second;
+}
+
+int CGlyphAtlas::MeasureString(const std::wstring &text)
+{
+    int width = 0;
+    for (auto ch : text)
+    {
+        width += GetGlyph(ch)->advance;
+    }
+
+    return width;
+}
+
+void CGlyphAtlas::DrawString(CFrameBuffer &target, int x, int y, const std::wstring &text, uint32_t color,
+                           const FrameRect &clipingRect)
+{
+    int penX = x;
+    for (auto ch : text)
+    {
+        auto glyph = GetGlyph(ch);
+        if (glyph->page >= 0)
+        {
+            auto &page = _pages[glyph->page];
+            target.BlendCoverage(penX + glyph->offsetX, y + glyph->offsetY,
+                                 &page[size_t(glyph->y) * _pageSize + glyph->x], _pageSize, glyph->width,
+                                 glyph->height, color, clipingRect);
+        }
+
+        penX += glyph->advance;
+    }
+}
+
+bool CGlyphAtlas::_Allocate(int width, int height, GlyphInfo &glyph)
+{
+    if (width > _pageSize || height > _pageSize)
+    {
+        return false;
+    }
+
+    // 선반(shelf) 방식으로 한 줄씩 채우고, 페이지가 차면 새 페이지를 연다.
+    if (_pages.empty() || _shelfX + width > _pageSize)
+    {
+        _shelfX = 0;
+        _shelfY += _shelfHeight;
+        _shelfHeight = 0;
+    }
+    if (_pages.empty() || _shelfY + height > _pageSize)
+    {
+        _pages.emplace_back(size_t(_pageSize) * _pageSize, 0);
+        _shelfX = 0;
+        _shelfY = 0;
+        _shelfHeight = 0;
+    }
+
+    glyph.page = static_cast<int>(_pages.size()) - 1;
+    glyph.x = _shelfX;
+    glyph.y = _shelfY;
+    glyph.width = width;
+    glyph.height = height;
+
+    _shelfX += width;
+    if (height > _shelfHeight)
+    {
+        _shelfHeight = height;
+    }
+
+    return true;
+}
+} // namespace jojogame
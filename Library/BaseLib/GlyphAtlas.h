@@ -0,0 +1,75 @@
+#pragma once
+
+#include "FrameBuffer.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace jojogame
+{
+struct GlyphBitmap
+{
+    int width;
+    int height;
+    int offsetX;
+    int offsetY;
+    int advance;
+    std::vector<uint8_t> coverage;
+};
+
+struct GlyphInfo
+{
+    int page;
+    int x;
+    int y;
+    int width;
+    int height;
+    int offsetX;
+    int offsetY;
+    int advance;
+};
+
+// 글자 한 개를 8비트 커버리지로 래스터화해 주는 쪽 (GDI, 비트맵 폰트 등)
+class IGlyphSource
+{
+public:
+    virtual ~IGlyphSource()
+    {
+    }
+
+    virtual int GetLineHeight() const = 0;
+    virtual bool RasterizeGlyph(wchar_t ch, GlyphBitmap &glyph) = 0;
+};
+
+class CGlyphAtlas
+{
+public:
+    CGlyphAtlas(std::unique_ptr<IGlyphSource> source, int pageSize = 512);
+    virtual ~CGlyphAtlas();
+
+    int GetLineHeight() const;
+    int GetPageCount() const;
+    int GetGlyphCount() const;
+
+    const GlyphInfo *GetGlyph(wchar_t ch);
+    int MeasureString(const std::wstring &text);
+    void DrawString(CFrameBuffer &target, int x, int y, const std::wstring &text, uint32_t color,
+                  const FrameRect &clipingRect);
+
+private:
+    bool _Allocate(int width, int height, GlyphInfo &glyph);
+
+    std::unique_ptr<IGlyphSource> _source;
+    int _pageSize;
+
+    std::vector<std::vector<uint8_t>> _pages;
+    int _shelfX = 0;
+    int _shelfY = 0;
+    int _shelfHeight = 0;
+
+    std::unordered_map<wchar_t, GlyphInfo> _glyphs;
+};
+} // namespace jojogame
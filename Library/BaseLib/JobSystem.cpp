@@ -0,0 +1,449 @@
+#include "JobSystem.h"
+
+#include "TraceRecorder.h"
+
+#include <string>
+
+namespace jojogame
+{
+std::once_flag CJobSystem::s_onceFlag;
+std::unique_ptr<CJobSystem> CJobSystem::s_sharedJobSystem;
+
+// 작업 스레드가 아니면 -1 이고, 이때는 마지막 공용 큐를 쓴다.
+static thread_local int t_workerIndex = -1;
+static thread_local CJobSystem *t_jobSystem = nullptr;
+
+// 스레드마다 다 쓴 작업을 모아 두는 곳으로, 대부분의 할당과 해제가 잠금 없이 끝난다.
+struct JobCache
+{
+    ~JobCache()
+    {
+        for (auto job : jobs)
+        {
+            delete job;
+        }
+    }
+
+    std::vector<Job *> jobs;
+};
+
+static thread_local JobCache t_jobCache;
+
+static const size_t JOB_CACHE_BATCH = 64;
+static const int WORKER_SPIN_COUNT = 16;
+
+CJobCounter::CJobCounter()
+{
+}
+
+CJobCounter::~CJobCounter()
+{
+}
+
+int CJobCounter::GetValue() const
+{
+    return _value.load(std::memory_order_acquire);
+}
+
+bool CJobCounter::IsDone() const
+{
+    return GetValue() == 0;
+}
+
+CJobSystem::CJobSystem(int workerCount)
+{
+    if (workerCount < 0)
+    {
+        int hardwareCount = int(std::thread::hardware_concurrency());
+        workerCount = hardwareCount > 1 ? hardwareCount - 1 : 0;
+    }
+
+    for (int i = 0; i <= workerCount; ++i)
+    {
+        _queues.push_back(std::make_unique<JobQueue>());
+    }
+
+    for (int i = 0; i < workerCount; ++i)
+    {
+        _workers.emplace_back(&CJobSystem::_WorkerProc, this, i);
+    }
+}
+
+CJobSystem::~CJobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _isStopping = true;
+    }
+    _sleepCondition.notify_all();
+
+    for (auto &worker : _workers)
+    {
+        worker.join();
+    }
+
+    for (auto &queue : _queues)
+    {
+        for (auto job : queue->jobs)
+        {
+            delete job;
+        }
+    }
+
+    for (auto job : _freeJobs)
+    {
+        delete job;
+    }
+}
+
+int CJobSystem::GetThreadCount() const
+{
+    return int(_workers.size()) + 1;
+}
+
+int CJobSystem::GetWorkerCount() const
+{
+    return int(_workers.size());
+}
+
+void CJobSystem::Schedule(std::function<void()> function, CJobCounter *counter)
+{
+    if (counter != nullptr)
+    {
+        counter->_value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    _Push(_NewJob(std::move(function), counter));
+}
+
+void CJobSystem::ScheduleAfter(CJobCounter &dependency, std::function<void()> function, CJobCounter *counter)
+{
+    if (counter != nullptr)
+    {
+        counter->_value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto job = _NewJob(std::move(function), counter);
+
+    {
+        // 카운터가 0 이 되는 쪽도 같은 잠금 안에서 목록을 가져가므로 작업을 잃어버리지 않는다.
+        std::lock_guard<std::mutex> lock(dependency._mutex);
+        if (!dependency.IsDone())
+        {
+            dependency._continuations.push_back(job);
+            return;
+        }
+    }
+
+    _Push(job);
+}
+
+void CJobSystem::Wait(CJobCounter &counter)
+{
+    // 기다리는 동안 놀지 않고 남은 작업을 같이 처리한다.
+    while (!counter.IsDone())
+    {
+        Job *job = _Pop();
+        if (job != nullptr)
+        {
+            _Execute(job);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // 마지막 작업은 카운터를 0 으로 만든 뒤에도 잠금을 잡고 다음 작업 목록을 가져간다.
+    // 그 잠금이 풀릴 때까지 기다려야 돌아간 뒤에 카운터를 지워도 작업 스레드가 건드리지 않는다.
+    std::lock_guard<std::mutex> lock(counter._mutex);
+}
+
+void CJobSystem::ParallelFor(int count, const std::function<void(int)> &function)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    if (_workers.empty() || count == 1)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            function(i);
+        }
+        return;
+    }
+
+    // 인덱스마다 작업을 만들지 않고, 스레드 수만큼만 만들어 다음 인덱스를 하나씩 가져가게 한다.
+    // 부른 스레드도 같이 돌므로 작업 스레드가 늦게 깨어나도 기다리지 않는다.
+    std::atomic<int> nextIndex{0};
+    auto runner = [&function, &nextIndex, count] {
+        for (int i = nextIndex.fetch_add(1); i < count; i = nextIndex.fetch_add(1))
+        {
+            function(i);
+        }
+    };
+
+    int jobCount = count < GetThreadCount() ? count : GetThreadCount();
+
+    CJobCounter counter;
+    for (int i = 1; i < jobCount; ++i)
+    {
+        Schedule(runner, &counter);
+    }
+
+    runner();
+    Wait(counter);
+}
+
+void CJobSystem::SetMainThreadWakeUp(std::function<void()> wakeUp)
+{
+    std::lock_guard<std::mutex> lock(_mainThreadMutex);
+    _mainThreadWakeUp = std::move(wakeUp);
+}
+
+void CJobSystem::PostToMainThread(std::function<void()> function)
+{
+    std::lock_guard<std::mutex> lock(_mainThreadMutex);
+    _mainThreadJobs.push_back(std::move(function));
+
+    // 메인 스레드가 메시지를 기다리며 자고 있을 수 있으므로 깨운다.
+    if (_mainThreadWakeUp)
+    {
+        _mainThreadWakeUp();
+    }
+}
+
+int CJobSystem::RunMainThreadJobs()
+{
+    std::vector<std::function<void()>> jobs;
+    {
+        std::lock_guard<std::mutex> lock(_mainThreadMutex);
+        jobs.swap(_mainThreadJobs);
+    }
+
+    for (auto &job : jobs)
+    {
+        job();
+    }
+
+    return int(jobs.size());
+}
+
+CJobSystem &CJobSystem::GetInstance()
+{
+    std::call_once(s_onceFlag,
+                   [] {
+                       s_sharedJobSystem = std::make_unique<jojogame::CJobSystem>();
+                   });
+
+    return *s_sharedJobSystem;
+}
+
+void CJobSystem::_WorkerProc(int index)
+{
+    t_workerIndex = index;
+    t_jobSystem = this;
+
+    std::string name = "Job Worker " + std::to_string(index + 1);
+    TRACE_THREAD_NAME(name.c_str());
+
+    for (;;)
+    {
+        Job *job = _Pop();
+        if (job != nullptr)
+        {
+            _Execute(job);
+            continue;
+        }
+
+        // 작업은 보통 몰려서 들어오므로 바로 잠들지 않고 잠시 양보하며 다음 작업을 기다린다.
+        // 그동안은 잠든 것으로 치지 않으므로 작업을 넣는 쪽이 깨우는 비용을 치르지 않는다.
+        int spinCount = 0;
+        while (spinCount < WORKER_SPIN_COUNT && _pendingJobs.load() == 0)
+        {
+            std::this_thread::yield();
+            ++spinCount;
+        }
+
+        if (spinCount < WORKER_SPIN_COUNT)
+        {
+            continue;
+        }
+
+        // 잠든 수를 먼저 올린 뒤 남은 작업을 확인하므로, 작업을 넣는 쪽과 둘 중 하나는 반드시 상대를 본다.
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleepingWorkers.fetch_add(1);
+        _sleepCondition.wait(lock, [this] { return _isStopping || _pendingJobs.load() > 0; });
+        _sleepingWorkers.fetch_sub(1);
+        if (_isStopping)
+        {
+            return;
+        }
+    }
+}
+
+Job *CJobSystem::_NewJob(std::function<void()> function, CJobCounter *counter)
+{
+    auto &cache = t_jobCache.jobs;
+    if (cache.empty())
+    {
+        std::lock_guard<std::mutex> lock(_freeJobMutex);
+        size_t count = _freeJobs.size() < JOB_CACHE_BATCH ? _freeJobs.size() : JOB_CACHE_BATCH;
+        cache.insert(cache.end(), _freeJobs.end() - count, _freeJobs.end());
+        _freeJobs.resize(_freeJobs.size() - count);
+    }
+
+    if (cache.empty())
+    {
+        return new Job{std::move(function), counter};
+    }
+
+    Job *job = cache.back();
+    cache.pop_back();
+    job->function = std::move(function);
+    job->counter = counter;
+    return job;
+}
+
+void CJobSystem::_DeleteJob(Job *job)
+{
+    // 붙잡고 있던 값들은 바로 놓아 준다.
+    job->function = nullptr;
+
+    auto &cache = t_jobCache.jobs;
+    cache.push_back(job);
+    if (cache.size() < JOB_CACHE_BATCH * 2)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_freeJobMutex);
+    _freeJobs.insert(_freeJobs.end(), cache.end() - JOB_CACHE_BATCH, cache.end());
+    cache.resize(cache.size() - JOB_CACHE_BATCH);
+}
+
+void CJobSystem::_Push(Job *job)
+{
+    // 작업 스레드가 없으면 기다려 줄 스레드가 없을 수도 있으므로 바로 실행한다.
+    if (_workers.empty())
+    {
+        _Execute(job);
+        return;
+    }
+
+    int index = t_jobSystem == this ? t_workerIndex : int(_queues.size()) - 1;
+
+    {
+        std::lock_guard<std::mutex> lock(_queues[index]->mutex);
+        _queues[index]->jobs.push_back(job);
+        _queues[index]->count.fetch_add(1);
+    }
+
+    // 잠든 작업 스레드가 있을 때만 깨운다.
+    // 잠들려던 작업 스레드가 조건을 확인한 뒤 잠들기 전에 알림을 놓치지 않도록 잠금을 한 번 거친다.
+    _pendingJobs.fetch_add(1);
+    if (_sleepingWorkers.load() == 0)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+    }
+    _sleepCondition.notify_one();
+}
+
+Job *CJobSystem::_Pop()
+{
+    if (_pendingJobs.load() == 0)
+    {
+        return nullptr;
+    }
+
+    int queueCount = int(_queues.size());
+    int index = t_jobSystem == this ? t_workerIndex : queueCount - 1;
+
+    // 자기 큐는 뒤에서 꺼내고(캐시에 남아 있는 최근 작업), 다른 큐는 앞에서 훔친다.
+    // 비어 보이는 큐는 잠그지 않고 건너뛴다. 놓친 작업은 다음 _Pop 에서 가져간다.
+    {
+        auto &queue = *_queues[index];
+        if (queue.count.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.jobs.empty())
+            {
+                Job *job = queue.jobs.back();
+                queue.jobs.pop_back();
+                queue.count.fetch_sub(1);
+                _pendingJobs.fetch_sub(1);
+                return job;
+            }
+        }
+    }
+
+    for (int i = 1; i < queueCount; ++i)
+    {
+        auto &queue = *_queues[(index + i) % queueCount];
+        if (queue.count.load() == 0)
+        {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            Job *job = queue.jobs.front();
+            queue.jobs.pop_front();
+            queue.count.fetch_sub(1);
+            _pendingJobs.fetch_sub(1);
+            return job;
+        }
+    }
+
+    return nullptr;
+}
+
+void CJobSystem::_Execute(Job *job)
+{
+    job->function();
+
+    CJobCounter *counter = job->counter;
+    _DeleteJob(job);
+
+    if (counter != nullptr)
+    {
+        _FinishJob(counter);
+    }
+}
+
+void CJobSystem::_FinishJob(CJobCounter *counter)
+{
+    // 마지막 작업이 아니면 잠금 없이 값만 줄인다.
+    // 줄인 뒤에는 기다리던 쪽이 카운터를 지울 수 있으므로 다시 건드리지 않는다.
+    int value = counter->_value.load(std::memory_order_relaxed);
+    while (value > 1)
+    {
+        if (counter->_value.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel))
+        {
+            return;
+        }
+    }
+
+    std::vector<Job *> continuations;
+    {
+        std::lock_guard<std::mutex> lock(counter->_mutex);
+        if (counter->_value.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        {
+            return;
+        }
+        continuations.swap(counter->_continuations);
+    }
+
+    for (auto continuation : continuations)
+    {
+        _Push(continuation);
+    }
+}
+} // namespace jojogame
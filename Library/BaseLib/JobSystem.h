@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace jojogame
+{
+struct Job;
+
+// 남은 작업 수를 센다. 0 이 되면 이 카운터를 기다리던 작업들을 큐에 넣는다.
+class CJobCounter
+{
+public:
+    CJobCounter();
+    ~CJobCounter();
+
+    CJobCounter(const CJobCounter &src) = delete;
+    CJobCounter &operator=(const CJobCounter &rhs) = delete;
+
+    int GetValue() const;
+    bool IsDone() const;
+
+private:
+    std::atomic<int> _value{0};
+    std::mutex _mutex;
+    std::vector<Job *> _continuations;
+
+    friend class CJobSystem;
+};
+
+struct Job
+{
+    std::function<void()> function;
+    CJobCounter *counter;
+};
+
+// 작업 스레드마다 큐를 두고, 자기 큐가 비면 다른 스레드의 큐에서 훔쳐 온다.
+class CJobSystem
+{
+public:
+    CJobSystem(int workerCount = -1);
+    virtual ~CJobSystem();
+
+    int GetThreadCount() const;
+    int GetWorkerCount() const;
+
+    void Schedule(std::function<void()> function, CJobCounter *counter = nullptr);
+    void ScheduleAfter(CJobCounter &dependency, std::function<void()> function, CJobCounter *counter = nullptr);
+    void Wait(CJobCounter &counter);
+    void ParallelFor(int count, const std::function<void(int)> &function);
+
+    void SetMainThreadWakeUp(std::function<void()> wakeUp);
+    void PostToMainThread(std::function<void()> function);
+    int RunMainThreadJobs();
+
+    static CJobSystem &GetInstance();
+
+private:
+    struct JobQueue
+    {
+        std::mutex mutex;
+        std::deque<Job *> jobs;
+        // 잠금 없이 빈 큐를 건너뛰기 위한 작업 수로, 잠금 안에서만 바꾼다.
+        std::atomic<int> count{0};
+    };
+
+    void _WorkerProc(int index);
+    Job *_NewJob(std::function<void()> function, CJobCounter *counter);
+    void _DeleteJob(Job *job);
+    void _Push(Job *job);
+    Job *_Pop();
+    void _Execute(Job *job);
+    void _FinishJob(CJobCounter *counter);
+
+    std::vector<std::unique_ptr<JobQueue>> _queues;
+    std::vector<std::thread> _workers;
+
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCondition;
+    std::atomic<int> _pendingJobs{0};
+    std::atomic<int> _sleepingWorkers{0};
+    bool _isStopping = false;
+
+    // 다 쓴 작업은 스레드마다 모아 두고, 너무 많아지면 여기로 옮겨 다른 스레드가 가져다 쓴다.
+    std::mutex _freeJobMutex;
+    std::vector<Job *> _freeJobs;
+
+    std::mutex _mainThreadMutex;
+    std::vector<std::function<void()>> _mainThreadJobs;
+    std::function<void()> _mainThreadWakeUp;
+
+    static std::once_flag s_onceFlag;
+    static std::unique_ptr<CJobSystem> s_sharedJobSystem;
+};
+} // namespace jojogame
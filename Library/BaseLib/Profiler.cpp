@@ -0,0 +1,383 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+namespace jojogame
+{
+std::atomic<bool> CProfiler::s_isRecording{false};
+std::once_flag CProfiler::s_onceFlag;
+std::unique_ptr<CProfiler> CProfiler::s_sharedProfiler;
+
+// 스레드가 끝나면 링 버퍼를 돌려줘서 다음에 생기는 스레드가 다시 쓰게 한다.
+class CProfileRingOwner
+{
+public:
+    ~CProfileRingOwner()
+    {
+        if (ring != nullptr)
+        {
+            CProfiler::GetInstance()._ReleaseRing(ring);
+        }
+    }
+
+    CProfileRing *ring = nullptr;
+};
+
+static thread_local CProfileRingOwner t_ringOwner;
+
+bool CProfileRing::Push(const ProfileSample &sample)
+{
+    uint32_t head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) >= CAPACITY)
+    {
+        _droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    _samples[head % CAPACITY] = sample;
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool CProfileRing::Pop(ProfileSample &sample)
+{
+    uint32_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail == _head.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    sample = _samples[tail % CAPACITY];
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+int CProfileRing::GetDroppedCount() const
+{
+    return _droppedCount.load(std::memory_order_relaxed);
+}
+
+bool CProfileRing::IsOwned() const
+{
+    return _isOwned;
+}
+
+void CProfileRing::SetOwned(bool value)
+{
+    _isOwned = value;
+}
+
+CProfiler::CProfiler()
+{
+}
+
+CProfiler::~CProfiler()
+{
+}
+
+int64_t CProfiler::GetNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+int CProfiler::GetZoneCount()
+{
+    std::lock_guard<std::mutex> lock(_zoneMutex);
+    return int(_zones.size());
+}
+
+std::string CProfiler::GetZoneName(int zone)
+{
+    std::lock_guard<std::mutex> lock(_zoneMutex);
+    if (zone < 0 || zone >= int(_zones.size()))
+    {
+        return "";
+    }
+
+    return _zones[zone]->name;
+}
+
+int CProfiler::FindZone(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(_zoneMutex);
+    for (size_t i = 0; i < _zones.size(); ++i)
+    {
+        if (_zones[i]->name == name)
+        {
+            return int(i);
+        }
+    }
+
+    return -1;
+}
+
+int CProfiler::GetSampleCount(int zone)
+{
+    std::lock_guard<std::mutex> lock(_zoneMutex);
+    if (zone < 0 || zone >= int(_zones.size()))
+    {
+        return 0;
+    }
+
+    return _zones[zone]->windowCount;
+}
+
+double CProfiler::GetMin(int zone)
+{
+    std::lock_guard<std::mutex> lock(_zoneMutex);
+    if (zone < 0 || zone >= int(_zones.size()) || _zones[zone]->windowCount == 0)
+    {
+        return 0.0;
+    }
+
+    auto &data = *_zones[zone];
+    return *std::min_element(data.window, data.window + data.windowCount) / 1000000.0;
+}
+
+double CProfiler::GetAverage(int zone)
+{
+    std::lock_guard<std::mutex> lock(_zoneMutex);
+    if (zone < 0 || zone >= int(_zones.size()) || _zones[zone]->windowCount == 0)
+    {
+        return 0.0;
+    }
+
+    auto &data = *_zones[zone];
+    int64_t total = 0;
+    for (int i = 0; i < data.windowCount; ++i)
+    {
+        total += data.window[i];
+    }
+
+    return double(total) / data.windowCount / 1000000.0;
+}
+
+double CProfiler::GetPercentile(int zone, double percent)
+{
+    std::lock_guard<std::mutex> lock(_zoneMutex);
+    if (zone < 0 || zone >= int(_zones.size()) || _zones[zone]->windowCount == 0)
+    {
+        return 0.0;
+    }
+
+    auto &data = *_zones[zone];
+    std::vector<int64_t> sorted(data.window, data.window + data.windowCount);
+
+    percent = percent < 0.0 ? 0.0 : (percent > 100.0 ? 100.0 : percent);
+    size_t index = size_t(percent / 100.0 * (sorted.size() - 1) + 0.5);
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+
+    return sorted[index] / 1000000.0;
+}
+
+double CProfiler::GetMax(int zone)
+{
+    std::lock_guard<std::mutex> lock(_zoneMutex);
+    if (zone < 0 || zone >= int(_zones.size()))
+    {
+        return 0.0;
+    }
+
+    return _zones[zone]->maxTime / 1000000.0;
+}
+
+int64_t CProfiler::GetCounter(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(_zoneMutex);
+    auto iter = _counters.find(name);
+    return iter != _counters.end() ? iter->second : 0;
+}
+
+int CProfiler::GetDroppedCount()
+{
+    std::lock_guard<std::mutex> lock(_ringMutex);
+    int count = 0;
+    for (auto &ring : _rings)
+    {
+        count += ring->GetDroppedCount();
+    }
+
+    return count;
+}
+
+void CProfiler::SetRecording(bool value)
+{
+    s_isRecording.store(value, std::memory_order_relaxed);
+}
+
+void CProfiler::SetCounter(const std::string &name, int64_t value)
+{
+    std::lock_guard<std::mutex> lock(_zoneMutex);
+    _counters[name] = value;
+}
+
+int CProfiler::RegisterZone(const char *name)
+{
+    std::lock_guard<std::mutex> lock(_zoneMutex);
+
+    // 같은 이름은 같은 구역으로 모은다.
+    for (size_t i = 0; i < _zones.size(); ++i)
+    {
+        if (_zones[i]->name == name)
+        {
+            return int(i);
+        }
+    }
+
+    auto zone = std::make_unique<ProfileZone>();
+    zone->name = name;
+    _zones.push_back(std::move(zone));
+
+    return int(_zones.size()) - 1;
+}
+
+void CProfiler::Record(int zone, int64_t begin, int64_t end)
+{
+    CProfileRing *ring = t_ringOwner.ring;
+    if (ring == nullptr)
+    {
+        ring = _GetRing();
+        t_ringOwner.ring = ring;
+    }
+
+    ring->Push(ProfileSample{zone, begin, end});
+}
+
+void CProfiler::Collect()
+{
+    std::lock_guard<std::mutex> ringLock(_ringMutex);
+    std::lock_guard<std::mutex> zoneLock(_zoneMutex);
+
+    ProfileSample sample;
+    for (auto &ring : _rings)
+    {
+        while (ring->Pop(sample))
+        {
+            if (sample.zone < 0 || sample.zone >= int(_zones.size()))
+            {
+                continue;
+            }
+
+            auto &data = *_zones[sample.zone];
+            int64_t duration = sample.end - sample.begin;
+
+            data.window[data.windowNext] = duration;
+            data.windowNext = (data.windowNext + 1) % WINDOW_SIZE;
+            data.windowCount = data.windowCount < WINDOW_SIZE ? data.windowCount + 1 : WINDOW_SIZE;
+
+            ++data.totalCount;
+            data.totalTime += duration;
+            data.maxTime = duration > data.maxTime ? duration : data.maxTime;
+        }
+    }
+}
+
+void CProfiler::Reset()
+{
+    Collect();
+
+    std::lock_guard<std::mutex> lock(_zoneMutex);
+    for (auto &zone : _zones)
+    {
+        zone->windowCount = 0;
+        zone->windowNext = 0;
+        zone->totalCount = 0;
+        zone->totalTime = 0;
+        zone->maxTime = 0;
+    }
+    _counters.clear();
+}
+
+bool CProfiler::SaveCsv(const std::string &path)
+{
+    Collect();
+
+    int zoneCount = GetZoneCount();
+    std::vector<std::string> lines;
+    for (int i = 0; i < zoneCount; ++i)
+    {
+        int64_t totalCount;
+        int64_t totalTime;
+        {
+            std::lock_guard<std::mutex> lock(_zoneMutex);
+            totalCount = _zones[i]->totalCount;
+            totalTime = _zones[i]->totalTime;
+        }
+
+        if (totalCount == 0)
+        {
+            continue;
+        }
+
+        lines.push_back(GetZoneName(i) + "," + std::to_string(totalCount) + "," +
+                        std::to_string(totalTime / double(totalCount) / 1000000.0) + "," +
+                        std::to_string(GetMin(i)) + "," + std::to_string(GetAverage(i)) + "," +
+                        std::to_string(GetPercentile(i, 99.0)) + "," + std::to_string(GetMax(i)));
+    }
+
+    std::lock_guard<std::mutex> lock(_zoneMutex);
+    if (lines.empty() && _counters.empty())
+    {
+        return false;
+    }
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    file << "zone,count,total_avg_ms,min_ms,avg_ms,p99_ms,max_ms\n";
+    for (auto &line : lines)
+    {
+        file << line << "\n";
+    }
+
+    if (!_counters.empty())
+    {
+        file << "\ncounter,value\n";
+        for (auto &counter : _counters)
+        {
+            file << counter.first << "," << counter.second << "\n";
+        }
+    }
+
+    return true;
+}
+
+CProfiler &CProfiler::GetInstance()
+{
+    std::call_once(s_onceFlag,
+                   [] {
+                       s_sharedProfiler = std::make_unique<jojogame::CProfiler>();
+                   });
+
+    return *s_sharedProfiler;
+}
+
+CProfileRing *CProfiler::_GetRing()
+{
+    std::lock_guard<std::mutex> lock(_ringMutex);
+    for (auto &ring : _rings)
+    {
+        if (!ring->IsOwned())
+        {
+            ring->SetOwned(true);
+            return ring.get();
+        }
+    }
+
+    _rings.push_back(std::make_unique<CProfileRing>());
+    _rings.back()->SetOwned(true);
+    return _rings.back().get();
+}
+
+void CProfiler::_ReleaseRing(CProfileRing *ring)
+{
+    std::lock_guard<std::mutex> lock(_ringMutex);
+    ring->SetOwned(false);
+}
+} // namespace jojogame
@@ -0,0 +1,168 @@
+#pragma once
+
+// 0 으로 정의하면 PROFILE_ZONE 이 아무 코드도 만들지 않는다.
+#ifndef JOJO_PROFILE
+#define JOJO_PROFILE 1
+#endif
+
+#include "TraceRecorder.h"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace jojogame
+{
+struct ProfileSample
+{
+    int zone;
+    int64_t begin;
+    int64_t end;
+};
+
+// 소유한 스레드 하나만 쓰고 수집하는 스레드 하나만 읽는 고정 크기 링 버퍼
+class CProfileRing
+{
+public:
+    static const uint32_t CAPACITY = 4096;
+
+    bool Push(const ProfileSample &sample);
+    bool Pop(ProfileSample &sample);
+
+    int GetDroppedCount() const;
+
+    bool IsOwned() const;
+    void SetOwned(bool value);
+
+private:
+    ProfileSample _samples[CAPACITY];
+    std::atomic<uint32_t> _head{0};
+    std::atomic<uint32_t> _tail{0};
+    std::atomic<int> _droppedCount{0};
+    bool _isOwned = false;
+};
+
+class CProfiler
+{
+public:
+    static const int WINDOW_SIZE = 256;
+
+    CProfiler();
+    virtual ~CProfiler();
+
+    static bool IsRecording()
+    {
+        return s_isRecording.load(std::memory_order_relaxed);
+    }
+
+    static int64_t GetNow();
+
+    int GetZoneCount();
+    std::string GetZoneName(int zone);
+    int FindZone(const std::string &name);
+    int GetSampleCount(int zone);
+    double GetMin(int zone);
+    double GetAverage(int zone);
+    double GetPercentile(int zone, double percent);
+    double GetMax(int zone);
+    int64_t GetCounter(const std::string &name);
+    int GetDroppedCount();
+
+    void SetRecording(bool value);
+    void SetCounter(const std::string &name, int64_t value);
+
+    int RegisterZone(const char *name);
+    void Record(int zone, int64_t begin, int64_t end);
+    void Collect();
+    void Reset();
+
+    bool SaveCsv(const std::string &path);
+
+    static CProfiler &GetInstance();
+
+private:
+    struct ProfileZone
+    {
+        std::string name;
+        int64_t window[WINDOW_SIZE];
+        int windowCount = 0;
+        int windowNext = 0;
+        int64_t totalCount = 0;
+        int64_t totalTime = 0;
+        int64_t maxTime = 0;
+    };
+
+    CProfileRing *_GetRing();
+    void _ReleaseRing(CProfileRing *ring);
+
+    std::mutex _ringMutex;
+    std::vector<std::unique_ptr<CProfileRing>> _rings;
+
+    std::mutex _zoneMutex;
+    std::vector<std::unique_ptr<ProfileZone>> _zones;
+    std::map<std::string, int64_t> _counters;
+
+    static std::atomic<bool> s_isRecording;
+
+    static std::once_flag s_onceFlag;
+    static std::unique_ptr<CProfiler> s_sharedProfiler;
+
+    friend class CProfileRingOwner;
+};
+
+// 트레이스를 기록하는 중이면 같은 구역을 트레이스 구간으로도 남긴다.
+class CProfileScope
+{
+public:
+    CProfileScope(int zone, const char *name)
+        : _zone(zone), _name(name), _isRecording(CProfiler::IsRecording()),
+          _isTracing(CTraceRecorder::IsRecording())
+    {
+        if (_isRecording)
+        {
+            _begin = CProfiler::GetNow();
+        }
+        if (_isTracing)
+        {
+            CTraceRecorder::GetInstance().Begin(_name);
+        }
+    }
+
+    ~CProfileScope()
+    {
+        if (_isTracing)
+        {
+            CTraceRecorder::GetInstance().End(_name);
+        }
+        if (_isRecording)
+        {
+            CProfiler::GetInstance().Record(_zone, _begin, CProfiler::GetNow());
+        }
+    }
+
+    CProfileScope(const CProfileScope &src) = delete;
+    CProfileScope &operator=(const CProfileScope &rhs) = delete;
+
+private:
+    int _zone;
+    const char *_name;
+    bool _isRecording;
+    bool _isTracing;
+    int64_t _begin = 0;
+};
+} // namespace jojogame
+
+#if JOJO_PROFILE
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name)                                                                                  \
+    static const int PROFILE_CONCAT(s_profileZone, __LINE__) =                                              \
+        jojogame::CProfiler::GetInstance().RegisterZone(name);                                              \
+    jojogame::CProfileScope PROFILE_CONCAT(profileScope, __LINE__)(PROFILE_CONCAT(s_profileZone, __LINE__), name)
+#else
+#define PROFILE_ZONE(name)
+#endif
@@ -0,0 +1,168 @@
+#include "TimerQueue.h"
+
+#include <algorithm>
+
+namespace jojogame
+{
+CTimerQueue::CTimerQueue()
+{
+}
+
+CTimerQueue::~CTimerQueue()
+{
+}
+
+int CTimerQueue::GetCount() const
+{
+    return int(_timers.size());
+}
+
+bool CTimerQueue::IsEmpty() const
+{
+    return _timers.empty();
+}
+
+bool CTimerQueue::IsExist(int id) const
+{
+    return _timers.find(id) != _timers.end();
+}
+
+int64_t CTimerQueue::GetNextDueTime()
+{
+    _PopStale();
+    return _heap.empty() ? INT64_MAX : _heap.front().dueTime;
+}
+
+int CTimerQueue::Add(int64_t dueTime, int64_t interval)
+{
+    // 번호가 한 바퀴 돌았으면 아직 살아 있는 타이머의 번호는 건너뛴다.
+    int id;
+    do
+    {
+        id = _nextId++;
+        if (_nextId <= 0)
+        {
+            _nextId = 1;
+        }
+    } while (IsExist(id));
+
+    _timers[id] = TimerState{0, interval > 0 ? interval : 0};
+    _Push(id, dueTime);
+
+    return id;
+}
+
+bool CTimerQueue::Reschedule(int id, int64_t dueTime)
+{
+    if (!IsExist(id))
+    {
+        return false;
+    }
+
+    // 힙 안의 예전 항목은 순번이 달라져 버려지게 된다.
+    _Push(id, dueTime);
+    _Compact();
+    return true;
+}
+
+bool CTimerQueue::Remove(int id)
+{
+    // 힙에서는 바로 빼지 않고, 맨 위로 올라오거나 힙을 다시 만들 때 버린다.
+    if (_timers.erase(id) == 0)
+    {
+        return false;
+    }
+
+    _Compact();
+    return true;
+}
+
+void CTimerQueue::Clear()
+{
+    _heap.clear();
+    _timers.clear();
+}
+
+int CTimerQueue::PopExpired(int64_t now, std::vector<int> &expiredTimers)
+{
+    int count = 0;
+
+    for (;;)
+    {
+        _PopStale();
+        if (_heap.empty() || _heap.front().dueTime > now)
+        {
+            break;
+        }
+
+        TimerEntry entry = _heap.front();
+        std::pop_heap(_heap.begin(), _heap.end(), _IsLater);
+        _heap.pop_back();
+
+        expiredTimers.push_back(entry.id);
+        ++count;
+
+        auto iter = _timers.find(entry.id);
+        if (iter->second.interval > 0)
+        {
+            // 밀린 주기를 한꺼번에 몰아서 부르지 않고 지금부터 다시 센다.
+            int64_t dueTime = entry.dueTime + iter->second.interval;
+            _Push(entry.id, dueTime > now ? dueTime : now + iter->second.interval);
+        }
+        else
+        {
+            _timers.erase(iter);
+        }
+    }
+
+    return count;
+}
+
+bool CTimerQueue::_IsLater(const TimerEntry &left, const TimerEntry &right)
+{
+    return left.dueTime != right.dueTime ? left.dueTime > right.dueTime : left.sequence > right.sequence;
+}
+
+void CTimerQueue::_Push(int id, int64_t dueTime)
+{
+    uint64_t sequence = _nextSequence++;
+    _timers[id].sequence = sequence;
+
+    _heap.push_back(TimerEntry{dueTime, sequence, id});
+    std::push_heap(_heap.begin(), _heap.end(), _IsLater);
+}
+
+void CTimerQueue::_PopStale()
+{
+    while (!_heap.empty())
+    {
+        auto iter = _timers.find(_heap.front().id);
+        if (iter != _timers.end() && iter->second.sequence == _heap.front().sequence)
+        {
+            break;
+        }
+
+        std::pop_heap(_heap.begin(), _heap.end(), _IsLater);
+        _heap.pop_back();
+    }
+}
+
+void CTimerQueue::_Compact()
+{
+    // 살아 있는 타이머는 힙에 항목이 하나씩이므로 나머지는 모두 버려진 항목이다.
+    // 버려진 항목이 절반을 넘으면 힙을 다시 만들어서, 지우기만 반복해도 힙이 끝없이 커지지 않게 한다.
+    size_t staleCount = _heap.size() - _timers.size();
+    if (staleCount < 64 || staleCount <= _timers.size())
+    {
+        return;
+    }
+
+    _heap.erase(std::remove_if(_heap.begin(), _heap.end(),
+                               [this](const TimerEntry &entry) {
+                                   auto iter = _timers.find(entry.id);
+                                   return iter == _timers.end() || iter->second.sequence != entry.sequence;
+                               }),
+                _heap.end());
+    std::make_heap(_heap.begin(), _heap.end(), _IsLater);
+}
+} // namespace jojogame
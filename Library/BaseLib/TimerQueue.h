@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace jojogame
+{
+struct TimerEntry
+{
+    int64_t dueTime;
+    uint64_t sequence;
+    int id;
+};
+
+// 최소 힙으로 만든 타이머 큐. 같은 시각에 만료되는 타이머는 등록한 순서대로 나온다.
+class CTimerQueue
+{
+public:
+    CTimerQueue();
+    virtual ~CTimerQueue();
+
+    int GetCount() const;
+    bool IsEmpty() const;
+    bool IsExist(int id) const;
+    int64_t GetNextDueTime();
+
+    int Add(int64_t dueTime, int64_t interval = 0);
+    bool Reschedule(int id, int64_t dueTime);
+    bool Remove(int id);
+    void Clear();
+
+    int PopExpired(int64_t now, std::vector<int> &expiredTimers);
+
+private:
+    struct TimerState
+    {
+        uint64_t sequence;
+        int64_t interval;
+    };
+
+    static bool _IsLater(const TimerEntry &left, const TimerEntry &right);
+
+    void _Push(int id, int64_t dueTime);
+    void _PopStale();
+    void _Compact();
+
+    std::vector<TimerEntry> _heap;
+    std::unordered_map<int, TimerState> _timers;
+    uint64_t _nextSequence = 0;
+    int _nextId = 1;
+};
+} // namespace jojogame
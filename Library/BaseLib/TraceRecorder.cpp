@@ -0,0 +1,367 @@
+#include "TraceRecorder.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace jojogame
+{
+std::atomic<bool> CTraceRecorder::s_isRecording{false};
+std::once_flag CTraceRecorder::s_onceFlag;
+std::unique_ptr<CTraceRecorder> CTraceRecorder::s_sharedTraceRecorder;
+
+// 스레드가 끝나면 버퍼를 바로 지우고, 아직 쓰지 않은 이벤트가 있으면 쓰는 스레드가 비운 뒤에 지운다.
+class CTraceBufferOwner
+{
+public:
+    ~CTraceBufferOwner()
+    {
+        if (buffer != nullptr)
+        {
+            CTraceRecorder::GetInstance()._ReleaseBuffer(buffer);
+        }
+    }
+
+    TraceThreadBuffer *buffer = nullptr;
+};
+
+static thread_local CTraceBufferOwner t_bufferOwner;
+
+// 기록하지 않을 때도 이름을 기억해 두었다가 버퍼를 만들 때 붙인다.
+static thread_local std::string t_threadName;
+
+static int64_t GetTraceNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+static std::string EscapeTraceString(const std::string &text)
+{
+    std::string result;
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            result.push_back('\\');
+        }
+        result.push_back(c);
+    }
+
+    return result;
+}
+
+CTraceRecorder::CTraceRecorder()
+{
+}
+
+CTraceRecorder::~CTraceRecorder()
+{
+    Stop();
+}
+
+bool CTraceRecorder::Start(const std::string &path)
+{
+    if (IsRecording() || _writer.joinable())
+    {
+        return false;
+    }
+
+    _file.open(path, std::ios::out | std::ios::trunc);
+    if (!_file.is_open())
+    {
+        return false;
+    }
+
+    _file << "{\"traceEvents\":[";
+    _isFirstEvent = true;
+    _startTime = GetTraceNow();
+
+    {
+        // 지난 기록에서 남은 이벤트와 끝난 스레드의 버퍼는 버린다.
+        std::lock_guard<std::mutex> lock(_bufferMutex);
+        for (auto iter = _buffers.begin(); iter != _buffers.end();)
+        {
+            std::lock_guard<std::mutex> bufferLock((*iter)->mutex);
+            if (!(*iter)->isAlive)
+            {
+                iter = _buffers.erase(iter);
+                continue;
+            }
+
+            (*iter)->events.clear();
+            (*iter)->isNameWritten = false;
+            ++iter;
+        }
+    }
+
+    _isFlushRequested = false;
+    _isStopping = false;
+    _writer = std::thread(&CTraceRecorder::_WriterProc, this);
+
+    s_isRecording.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+void CTraceRecorder::Stop()
+{
+    s_isRecording.store(false, std::memory_order_relaxed);
+
+    if (!_writer.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        _isStopping = true;
+    }
+    _writerCondition.notify_one();
+    _writer.join();
+
+    _file << "\n]}\n";
+    _file.close();
+}
+
+void CTraceRecorder::Flush()
+{
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        _isFlushRequested = true;
+    }
+    _writerCondition.notify_one();
+}
+
+void CTraceRecorder::SetThreadName(const char *name)
+{
+    // 오디오 콜백처럼 매번 불리는 곳에서도 이름이 같으면 잠그지도 할당하지도 않는다.
+    if (t_threadName == name)
+    {
+        return;
+    }
+
+    t_threadName = name;
+
+    auto buffer = t_bufferOwner.buffer;
+    if (buffer == nullptr)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    buffer->name = name;
+    buffer->isNameWritten = false;
+}
+
+void CTraceRecorder::Begin(const char *name)
+{
+    _Add(TRACE_EVENT_BEGIN, name, 0);
+}
+
+void CTraceRecorder::End(const char *name)
+{
+    _Add(TRACE_EVENT_END, name, 0);
+}
+
+void CTraceRecorder::Instant(const char *name)
+{
+    _Add(TRACE_EVENT_INSTANT, name, 0);
+}
+
+void CTraceRecorder::Counter(const char *name, int64_t value)
+{
+    _Add(TRACE_EVENT_COUNTER, name, value);
+}
+
+void CTraceRecorder::FlowStart(const char *name, int64_t id)
+{
+    _Add(TRACE_EVENT_FLOW_START, name, id);
+}
+
+void CTraceRecorder::FlowEnd(const char *name, int64_t id)
+{
+    _Add(TRACE_EVENT_FLOW_END, name, id);
+}
+
+CTraceRecorder &CTraceRecorder::GetInstance()
+{
+    std::call_once(s_onceFlag,
+                   [] {
+                       s_sharedTraceRecorder = std::make_unique<jojogame::CTraceRecorder>();
+                   });
+
+    return *s_sharedTraceRecorder;
+}
+
+void CTraceRecorder::_Add(int type, const char *name, int64_t value)
+{
+    if (!IsRecording())
+    {
+        return;
+    }
+
+    auto buffer = _GetBuffer();
+
+    // 쓰는 스레드가 버퍼를 바꿔 갈 때만 겹치므로 거의 경쟁이 없다.
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    buffer->events.push_back(TraceEvent{type, name, GetTraceNow(), value});
+}
+
+TraceThreadBuffer *CTraceRecorder::_GetBuffer()
+{
+    if (t_bufferOwner.buffer != nullptr)
+    {
+        return t_bufferOwner.buffer;
+    }
+
+    std::lock_guard<std::mutex> lock(_bufferMutex);
+    _buffers.push_back(std::make_unique<TraceThreadBuffer>());
+
+    auto buffer = _buffers.back().get();
+    buffer->threadId = _nextThreadId++;
+    buffer->name = t_threadName.empty() ? "Thread " + std::to_string(buffer->threadId) : t_threadName;
+
+    t_bufferOwner.buffer = buffer;
+    return buffer;
+}
+
+void CTraceRecorder::_ReleaseBuffer(TraceThreadBuffer *buffer)
+{
+    // 버퍼를 잠그는 것은 주인 스레드와 _bufferMutex 를 잡은 쓰는 스레드뿐이다.
+    std::lock_guard<std::mutex> lock(_bufferMutex);
+    if (!buffer->events.empty())
+    {
+        buffer->isAlive = false;
+        return;
+    }
+
+    for (auto iter = _buffers.begin(); iter != _buffers.end(); ++iter)
+    {
+        if (iter->get() == buffer)
+        {
+            _buffers.erase(iter);
+            break;
+        }
+    }
+}
+
+void CTraceRecorder::_WriterProc()
+{
+    std::unique_lock<std::mutex> lock(_writerMutex);
+    for (;;)
+    {
+        // 요청이 없어도 주기적으로 비워서 스레드 버퍼가 너무 커지지 않게 한다.
+        _writerCondition.wait_for(lock, std::chrono::milliseconds(500),
+                                  [this] { return _isFlushRequested || _isStopping; });
+
+        bool isStopping = _isStopping;
+        _isFlushRequested = false;
+
+        lock.unlock();
+        _WriteBuffers();
+        lock.lock();
+
+        if (isStopping)
+        {
+            break;
+        }
+    }
+}
+
+void CTraceRecorder::_WriteBuffers()
+{
+    struct PendingBuffer
+    {
+        int threadId;
+        std::string name;
+        std::vector<TraceEvent> events;
+    };
+
+    std::vector<PendingBuffer> pendingBuffers;
+    {
+        std::lock_guard<std::mutex> lock(_bufferMutex);
+        for (auto iter = _buffers.begin(); iter != _buffers.end();)
+        {
+            auto &buffer = *iter;
+            bool isAlive;
+            {
+                std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+
+                PendingBuffer pending;
+                pending.threadId = buffer->threadId;
+                if (!buffer->isNameWritten)
+                {
+                    pending.name = buffer->name;
+                    buffer->isNameWritten = true;
+                }
+                pending.events.swap(buffer->events);
+                isAlive = buffer->isAlive;
+
+                pendingBuffers.push_back(std::move(pending));
+            }
+
+            // 끝난 스레드의 버퍼는 남은 이벤트를 가져왔으니 지운다.
+            if (isAlive)
+            {
+                ++iter;
+            }
+            else
+            {
+                iter = _buffers.erase(iter);
+            }
+        }
+    }
+
+    for (auto &pending : pendingBuffers)
+    {
+        if (!pending.name.empty())
+        {
+            _file << (_isFirstEvent ? "\n" : ",\n");
+            _file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << pending.threadId
+                  << ",\"args\":{\"name\":\"" << EscapeTraceString(pending.name) << "\"}}";
+            _isFirstEvent = false;
+        }
+
+        for (auto &event : pending.events)
+        {
+            _WriteEvent(event, pending.threadId);
+        }
+    }
+
+    _file.flush();
+}
+
+void CTraceRecorder::_WriteEvent(const TraceEvent &event, int threadId)
+{
+    static const char *const phases[] = {"B", "E", "i", "C", "s", "f"};
+
+    char time[32];
+    snprintf(time, sizeof(time), "%.3f", (event.time - _startTime) / 1000.0);
+
+    _file << (_isFirstEvent ? "\n" : ",\n");
+    _isFirstEvent = false;
+
+    _file << "{\"name\":\"" << EscapeTraceString(event.name) << "\",\"cat\":\"jojo\",\"ph\":\"" << phases[event.type]
+          << "\",\"ts\":" << time << ",\"pid\":1,\"tid\":" << threadId;
+
+    switch (event.type)
+    {
+    case TRACE_EVENT_INSTANT:
+        _file << ",\"s\":\"t\"";
+        break;
+    case TRACE_EVENT_COUNTER:
+        _file << ",\"args\":{\"value\":" << event.value << "}";
+        break;
+    case TRACE_EVENT_FLOW_START:
+        _file << ",\"id\":" << event.value;
+        break;
+    case TRACE_EVENT_FLOW_END:
+        // 흐름 끝은 감싸고 있는 구간에 붙인다.
+        _file << ",\"id\":" << event.value << ",\"bp\":\"e\"";
+        break;
+    default:
+        break;
+    }
+
+    _file << "}";
+}
+} // namespace jojogame
@@ -0,0 +1,170 @@
+#pragma once
+
+// 0 으로 정의하면 TRACE_ 매크로가 아무 코드도 만들지 않는다.
+#ifndef JOJO_TRACE
+#define JOJO_TRACE 1
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace jojogame
+{
+enum TRACE_EVENT_TYPE
+{
+    TRACE_EVENT_BEGIN = 0,
+    TRACE_EVENT_END = 1,
+    TRACE_EVENT_INSTANT = 2,
+    TRACE_EVENT_COUNTER = 3,
+    TRACE_EVENT_FLOW_START = 4,
+    TRACE_EVENT_FLOW_END = 5,
+};
+
+// 이름은 문자열 리터럴처럼 기록이 끝날 때까지 살아 있는 문자열이어야 한다.
+struct TraceEvent
+{
+    int type;
+    const char *name;
+    int64_t time;
+    int64_t value;
+};
+
+struct TraceThreadBuffer
+{
+    std::mutex mutex;
+    std::vector<TraceEvent> events;
+    std::string name;
+    int threadId = 0;
+    bool isNameWritten = false;
+    bool isAlive = true;
+};
+
+// Chrome/Perfetto 가 읽는 JSON 트레이스를 스레드별 버퍼에 모아 백그라운드 스레드가 파일로 쓴다.
+class CTraceRecorder
+{
+public:
+    CTraceRecorder();
+    virtual ~CTraceRecorder();
+
+    static bool IsRecording()
+    {
+        return s_isRecording.load(std::memory_order_relaxed);
+    }
+
+    bool Start(const std::string &path);
+    void Stop();
+    void Flush();
+
+    void SetThreadName(const char *name);
+
+    void Begin(const char *name);
+    void End(const char *name);
+    void Instant(const char *name);
+    void Counter(const char *name, int64_t value);
+    void FlowStart(const char *name, int64_t id);
+    void FlowEnd(const char *name, int64_t id);
+
+    static CTraceRecorder &GetInstance();
+
+private:
+    void _Add(int type, const char *name, int64_t value);
+    TraceThreadBuffer *_GetBuffer();
+    void _ReleaseBuffer(TraceThreadBuffer *buffer);
+    void _WriterProc();
+    void _WriteBuffers();
+    void _WriteEvent(const TraceEvent &event, int threadId);
+
+    std::mutex _bufferMutex;
+    std::vector<std::unique_ptr<TraceThreadBuffer>> _buffers;
+    int _nextThreadId = 1;
+    unsigned int _session = 0;
+
+    std::mutex _writerMutex;
+    std::condition_variable _writerCondition;
+    std::thread _writer;
+    bool _isFlushRequested = false;
+    bool _isStopping = false;
+
+    std::ofstream _file;
+    bool _isFirstEvent = true;
+    int64_t _startTime = 0;
+
+    static std::atomic<bool> s_isRecording;
+
+    static std::once_flag s_onceFlag;
+    static std::unique_ptr<CTraceRecorder> s_sharedTraceRecorder;
+
+    friend class CTraceBufferOwner;
+};
+
+class CTraceScope
+{
+public:
+    explicit CTraceScope(const char *name) : _name(name), _isRecording(CTraceRecorder::IsRecording())
+    {
+        if (_isRecording)
+        {
+            CTraceRecorder::GetInstance().Begin(_name);
+        }
+    }
+
+    ~CTraceScope()
+    {
+        if (_isRecording)
+        {
+            CTraceRecorder::GetInstance().End(_name);
+        }
+    }
+
+    CTraceScope(const CTraceScope &src) = delete;
+    CTraceScope &operator=(const CTraceScope &rhs) = delete;
+
+private:
+    const char *_name;
+    bool _isRecording;
+};
+} // namespace jojogame
+
+#if JOJO_TRACE
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) jojogame::CTraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_THREAD_NAME(name) jojogame::CTraceRecorder::GetInstance().SetThreadName(name)
+#define TRACE_COUNTER(name, value)                                    \
+    do                                                                \
+    {                                                                 \
+        if (jojogame::CTraceRecorder::IsRecording())                  \
+        {                                                             \
+            jojogame::CTraceRecorder::GetInstance().Counter(name, value); \
+        }                                                             \
+    } while (0)
+#define TRACE_FLOW_START(name, id)                                    \
+    do                                                                \
+    {                                                                 \
+        if (jojogame::CTraceRecorder::IsRecording())                  \
+        {                                                             \
+            jojogame::CTraceRecorder::GetInstance().FlowStart(name, id); \
+        }                                                             \
+    } while (0)
+#define TRACE_FLOW_END(name, id)                                      \
+    do                                                                \
+    {                                                                 \
+        if (jojogame::CTraceRecorder::IsRecording())                  \
+        {                                                             \
+            jojogame::CTraceRecorder::GetInstance().FlowEnd(name, id); \
+        }                                                             \
+    } while (0)
+#else
+#define TRACE_SCOPE(name)
+#define TRACE_THREAD_NAME(name)
+#define TRACE_COUNTER(name, value)
+#define TRACE_FLOW_START(name, id)
+#define TRACE_FLOW_END(name, id)
+#endif
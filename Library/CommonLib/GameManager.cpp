@@ -1,5 +1,7 @@
 #include "GameManager.h"
+#include "BaseLib/JobSystem.h"
 #include "BaseLib/MemoryPool.h"
+#include "BaseLib/Profiler.h"
 #include "LuaLib/LuaTinker.h"
 #include "ME5File.h"
 #include <atomic>
@@ -19,11 +21,36 @@ void CGameManager::RegisterFunctions(lua_State *L)
     LUA_METHOD(Quit);
     LUA_METHOD(Delay);
     LUA_METHOD(StopDelay);
+    LUA_METHOD(Run);
+    LUA_METHOD(Sleep);
+    LUA_METHOD(SetTimeout);
+    LUA_METHOD(SetInterval);
+    LUA_METHOD(ClearTimer);
+    LUA_METHOD(GetTimerCount);
     LUA_METHOD(Color);
     LUA_METHOD(GetNow);
     LUA_METHOD(OpenFile);
     LUA_METHOD(CloseFile);
     LUA_METHOD(SetUpdateEvent);
+    LUA_METHOD(GetFramePacing);
+    LUA_METHOD(GetTargetFrameRate);
+    LUA_METHOD(SetFramePacing);
+    LUA_METHOD(SetTargetFrameRate);
+    LUA_METHOD(GetMaxCatchUpSteps);
+    LUA_METHOD(GetCatchUpPolicy);
+    LUA_METHOD(GetInterpolationAlpha);
+    LUA_METHOD(GetSkippedUpdateCount);
+    LUA_METHOD(GetLateFrameCount);
+    LUA_METHOD(SetMaxCatchUpSteps);
+    LUA_METHOD(SetCatchUpPolicy);
+    LUA_METHOD(ResetFrameCounters);
+
+    lua_tinker::set(L, "FRAME_PACING_UNCAPPED", static_cast<int>(FRAME_PACING_UNCAPPED));
+    lua_tinker::set(L, "FRAME_PACING_VSYNC", static_cast<int>(FRAME_PACING_VSYNC));
+    lua_tinker::set(L, "FRAME_PACING_FIXED", static_cast<int>(FRAME_PACING_FIXED));
+
+    lua_tinker::set(L, "FRAME_CATCH_UP_DROP", static_cast<int>(FRAME_CATCH_UP_DROP));
+    lua_tinker::set(L, "FRAME_CATCH_UP_DILATE", static_cast<int>(FRAME_CATCH_UP_DILATE));
 }
 
 CGameManager::CGameManager()
@@ -68,6 +95,51 @@ int CGameManager::GetNow()
     return GetTickCount();
 }
 
+int CGameManager::GetFramePacing()
+{
+    return _frameScheduler.GetPacing();
+}
+
+int CGameManager::GetTargetFrameRate()
+{
+    return _frameScheduler.GetTargetFrameRate();
+}
+
+int CGameManager::GetMaxCatchUpSteps()
+{
+    return _frameScheduler.GetMaxCatchUpSteps();
+}
+
+int CGameManager::GetCatchUpPolicy()
+{
+    return _frameScheduler.GetCatchUpPolicy();
+}
+
+double CGameManager::GetInterpolationAlpha()
+{
+    return _frameScheduler.GetInterpolationAlpha();
+}
+
+int CGameManager::GetSkippedUpdateCount()
+{
+    return _frameScheduler.GetSkippedUpdateCount();
+}
+
+int CGameManager::GetLateFrameCount()
+{
+    return _frameScheduler.GetLateFrameCount();
+}
+
+CFrameScheduler &CGameManager::GetFrameScheduler()
+{
+    return _frameScheduler;
+}
+
+int CGameManager::GetTimerCount()
+{
+    return _timerQueue.GetCount();
+}
+
 bool CGameManager::IsQuit()
 {
     return _quit;
@@ -88,15 +160,230 @@ void CGameManager::SetQuit(bool value)
     _quit = value;
 }
 
-void CGameManager::Delay(int time)
+int CGameManager::Delay(lua_State *L)
 {
-    const auto starttime = GetTickCount();
+    int time = static_cast<int>(luaL_checknumber(L, 2));
+
+    // gameManager:Run 으로 만든 코루틴 안이면 양보하고 메인 루프가 시간이 되면 다시 깨운다.
+    if (_coroutineRefs.find(L) != _coroutineRefs.end() && lua_isyieldable(L))
+    {
+        _ScheduleResume(L, int64_t(time) * 1000000, true);
+        return lua_yield(L, 0);
+    }
+
+    _WaitDelay(time);
+    return 0;
+}
+
+void CGameManager::StopDelay()
+{
+    for (auto &timer : _timers)
+    {
+        if (timer.second.isDelay)
+        {
+            _timerQueue.Reschedule(timer.first, 0);
+        }
+    }
+
+    if (_blockingDelayCount > 0)
+    {
+        PostMessage(nullptr, WM_STOP_DELAY, 0, 0);
+    }
+}
+
+int CGameManager::Run(lua_State *L)
+{
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+    int argCount = lua_gettop(L) - 2;
+
+    lua_State *thread = lua_newthread(L);
+    _coroutineRefs[thread] = luaL_ref(L, LUA_REGISTRYINDEX);
+
+    for (int i = 2; i <= argCount + 2; ++i)
+    {
+        lua_pushvalue(L, i);
+    }
+    lua_xmove(L, thread, argCount + 1);
+
+    _ResumeCoroutine(thread, argCount);
+    return 0;
+}
+
+int CGameManager::Sleep(lua_State *L)
+{
+    int time = static_cast<int>(luaL_checknumber(L, 2));
+
+    if (_coroutineRefs.find(L) == _coroutineRefs.end() || !lua_isyieldable(L))
+    {
+        return luaL_error(L, "Sleep can only be called inside gameManager:Run");
+    }
+
+    _ScheduleResume(L, int64_t(time) * 1000000, false);
+    return lua_yield(L, 0);
+}
+
+int CGameManager::SetTimeout(lua_State *L)
+{
+    return _AddScriptTimer(L, false);
+}
+
+int CGameManager::SetInterval(lua_State *L)
+{
+    return _AddScriptTimer(L, true);
+}
+
+void CGameManager::ClearTimer(int id)
+{
+    auto iter = _timers.find(id);
+    if (iter == _timers.end() || iter->second.thread != nullptr)
+    {
+        return;
+    }
+
+    _timerQueue.Remove(id);
+    luaL_unref(CLuaTinker::GetLuaTinker().GetLuaState(), LUA_REGISTRYINDEX, iter->second.functionRef);
+    _timers.erase(iter);
+}
+
+int CGameManager::UpdateTimers()
+{
+    if (_timerQueue.IsEmpty())
+    {
+        return 0;
+    }
+
+    // 콜백 안에서 타이머를 더하거나 지울 수 있으므로 이번에 만료된 목록을 먼저 뽑아 둔다.
+    std::vector<int> expiredTimers;
+    _timerQueue.PopExpired(_frameScheduler.GetNow(), expiredTimers);
+
+    for (int id : expiredTimers)
+    {
+        auto iter = _timers.find(id);
+        if (iter == _timers.end())
+        {
+            continue;
+        }
+
+        ScriptTimer timer = iter->second;
+        bool isFinished = !_timerQueue.IsExist(id);
+        if (isFinished)
+        {
+            _timers.erase(iter);
+        }
+
+        if (timer.thread != nullptr)
+        {
+            _ResumeCoroutine(timer.thread, 0);
+        }
+        else
+        {
+            CLuaTinker::GetLuaTinker().Call(timer.functionRef);
+            if (isFinished)
+            {
+                luaL_unref(CLuaTinker::GetLuaTinker().GetLuaState(), LUA_REGISTRYINDEX, timer.functionRef);
+            }
+        }
+    }
+
+    return int(expiredTimers.size());
+}
+
+int CGameManager::UpdateYieldedCoroutines()
+{
+    if (_yieldedThreads.empty())
+    {
+        return 0;
+    }
+
+    // 깨운 코루틴이 다시 양보하면 다음 틱에 깨우도록 이번 목록만 돌린다.
+    std::vector<lua_State *> threads;
+    threads.swap(_yieldedThreads);
+
+    for (auto thread : threads)
+    {
+        _ResumeCoroutine(thread, 0);
+    }
+
+    return int(threads.size());
+}
+
+int64_t CGameManager::GetWaitTime()
+{
+    int64_t waitTime = _frameScheduler.GetWaitTime();
+    if (_timerQueue.IsEmpty())
+    {
+        return waitTime;
+    }
+
+    int64_t now = _frameScheduler.GetNow();
+    int64_t dueTime = _timerQueue.GetNextDueTime();
+    int64_t timerWaitTime = dueTime > now ? dueTime - now : 0;
+
+    return timerWaitTime < waitTime ? timerWaitTime : waitTime;
+}
+
+void CGameManager::SetUpdateEvent()
+{
+    auto l = CLuaTinker::GetLuaTinker().GetLuaState();
+    if (lua_isfunction(l, -1))
+    {
+        lua_pushvalue(l, -1);
+        _updateEvent = luaL_ref(l, LUA_REGISTRYINDEX);
+    }
+
+    lua_pop(l, 1);
+}
+
+void CGameManager::SetInputDispatch(std::function<void()> dispatch)
+{
+    _inputDispatch = std::move(dispatch);
+}
+
+void CGameManager::SetFramePacing(int pacing)
+{
+    if (pacing == FRAME_PACING_VSYNC)
+    {
+        // 주사율을 알 수 없으면 (0 또는 1) 60 으로 본다.
+        HDC hdc = GetDC(nullptr);
+        int refreshRate = GetDeviceCaps(hdc, VREFRESH);
+        ReleaseDC(nullptr, hdc);
+        _frameScheduler.SetRefreshRate(refreshRate > 1 ? refreshRate : 60);
+    }
+
+    _frameScheduler.SetPacing(pacing);
+}
+
+void CGameManager::SetTargetFrameRate(int frameRate)
+{
+    _frameScheduler.SetTargetFrameRate(frameRate);
+}
+
+void CGameManager::SetMaxCatchUpSteps(int steps)
+{
+    _frameScheduler.SetMaxCatchUpSteps(steps);
+}
+
+void CGameManager::SetCatchUpPolicy(int policy)
+{
+    _frameScheduler.SetCatchUpPolicy(policy);
+}
+
+void CGameManager::ResetFrameCounters()
+{
+    _frameScheduler.ResetCounters();
+}
+
+void CGameManager::_WaitDelay(int time)
+{
+    // 코루틴 밖에서 부르면 예전처럼 메시지를 처리하며 기다리되, 메시지가 없을 때는 잠든다.
+    const auto startTime = GetTickCount();
     MSG message;
     auto quit = false;
 
+    ++_blockingDelayCount;
     for (;;)
     {
-        int gap = (GetTickCount() - starttime);
+        DWORD gap = GetTickCount() - startTime;
         if (gap >= static_cast<DWORD>(time))
         {
             break;
@@ -116,7 +403,21 @@ void CGameManager::Delay(int time)
             TranslateMessage(&message);
             DispatchMessage(&message);
         }
+        else
+        {
+            // 메인 루프가 멈춰 있으므로 쌓인 메시지를 다 처리한 뒤에 입력을 보낸다.
+            if (_inputDispatch)
+            {
+                _inputDispatch();
+            }
+
+            if (CJobSystem::GetInstance().RunMainThreadJobs() == 0)
+            {
+                MsgWaitForMultipleObjects(0, nullptr, FALSE, static_cast<DWORD>(time) - gap, QS_ALLINPUT);
+            }
+        }
     }
+    --_blockingDelayCount;
 
     if (quit)
     {
@@ -124,21 +425,72 @@ void CGameManager::Delay(int time)
     }
 }
 
-void CGameManager::StopDelay()
+int CGameManager::_AddScriptTimer(lua_State *L, bool isInterval)
 {
-    PostMessage(nullptr, WM_STOP_DELAY, 0, 0);
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+    int64_t time = int64_t(luaL_checknumber(L, 3) * 1000000);
+
+    // 주기가 0 이면 한 틱에 끝없이 불리므로 최소 1ms 로 맞춘다.
+    if (isInterval && time < 1000000)
+    {
+        time = 1000000;
+    }
+
+    lua_pushvalue(L, 2);
+    int functionRef = luaL_ref(L, LUA_REGISTRYINDEX);
+
+    int id = _timerQueue.Add(_frameScheduler.GetNow() + time, isInterval ? time : 0);
+    _timers[id] = ScriptTimer{functionRef, nullptr, false};
+
+    lua_pushinteger(L, id);
+    return 1;
 }
 
-void CGameManager::SetUpdateEvent()
+void CGameManager::_ScheduleResume(lua_State *thread, int64_t delay, bool isDelay)
 {
-    auto l = CLuaTinker::GetLuaTinker().GetLuaState();
-    if (lua_isfunction(l, -1))
+    int id = _timerQueue.Add(_frameScheduler.GetNow() + delay);
+    _timers[id] = ScriptTimer{LUA_NOREF, thread, isDelay};
+    _isYieldScheduled = true;
+}
+
+void CGameManager::_ResumeCoroutine(lua_State *thread, int argCount)
+{
+    // Run 안에서 또 Run 을 부를 수 있으므로 양보 표시는 재개할 때마다 따로 둔다.
+    bool wasYieldScheduled = _isYieldScheduled;
+    _isYieldScheduled = false;
+
+    int result;
     {
-        lua_pushvalue(l, -1);
-        _updateEvent = luaL_ref(l, LUA_REGISTRYINDEX);
+        PROFILE_ZONE("Lua Coroutine");
+        CLuaStateScope stateScope(thread);
+        result = lua_resume(thread, nullptr, argCount);
     }
 
-    lua_pop(l, 1);
+    bool isYieldScheduled = _isYieldScheduled;
+    _isYieldScheduled = wasYieldScheduled;
+
+    if (result == LUA_YIELD)
+    {
+        // Delay 나 Sleep 이 아닌 coroutine.yield 로 양보했으면 다음 고정 업데이트 틱에 다시 깨운다.
+        if (!isYieldScheduled)
+        {
+            _yieldedThreads.push_back(thread);
+        }
+        return;
+    }
+
+    if (result != LUA_OK)
+    {
+        lua_tinker::print_error(thread, "%s", lua_tostring(thread, -1));
+    }
+
+    auto iter = _coroutineRefs.find(thread);
+    if (iter != _coroutineRefs.end())
+    {
+        lua_settop(thread, 0);
+        luaL_unref(CLuaTinker::GetLuaTinker().GetLuaState(), LUA_REGISTRYINDEX, iter->second);
+        _coroutineRefs.erase(iter);
+    }
 }
 
 CME5File *CGameManager::OpenFile(std::wstring path)
@@ -2,16 +2,29 @@
 
 #define WM_STOP_DELAY (WM_USER + 1)
 
+#include "BaseLib\FrameScheduler.h"
+#include "BaseLib\TimerQueue.h"
 #include "LuaLib\LuaTinker.h"
 
 #include <windows.h>
+#include <functional>
+#include <map>
 #include <mutex>
 #include <memory>
+#include <vector>
 
 namespace jojogame
 {
 class CME5File;
 
+// 루아 함수를 부르거나(functionRef) 기다리던 코루틴을 깨우는(thread) 타이머
+struct ScriptTimer
+{
+    int functionRef;
+    lua_State *thread;
+    bool isDelay;
+};
+
 class CGameManager
 {
 public:
@@ -24,6 +37,15 @@ public:
     int GetDesktopHeight();
     int GetUpdateEvent();
     int GetNow();
+    int GetTimerCount();
+    int GetFramePacing();
+    int GetTargetFrameRate();
+    int GetMaxCatchUpSteps();
+    int GetCatchUpPolicy();
+    double GetInterpolationAlpha();
+    int GetSkippedUpdateCount();
+    int GetLateFrameCount();
+    CFrameScheduler &GetFrameScheduler();
 
     bool IsQuit();
 
@@ -32,10 +54,25 @@ public:
     void Quit();
     void SetQuit(bool value);
 
-    void Delay(int time);
+    int Delay(lua_State *L);
     void StopDelay();
+    int Run(lua_State *L);
+    int Sleep(lua_State *L);
+
+    int SetTimeout(lua_State *L);
+    int SetInterval(lua_State *L);
+    void ClearTimer(int id);
+    int UpdateTimers();
+    int UpdateYieldedCoroutines();
+    int64_t GetWaitTime();
 
     void SetUpdateEvent();
+    void SetInputDispatch(std::function<void()> dispatch);
+    void SetFramePacing(int pacing);
+    void SetTargetFrameRate(int frameRate);
+    void SetMaxCatchUpSteps(int steps);
+    void SetCatchUpPolicy(int policy);
+    void ResetFrameCounters();
 
     CME5File *OpenFile(std::wstring path);
     void CloseFile(CME5File *file);
@@ -43,10 +80,24 @@ public:
     static CGameManager &GetInstance();
 
 private:
+    void _WaitDelay(int time);
+    int _AddScriptTimer(lua_State *L, bool isInterval);
+    void _ScheduleResume(lua_State *thread, int64_t delay, bool isDelay);
+    void _ResumeCoroutine(lua_State *thread, int argCount);
+
     static std::once_flag s_onceFlag;
     static std::unique_ptr<CGameManager> s_sharedGameManager;
 
     int _updateEvent = LUA_NOREF;
+    std::function<void()> _inputDispatch;
+    CFrameScheduler _frameScheduler;
+
+    std::map<lua_State *, int> _coroutineRefs;
+    CTimerQueue _timerQueue;
+    std::map<int, ScriptTimer> _timers;
+    std::vector<lua_State *> _yieldedThreads;
+    bool _isYieldScheduled = false;
+    int _blockingDelayCount = 0;
 
     bool _quit = false;
 };
@@ -0,0 +1,141 @@
+#include "ProfileManager.h"
+
+namespace jojogame
+{
+std::once_flag CProfileManager::s_onceFlag;
+std::unique_ptr<CProfileManager> CProfileManager::s_sharedProfileManager;
+
+void CProfileManager::RegisterFunctions(lua_State *L)
+{
+    LUA_BEGIN(CProfileManager, "_ProfileManager");
+
+    LUA_METHOD(IsRecording);
+    LUA_METHOD(IsTracing);
+    LUA_METHOD(GetZoneCount);
+    LUA_METHOD(GetZoneName);
+    LUA_METHOD(GetSampleCount);
+    LUA_METHOD(GetMin);
+    LUA_METHOD(GetAverage);
+    LUA_METHOD(GetP99);
+    LUA_METHOD(GetMax);
+    LUA_METHOD(GetCounter);
+    LUA_METHOD(GetDroppedCount);
+
+    LUA_METHOD(SetRecording);
+
+    LUA_METHOD(Reset);
+    LUA_METHOD(SaveCsv);
+
+    LUA_METHOD(StartTrace);
+    LUA_METHOD(StopTrace);
+    LUA_METHOD(FlushTrace);
+}
+
+CProfileManager::CProfileManager()
+{
+}
+
+CProfileManager::~CProfileManager()
+{
+}
+
+bool CProfileManager::IsRecording()
+{
+    return CProfiler::IsRecording();
+}
+
+bool CProfileManager::IsTracing()
+{
+    return CTraceRecorder::IsRecording();
+}
+
+int CProfileManager::GetZoneCount()
+{
+    return CProfiler::GetInstance().GetZoneCount();
+}
+
+std::string CProfileManager::GetZoneName(int index)
+{
+    return CProfiler::GetInstance().GetZoneName(index - 1);
+}
+
+int CProfileManager::GetSampleCount(std::string zone)
+{
+    auto &profiler = CProfiler::GetInstance();
+    return profiler.GetSampleCount(profiler.FindZone(zone));
+}
+
+double CProfileManager::GetMin(std::string zone)
+{
+    auto &profiler = CProfiler::GetInstance();
+    return profiler.GetMin(profiler.FindZone(zone));
+}
+
+double CProfileManager::GetAverage(std::string zone)
+{
+    auto &profiler = CProfiler::GetInstance();
+    return profiler.GetAverage(profiler.FindZone(zone));
+}
+
+double CProfileManager::GetP99(std::string zone)
+{
+    auto &profiler = CProfiler::GetInstance();
+    return profiler.GetPercentile(profiler.FindZone(zone), 99.0);
+}
+
+double CProfileManager::GetMax(std::string zone)
+{
+    auto &profiler = CProfiler::GetInstance();
+    return profiler.GetMax(profiler.FindZone(zone));
+}
+
+int CProfileManager::GetCounter(std::string name)
+{
+    return static_cast<int>(CProfiler::GetInstance().GetCounter(name));
+}
+
+int CProfileManager::GetDroppedCount()
+{
+    return CProfiler::GetInstance().GetDroppedCount();
+}
+
+void CProfileManager::SetRecording(bool value)
+{
+    CProfiler::GetInstance().SetRecording(value);
+}
+
+void CProfileManager::Reset()
+{
+    CProfiler::GetInstance().Reset();
+}
+
+bool CProfileManager::SaveCsv(std::string path)
+{
+    return CProfiler::GetInstance().SaveCsv(path);
+}
+
+bool CProfileManager::StartTrace(std::string path)
+{
+    return CTraceRecorder::GetInstance().Start(path);
+}
+
+void CProfileManager::StopTrace()
+{
+    CTraceRecorder::GetInstance().Stop();
+}
+
+void CProfileManager::FlushTrace()
+{
+    CTraceRecorder::GetInstance().Flush();
+}
+
+CProfileManager &CProfileManager::GetInstance()
+{
+    std::call_once(s_onceFlag,
+                   [] {
+                       s_sharedProfileManager = std::make_unique<jojogame::CProfileManager>();
+                   });
+
+    return *s_sharedProfileManager;
+}
+} // namespace jojogame
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "BaseLib/Profiler.h"
+#include "BaseLib/TraceRecorder.h"
+#include "LuaLib/LuaTinker.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace jojogame
+{
+// CProfiler 의 결과를 루아에서 구역 이름으로 조회한다. 시간은 밀리초 단위이다.
+class CProfileManager
+{
+public:
+    static void RegisterFunctions(lua_State *L);
+
+    CProfileManager();
+    virtual ~CProfileManager();
+
+    bool IsRecording();
+    bool IsTracing();
+    int GetZoneCount();
+    std::string GetZoneName(int index);
+    int GetSampleCount(std::string zone);
+    double GetMin(std::string zone);
+    double GetAverage(std::string zone);
+    double GetP99(std::string zone);
+    double GetMax(std::string zone);
+    int GetCounter(std::string name);
+    int GetDroppedCount();
+
+    void SetRecording(bool value);
+
+    void Reset();
+    bool SaveCsv(std::string path);
+
+    bool StartTrace(std::string path);
+    void StopTrace();
+    void FlushTrace();
+
+    static CProfileManager &GetInstance();
+
+private:
+    static std::once_flag s_onceFlag;
+    static std::unique_ptr<CProfileManager> s_sharedProfileManager;
+};
+} // namespace jojogame
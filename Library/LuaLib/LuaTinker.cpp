@@ -99,6 +99,12 @@ CLuaTinker::~CLuaTinker()
 }
 
 lua_State *CLuaTinker::GetLuaState()
+{
+    // 이벤트 설정 함수들은 인자를 이 상태의 스택에서 읽으므로 실행 중인 코루틴을 돌려줘야 한다.
+    return _currentState != nullptr ? _currentState : _luaState;
+}
+
+lua_State *CLuaTinker::GetMainLuaState()
 {
     return _luaState;
 }
@@ -108,6 +114,18 @@ void CLuaTinker::Run(const char *fileName)
     lua_tinker::dofile(_luaState, fileName);
 }
 
+CLuaStateScope::CLuaStateScope(lua_State *L)
+{
+    auto &luaTinker = CLuaTinker::GetLuaTinker();
+    _previousState = luaTinker._currentState;
+    luaTinker._currentState = L;
+}
+
+CLuaStateScope::~CLuaStateScope()
+{
+    CLuaTinker::GetLuaTinker()._currentState = _previousState;
+}
+
 CLuaTinker &CLuaTinker::GetLuaTinker()
 {
     std::call_once(s_onceFlag,
@@ -12,6 +12,7 @@
 #define LUA_METHOD(func) \
     lua_tinker::class_def<current_class>(L, #func, &current_class::func);
 
+#include "BaseLib/Profiler.h"
 #include "lua_tinker.h"
 
 #include <memory>
@@ -19,6 +20,20 @@
 
 namespace jojogame
 {
+// 범위 안에서 GetLuaState 가 주어진 상태(코루틴)를 돌려주게 한다.
+class CLuaStateScope
+{
+public:
+    explicit CLuaStateScope(lua_State *L);
+    ~CLuaStateScope();
+
+    CLuaStateScope(const CLuaStateScope &src) = delete;
+    CLuaStateScope &operator=(const CLuaStateScope &rhs) = delete;
+
+private:
+    lua_State *_previousState;
+};
+
 class CLuaTinker
 {
 public:
@@ -29,6 +44,7 @@ public:
     CLuaTinker &operator=(const CLuaTinker &rhs) = delete;
 
     lua_State *GetLuaState();
+    lua_State *GetMainLuaState();
     void Run(const char *fileName);
 
     static CLuaTinker &GetLuaTinker();
@@ -54,113 +70,152 @@ public:
 
     void Call(int functionRef)
     {
+        PROFILE_ZONE("Lua Call");
+        CLuaStateScope stateScope(_luaState);
         lua_tinker::call<void>(_luaState, functionRef);
     }
 
     template <typename T1>
     void Call(int functionRef, T1 arg1)
     {
+        PROFILE_ZONE("Lua Call");
+        CLuaStateScope stateScope(_luaState);
         return lua_tinker::call<void>(_luaState, functionRef, arg1);
     }
 
     template <typename T1, typename T2>
     void Call(int functionRef, T1 arg1, T2 arg2)
     {
+        PROFILE_ZONE("Lua Call");
+        CLuaStateScope stateScope(_luaState);
         return lua_tinker::call<void>(_luaState, functionRef, arg1, arg2);
     }
 
     template <typename T1, typename T2, typename T3>
     void Call(int functionRef, T1 arg1, T2 arg2, T3 arg3)
     {
+        PROFILE_ZONE("Lua Call");
+        CLuaStateScope stateScope(_luaState);
         return lua_tinker::call<void>(_luaState, functionRef, arg1, arg2, arg3);
     }
 
     template <typename T1, typename T2, typename T3, typename T4>
     void Call(int functionRef, T1 arg1, T2 arg2, T3 arg3, T4 arg4)
     {
+        PROFILE_ZONE("Lua Call");
+        CLuaStateScope stateScope(_luaState);
         return lua_tinker::call<void>(_luaState, functionRef, arg1, arg2, arg3, arg4);
     }
 
     template <typename T1, typename T2, typename T3, typename T4, typename T5>
     void Call(int functionRef, T1 arg1, T2 arg2, T3 arg3, T4 arg4, T5 arg5)
     {
+        PROFILE_ZONE("Lua Call");
+        CLuaStateScope stateScope(_luaState);
         return lua_tinker::call<void>(_luaState, functionRef, arg1, arg2, arg3, arg4, arg5);
     }
 
     template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6>
     void Call(int functionRef, T1 arg1, T2 arg2, T3 arg3, T4 arg4, T5 arg5, T6 arg6)
     {
+        PROFILE_ZONE("Lua Call");
+        CLuaStateScope stateScope(_luaState);
         return lua_tinker::call<void>(_luaState, functionRef, arg1, arg2, arg3, arg4, arg5, arg6);
     }
 
     template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
     void Call(int functionRef, T1 arg1, T2 arg2, T3 arg3, T4 arg4, T5 arg5, T6 arg6, T7 arg7)
     {
+        PROFILE_ZONE("Lua Call");
+        CLuaStateScope stateScope(_luaState);
         return lua_tinker::call<void>(_luaState, functionRef, arg1, arg2, arg3, arg4, arg5, arg6, arg7);
     }
 
     template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8>
     void Call(int functionRef, T1 arg1, T2 arg2, T3 arg3, T4 arg4, T5 arg5, T6 arg6, T7 arg7, T8 arg8)
     {
+        PROFILE_ZONE("Lua Call");
+        CLuaStateScope stateScope(_luaState);
         return lua_tinker::call<void>(_luaState, functionRef, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8);
     }
 
     template <typename RVal>
     RVal Call(int functionRef)
     {
+        PROFILE_ZONE("Lua Call");
+        CLuaStateScope stateScope(_luaState);
         return lua_tinker::call<RVal>(_luaState, functionRef);
     }
 
     template <typename RVal, typename T1>
     RVal Call(int functionRef, T1 arg1)
     {
+        PROFILE_ZONE("Lua Call");
+        CLuaStateScope stateScope(_luaState);
         return lua_tinker::call<RVal>(_luaState, functionRef, arg1);
     }
 
     template <typename RVal, typename T1, typename T2>
     RVal Call(int functionRef, T1 arg1, T2 arg2)
     {
+        PROFILE_ZONE("Lua Call");
+        CLuaStateScope stateScope(_luaState);
         return lua_tinker::call<RVal>(_luaState, functionRef, arg1, arg2);
     }
 
     template <typename RVal, typename T1, typename T2, typename T3>
     RVal Call(int functionRef, T1 arg1, T2 arg2, T3 arg3)
     {
+        PROFILE_ZONE("Lua Call");
+        CLuaStateScope stateScope(_luaState);
         return lua_tinker::call<RVal>(_luaState, functionRef, arg1, arg2, arg3);
     }
 
     template <typename RVal, typename T1, typename T2, typename T3, typename T4>
     RVal Call(int functionRef, T1 arg1, T2 arg2, T3 arg3, T4 arg4)
     {
+        PROFILE_ZONE("Lua Call");
+        CLuaStateScope stateScope(_luaState);
         return lua_tinker::call<RVal>(_luaState, functionRef, arg1, arg2, arg3, arg4);
     }
 
     template <typename RVal, typename T1, typename T2, typename T3, typename T4, typename T5>
     RVal Call(int functionRef, T1 arg1, T2 arg2, T3 arg3, T4 arg4, T5 arg5)
     {
+        PROFILE_ZONE("Lua Call");
+        CLuaStateScope stateScope(_luaState);
         return lua_tinker::call<RVal>(_luaState, functionRef, arg1, arg2, arg3, arg4, arg5);
     }
 
     template <typename RVal, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6>
     RVal Call(int functionRef, T1 arg1, T2 arg2, T3 arg3, T4 arg4, T5 arg5, T6 arg6)
     {
+        PROFILE_ZONE("Lua Call");
+        CLuaStateScope stateScope(_luaState);
         return lua_tinker::call<RVal>(_luaState, functionRef, arg1, arg2, arg3, arg4, arg5, arg6);
     }
 
     template <typename RVal, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
     RVal Call(int functionRef, T1 arg1, T2 arg2, T3 arg3, T4 arg4, T5 arg5, T6 arg6, T7 arg7)
     {
+        PROFILE_ZONE("Lua Call");
+        CLuaStateScope stateScope(_luaState);
         return lua_tinker::call<RVal>(_luaState, functionRef, arg1, arg2, arg3, arg4, arg5, arg6, arg7);
     }
 
     template <typename RVal, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8>
     RVal Call(int functionRef, T1 arg1, T2 arg2, T3 arg3, T4 arg4, T5 arg5, T6 arg6, T7 arg7, T8 arg8)
     {
+        PROFILE_ZONE("Lua Call");
+        CLuaStateScope stateScope(_luaState);
         return lua_tinker::call<RVal>(_luaState, functionRef, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8);
     }
 
 protected:
     lua_State *_luaState = nullptr;
+    lua_State *_currentState = nullptr;
+
+    friend class CLuaStateScope;
 
     static std::once_flag s_onceFlag;
     static std::unique_ptr<CLuaTinker> s_luaTinker;
@@ -0,0 +1,128 @@
+#include "AnimationManager.h"
+
+#include "SpriteAnimation.h"
+#include "Tween.h"
+#include "WindowTransition.h"
+
+#include <algorithm>
+
+namespace jojogame
+{
+std::once_flag CAnimationManager::s_onceFlag;
+std::unique_ptr<CAnimationManager> CAnimationManager::s_sharedAnimationManager;
+
+CAnimationManager::CAnimationManager()
+{
+}
+
+CAnimationManager::~CAnimationManager()
+{
+}
+
+CAnimationManager &CAnimationManager::GetInstance()
+{
+    std::call_once(s_onceFlag,
+                   [] {
+                       s_sharedAnimationManager = std::make_unique<jojogame::CAnimationManager>();
+                   });
+
+    return *s_sharedAnimationManager;
+}
+
+void CAnimationManager::AddAnimation(CSpriteAnimation *animation)
+{
+    if (std::find(_animations.begin(), _animations.end(), animation) == _animations.end())
+    {
+        _animations.push_back(animation);
+    }
+}
+
+void CAnimationManager::RemoveAnimation(CSpriteAnimation *animation)
+{
+    auto iter = std::find(_animations.begin(), _animations.end(), animation);
+    if (iter != _animations.end())
+    {
+        *iter = nullptr;
+    }
+}
+
+void CAnimationManager::AddTween(CTween *tween)
+{
+    if (std::find(_tweens.begin(), _tweens.end(), tween) == _tweens.end())
+    {
+        _tweens.push_back(tween);
+    }
+}
+
+void CAnimationManager::RemoveTween(CTween *tween)
+{
+    auto iter = std::find(_tweens.begin(), _tweens.end(), tween);
+    if (iter != _tweens.end())
+    {
+        *iter = nullptr;
+    }
+}
+
+void CAnimationManager::AddTransition(CWindowTransition *transition)
+{
+    if (std::find(_transitions.begin(), _transitions.end(), transition) == _transitions.end())
+    {
+        _transitions.push_back(transition);
+    }
+}
+
+void CAnimationManager::RemoveTransition(CWindowTransition *transition)
+{
+    auto iter = std::find(_transitions.begin(), _transitions.end(), transition);
+    if (iter != _transitions.end())
+    {
+        *iter = nullptr;
+    }
+}
+
+void CAnimationManager::Update(int elapsed)
+{
+    // 끝 이벤트에서 다른 애니메이션을 재생할 수 있으므로 인덱스로 돈다.
+    for (size_t i = 0; i < _animations.size(); ++i)
+    {
+        if (_animations[i] != nullptr)
+        {
+            _animations[i]->Update(elapsed);
+        }
+    }
+
+    _animations.erase(std::remove_if(_animations.begin(), _animations.end(),
+                                     [](CSpriteAnimation *animation) {
+                                         return animation == nullptr || !animation->IsPlaying();
+                                     }),
+                      _animations.end());
+
+    for (size_t i = 0; i < _tweens.size(); ++i)
+    {
+        if (_tweens[i] != nullptr)
+        {
+            _tweens[i]->Update(elapsed);
+        }
+    }
+
+    _tweens.erase(std::remove_if(_tweens.begin(), _tweens.end(),
+                                 [](CTween *tween) {
+                                     return tween == nullptr || !tween->IsPlaying();
+                                 }),
+                  _tweens.end());
+
+    for (size_t i = 0; i < _transitions.size(); ++i)
+    {
+        if (_transitions[i] != nullptr)
+        {
+            _transitions[i]->Update(elapsed);
+        }
+    }
+
+    _transitions.erase(std::remove_if(_transitions.begin(), _transitions.end(),
+                                      [](CWindowTransition *transition) {
+                                          return transition == nullptr || !transition->IsPlaying();
+                                      }),
+                       _transitions.end());
+}
+} // namespace jojogame
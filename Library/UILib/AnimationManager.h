@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace jojogame
+{
+class CSpriteAnimation;
+class CTween;
+class CWindowTransition;
+
+class CAnimationManager
+{
+public:
+    CAnimationManager();
+    virtual ~CAnimationManager();
+
+    void AddAnimation(CSpriteAnimation *animation);
+    void RemoveAnimation(CSpriteAnimation *animation);
+    void AddTween(CTween *tween);
+    void RemoveTween(CTween *tween);
+    void AddTransition(CWindowTransition *transition);
+    void RemoveTransition(CWindowTransition *transition);
+
+    void Update(int elapsed);
+
+    static CAnimationManager &GetInstance();
+
+private:
+    std::vector<CSpriteAnimation *> _animations;
+    std::vector<CTween *> _tweens;
+    std::vector<CWindowTransition *> _transitions;
+
+    static std::once_flag s_onceFlag;
+    static std::unique_ptr<CAnimationManager> s_sharedAnimationManager;
+};
+} // namespace jojogame
@@ -5,12 +5,23 @@
 #include "CommonLib/ME5File.h"
 #include "CommonLib/GameManager.h"
 #include "BaseLib/MemoryPool.h"
+#include "BaseLib/TraceRecorder.h"
 
 namespace jojogame
 {
+std::mutex CAudioPlayerControl::s_queueFillMutex;
+std::vector<const std::atomic<int> *> CAudioPlayerControl::s_queueFills;
+
+// 성능 표시에서 읽을 수 있도록 큐가 얼마나 찼는지 백분율로 남긴다.
+static void UpdateQueueFill(AudioPacketQueue *queue)
+{
+    queue->fill.store(int(int64_t(queue->size) * 100 / MAX_AUDIOQ_SIZE), std::memory_order_relaxed);
+}
+
 void InitPacketAudioQueue(AudioPacketQueue *queue)
 {
     queue->size = 0;
+    queue->fill.store(0, std::memory_order_relaxed);
     queue->firstPacket = nullptr;
     queue->lastPacket = nullptr;
 }
@@ -38,7 +49,9 @@ static int GetPacketAudioQueue(AudioState *audioState, AudioPacketQueue *queue,
                 queue->lastPacket = nullptr;
             }
             queue->size -= packetList->pkt.size;
+            UpdateQueueFill(queue);
             *packet = packetList->pkt;
+            TRACE_FLOW_END("Audio Packet", reinterpret_cast<intptr_t>(packetList));
             av_free(packetList);
             result = 1;
             break;
@@ -54,6 +67,8 @@ static int GetPacketAudioQueue(AudioState *audioState, AudioPacketQueue *queue,
             result = -1;
             break;
         }
+
+        TRACE_SCOPE("Wait Audio Packet");
         queue->cond.wait(lock);
     }
     lock.unlock();
@@ -87,6 +102,9 @@ int PutPacketAudioQueue(AudioPacketQueue *queue, AVPacket *packet)
     }
     queue->lastPacket = packetList;
     queue->size += packetList->pkt.size;
+    UpdateQueueFill(queue);
+    TRACE_FLOW_START("Audio Packet", reinterpret_cast<intptr_t>(packetList));
+    TRACE_COUNTER("Audio Queue", queue->size);
     queue->cond.notify_one();
     lock.unlock();
 
@@ -296,6 +314,9 @@ int DecodeMusicFrame(AudioState *audioState, uint8_t *audioBuffer, int bufferSiz
 
 void MusicAudioCallback(void *userdata, Uint8 *stream, int len)
 {
+    TRACE_THREAD_NAME("SDL Audio");
+    TRACE_SCOPE("Audio Callback");
+
     auto audioState = (AudioState *)userdata;
 
     while (len > 0)
@@ -363,6 +384,39 @@ int CAudioPlayerControl::Read(void *opaque, unsigned char *buf, int buf_size)
     return stream->readsome(reinterpret_cast<char *>(buf), buf_size);
 }
 
+void CAudioPlayerControl::AddQueueFill(const std::atomic<int> *fill)
+{
+    std::lock_guard<std::mutex> lock(s_queueFillMutex);
+    s_queueFills.push_back(fill);
+}
+
+void CAudioPlayerControl::RemoveQueueFill(const std::atomic<int> *fill)
+{
+    std::lock_guard<std::mutex> lock(s_queueFillMutex);
+    for (auto iter = s_queueFills.begin(); iter != s_queueFills.end(); ++iter)
+    {
+        if (*iter == fill)
+        {
+            s_queueFills.erase(iter);
+            break;
+        }
+    }
+}
+
+int CAudioPlayerControl::GetQueueFill()
+{
+    // 여러 곡이나 동영상이 함께 재생될 수 있으므로 가장 많이 찬 큐를 보여 준다.
+    std::lock_guard<std::mutex> lock(s_queueFillMutex);
+    int maxFill = 0;
+    for (auto fill : s_queueFills)
+    {
+        int value = fill->load(std::memory_order_relaxed);
+        maxFill = value > maxFill ? value : maxFill;
+    }
+
+    return maxFill;
+}
+
 int64_t CAudioPlayerControl::Seek(void *opaque, int64_t offset, int whence)
 {
     CMemoryStream *stream = static_cast<CMemoryStream *>(opaque);
@@ -598,7 +652,13 @@ bool PlaySound(AudioState *audioState)
             continue;
         }
 
-        if (av_read_frame(audioState->formatContext, &packet) < 0)
+        int readResult;
+        {
+            TRACE_SCOPE("Audio Read Packet");
+            readResult = av_read_frame(audioState->formatContext, &packet);
+        }
+
+        if (readResult < 0)
         {
             if (audioState->formatContext->pb->error == 0)
             {
@@ -655,6 +715,9 @@ void CAudioPlayerControl::Play(int playCount)
 
         _stop = false;
         _audioThread = new std::thread([&]() {
+            TRACE_THREAD_NAME("Audio");
+            AddQueueFill(&_state.audioQueue.fill);
+
             if (_playCount == 0)
             {
                 while (!CGameManager::GetInstance().IsQuit() && !_stop)
@@ -677,6 +740,7 @@ void CAudioPlayerControl::Play(int playCount)
                 }
             }
 
+            RemoveQueueFill(&_state.audioQueue.fill);
             _state.playing = false;
             _stop = true;
         });
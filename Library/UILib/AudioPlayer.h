@@ -33,10 +33,12 @@ extern "C"
 
 #include <string>
 #include <sstream>
+#include <atomic>
 #include <mutex>
 #include <chrono>
 #include <thread>
 #include <queue>
+#include <vector>
 
 namespace jojogame
 {
@@ -44,6 +46,7 @@ struct AudioPacketQueue
 {
     AVPacketList *firstPacket, *lastPacket;
     int size;
+    std::atomic<int> fill{0};
     std::mutex mutex;
     std::condition_variable cond;
 };
@@ -92,7 +95,14 @@ public:
     static int Read(void *opaque, unsigned char *buf, int buf_size);
     static int64_t Seek(void *opaque, int64_t offset, int whence);
 
+    static void AddQueueFill(const std::atomic<int> *fill);
+    static void RemoveQueueFill(const std::atomic<int> *fill);
+    static int GetQueueFill();
+
 private:
+    static std::mutex s_queueFillMutex;
+    static std::vector<const std::atomic<int> *> s_queueFills;
+
     mutable AudioState _state{};
     CMemoryStream *_inputStream = nullptr;
     std::thread *_audioThread = nullptr;
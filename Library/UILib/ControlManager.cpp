@@ -13,6 +13,7 @@
 #include "ToolbarControl.h"
 #include "LayoutControl.h"
 #include "ListviewControl.h"
+#include "ListViewTable.h"
 #include "StaticControl.h"
 #include "GroupBoxControl.h"
 #include "CheckBoxControl.h"
@@ -20,6 +21,14 @@
 #include "ComboBoxControl.h"
 #include "AudioPlayer.h"
 #include "GraphicText.h"
+#include "ScaledImageCache.h"
+#include "SpriteAnimation.h"
+#include "FontCache.h"
+#include "Tween.h"
+#include "TileRenderer.h"
+#include "WindowTransition.h"
+#include "InputManager.h"
+#include "PerformanceHud.h"
 
 namespace jojogame
 {
@@ -43,6 +52,7 @@ void CControlManager::RegisterFunctions(lua_State *L)
     LUA_METHOD(CreateListViewColumn);
     LUA_METHOD(CreateListViewRow);
     LUA_METHOD(CreateListViewItem);
+    LUA_METHOD(CreateListViewTable);
     LUA_METHOD(CreateStatic);
     LUA_METHOD(CreateGroupBox);
     LUA_METHOD(CreateCheckBox);
@@ -50,6 +60,11 @@ void CControlManager::RegisterFunctions(lua_State *L)
     LUA_METHOD(CreateComboBox);
     LUA_METHOD(CreateAudioPlayer);
     LUA_METHOD(CreateGraphicText);
+    LUA_METHOD(CreateSpriteAnimation);
+    LUA_METHOD(CreateTween);
+    LUA_METHOD(CreateTweenSequence);
+    LUA_METHOD(CreateTweenParallel);
+    LUA_METHOD(CreateTransition);
 }
 
 CControlManager::CControlManager()
@@ -81,6 +96,7 @@ void CControlManager::Init(HINSTANCE hInstance)
     CLuaTinker::GetLuaTinker().RegisterClassToLua<CListViewColumn>();
     CLuaTinker::GetLuaTinker().RegisterClassToLua<CListViewRow>();
     CLuaTinker::GetLuaTinker().RegisterClassToLua<CListViewItem>();
+    CLuaTinker::GetLuaTinker().RegisterClassToLua<CListViewTable>();
     CLuaTinker::GetLuaTinker().RegisterClassToLua<CStaticControl>();
     CLuaTinker::GetLuaTinker().RegisterClassToLua<CGroupBoxControl>();
     CLuaTinker::GetLuaTinker().RegisterClassToLua<CCheckBoxControl>();
@@ -88,6 +104,14 @@ void CControlManager::Init(HINSTANCE hInstance)
     CLuaTinker::GetLuaTinker().RegisterClassToLua<CComboBoxControl>();
     CLuaTinker::GetLuaTinker().RegisterClassToLua<CAudioPlayerControl>();
     CLuaTinker::GetLuaTinker().RegisterClassToLua<CGraphicText>();
+    CLuaTinker::GetLuaTinker().RegisterClassToLua<CScaledImageCache>();
+    CLuaTinker::GetLuaTinker().RegisterClassToLua<CFontCache>();
+    CLuaTinker::GetLuaTinker().RegisterClassToLua<CTileRenderer>();
+    CLuaTinker::GetLuaTinker().RegisterClassToLua<CSpriteAnimation>();
+    CLuaTinker::GetLuaTinker().RegisterClassToLua<CTween>();
+    CLuaTinker::GetLuaTinker().RegisterClassToLua<CWindowTransition>();
+    CLuaTinker::GetLuaTinker().RegisterClassToLua<CInputManager>();
+    CLuaTinker::GetLuaTinker().RegisterClassToLua<CPerformanceHud>();
 }
 
 CWindowControl *CControlManager::CreateWindowForm(CWindowControl *parent)
@@ -109,6 +133,31 @@ CGraphicText *CControlManager::CreateGraphicText()
     return control;
 }
 
+CSpriteAnimation *CControlManager::CreateSpriteAnimation()
+{
+    return CMemoryPool<CSpriteAnimation>::GetInstance().New();
+}
+
+CTween *CControlManager::CreateTween()
+{
+    return CMemoryPool<CTween>::GetInstance().New(static_cast<int>(TWEEN_SINGLE));
+}
+
+CTween *CControlManager::CreateTweenSequence()
+{
+    return CMemoryPool<CTween>::GetInstance().New(static_cast<int>(TWEEN_SEQUENCE));
+}
+
+CTween *CControlManager::CreateTweenParallel()
+{
+    return CMemoryPool<CTween>::GetInstance().New(static_cast<int>(TWEEN_PARALLEL));
+}
+
+CWindowTransition *CControlManager::CreateTransition(CWindowControl *window)
+{
+    return CMemoryPool<CWindowTransition>::GetInstance().New(window);
+}
+
 CMoviePlayerControl *CControlManager::CreateMoviePlayer(CWindowControl *parent, std::wstring fileName)
 {
     auto control = CMemoryPool<CMoviePlayerControl>::GetInstance().New(parent, fileName);
@@ -180,6 +229,11 @@ CListViewItem *CControlManager::CreateListViewItem()
     return control;
 }
 
+CListViewTable *CControlManager::CreateListViewTable()
+{
+    return CMemoryPool<CListViewTable>::GetInstance().New();
+}
+
 CStaticControl *CControlManager::CreateStatic(CWindowControl *parent)
 {
     auto control = CMemoryPool<CStaticControl>::GetInstance().New();
@@ -215,11 +269,36 @@ CComboBoxControl *CControlManager::CreateComboBox(CWindowControl *parent)
     return control;
 }
 
-std::vector<CLayoutControl*> CControlManager::GetLayouts()
+const std::vector<CLayoutControl *> &CControlManager::GetLayouts() const
 {
     return _layouts;
 }
 
+void CControlManager::AddDirtyLayout(CLayoutControl *layout)
+{
+    _dirtyLayouts.push_back(layout);
+}
+
+int CControlManager::RefreshDirtyLayouts()
+{
+    if (_dirtyLayouts.empty())
+    {
+        return 0;
+    }
+
+    // 갱신 중에 다시 더러워진 레이아웃은 새 목록에 모여 다음 프레임에 처리된다.
+    _refreshingLayouts.swap(_dirtyLayouts);
+    for (auto layout : _refreshingLayouts)
+    {
+        layout->ApplyCommands();
+        layout->Refresh();
+    }
+
+    int count = int(_refreshingLayouts.size());
+    _refreshingLayouts.clear();
+    return count;
+}
+
 HINSTANCE CControlManager::GetHInstance()
 {
     return _hInstance;
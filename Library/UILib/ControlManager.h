@@ -23,6 +23,7 @@ class CListViewControl;
 class CListViewColumn;
 class CListViewRow;
 class CListViewItem;
+class CListViewTable;
 class CStaticControl;
 class CGroupBoxControl;
 class CCheckBoxControl;
@@ -30,6 +31,9 @@ class CRadioButtonControl;
 class CComboBoxControl;
 class CAudioPlayerControl;
 class CGraphicText;
+class CSpriteAnimation;
+class CTween;
+class CWindowTransition;
 
 class CControlManager
 {
@@ -54,6 +58,7 @@ public:
     CListViewColumn *CreateListViewColumn();
     CListViewRow *CreateListViewRow();
     CListViewItem *CreateListViewItem();
+    CListViewTable *CreateListViewTable();
     CStaticControl *CreateStatic(CWindowControl *parent);
     CGroupBoxControl *CreateGroupBox(CWindowControl *parent);
     CCheckBoxControl *CreateCheckBox(CWindowControl *parent);
@@ -61,8 +66,15 @@ public:
     CComboBoxControl *CreateComboBox(CWindowControl *parent);
     CAudioPlayerControl *CreateAudioPlayer();
     CGraphicText *CreateGraphicText();
+    CSpriteAnimation *CreateSpriteAnimation();
+    CTween *CreateTween();
+    CTween *CreateTweenSequence();
+    CTween *CreateTweenParallel();
+    CWindowTransition *CreateTransition(CWindowControl *window);
 
-    std::vector<CLayoutControl *> GetLayouts();
+    const std::vector<CLayoutControl *> &GetLayouts() const;
+    void AddDirtyLayout(CLayoutControl *layout);
+    int RefreshDirtyLayouts();
     HINSTANCE GetHInstance();
 
     static CControlManager &GetInstance();
@@ -71,6 +83,8 @@ protected:
     HINSTANCE _hInstance;
 
     std::vector<CLayoutControl *> _layouts;
+    std::vector<CLayoutControl *> _dirtyLayouts;
+    std::vector<CLayoutControl *> _refreshingLayouts;
 
     static std::once_flag s_onceFlag;
     static std::unique_ptr<CControlManager> s_controlManager;
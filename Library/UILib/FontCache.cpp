@@ -0,0 +1,239 @@
+#include "FontCache.h"
+#include "GdiGlyphSource.h"
+
+#include <windowsx.h>
+#include <tuple>
+
+namespace jojogame
+{
+std::once_flag CFontCache::s_onceFlag;
+std::unique_ptr<CFontCache> CFontCache::s_sharedFontCache;
+
+const wchar_t ASCII_FIRST = 0x20;
+const wchar_t ASCII_LAST = 0x7E;
+const wchar_t HANGUL_FIRST = 0xAC00;
+const wchar_t HANGUL_LAST = 0xD7A3;
+
+bool FontKey::operator<(const FontKey &other) const
+{
+    return std::tie(name, size, isBold, isItalic, isUnderline) <
+           std::tie(other.name, other.size, other.isBold, other.isItalic, other.isUnderline);
+}
+
+void CFontCache::RegisterFunctions(lua_State *L)
+{
+    LUA_BEGIN(CFontCache, "_FontCache");
+
+    LUA_METHOD(GetFontCount);
+    LUA_METHOD(IsGlyphAtlas);
+
+    LUA_METHOD(SetGlyphAtlas);
+}
+
+CFontCache::CFontCache()
+{
+    _measureDC = CreateCompatibleDC(nullptr);
+}
+
+CFontCache::~CFontCache()
+{
+    // 아틀라스의 GDI 글리프 소스가 폰트를 DC 에 선택해 두고 있으므로 먼저 해제한다.
+    for (auto &font : _fonts)
+    {
+        font.second.atlas.reset();
+        DeleteFont(font.second.font);
+    }
+    _fonts.clear();
+    _handles.clear();
+
+    DeleteDC(_measureDC);
+}
+
+int CFontCache::GetFontCount() const
+{
+    return static_cast<int>(_fonts.size());
+}
+
+bool CFontCache::IsGlyphAtlas() const
+{
+    return _isGlyphAtlas;
+}
+
+void CFontCache::SetGlyphAtlas(bool value)
+{
+    _isGlyphAtlas = value;
+}
+
+HFONT CFontCache::Acquire(const FontKey &key)
+{
+    auto iter = _fonts.find(key);
+    if (iter != _fonts.end())
+    {
+        ++iter->second.refCount;
+        return iter->second.font;
+    }
+
+    HFONT font = _CreateFont(key);
+    if (font == nullptr)
+    {
+        return nullptr;
+    }
+
+    iter = _fonts.emplace(key, FontEntry{font, 1, nullptr, nullptr}).first;
+    _handles[font] = iter;
+
+    return font;
+}
+
+void CFontCache::Release(HFONT font)
+{
+    auto iter = _handles.find(font);
+    if (iter == _handles.end())
+    {
+        return;
+    }
+
+    auto entry = iter->second;
+    if (--entry->second.refCount <= 0)
+    {
+        entry->second.atlas.reset();
+        DeleteFont(entry->second.font);
+        _fonts.erase(entry);
+        _handles.erase(iter);
+    }
+}
+
+const FontMetrics *CFontCache::GetMetrics(HFONT font)
+{
+    auto iter = _handles.find(font);
+    if (iter == _handles.end())
+    {
+        return nullptr;
+    }
+
+    auto &entry = iter->second->second;
+    if (entry.metrics == nullptr)
+    {
+        entry.metrics = _CreateMetrics(font);
+    }
+
+    return entry.metrics.get();
+}
+
+bool CFontCache::MeasureText(HFONT font, const std::wstring &text, SIZE &size)
+{
+    auto metrics = GetMetrics(font);
+    if (metrics == nullptr || !metrics->isMeasurable || text.empty())
+    {
+        return false;
+    }
+
+    // DrawText 가 따로 처리하는 글자(줄바꿈, 탭, & 접두사)나 표에 없는 글자는 GDI 로 잰다.
+    int width = 0;
+    for (auto ch : text)
+    {
+        if (ch == L'&')
+        {
+            return false;
+        }
+        else if (ch >= ASCII_FIRST && ch <= ASCII_LAST)
+        {
+            width += metrics->asciiAdvances[ch - ASCII_FIRST];
+        }
+        else if (ch >= HANGUL_FIRST && ch <= HANGUL_LAST)
+        {
+            width += metrics->hangulAdvances[ch - HANGUL_FIRST];
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    size.cx = width;
+    size.cy = metrics->height;
+    return true;
+}
+
+CGlyphAtlas *CFontCache::GetGlyphAtlas(HFONT font)
+{
+    if (!_isGlyphAtlas)
+    {
+        return nullptr;
+    }
+
+    auto iter = _handles.find(font);
+    if (iter == _handles.end())
+    {
+        return nullptr;
+    }
+
+    // 밑줄과 취소선(굵게 값이 취소선 인자로 넘어간다)은 글리프에 들어있지 않으므로 GDI 로 그린다.
+    auto &key = iter->second->first;
+    if (key.isUnderline || key.isBold)
+    {
+        return nullptr;
+    }
+
+    auto &entry = iter->second->second;
+    if (entry.atlas == nullptr)
+    {
+        entry.atlas = std::make_unique<CGlyphAtlas>(std::make_unique<CGdiGlyphSource>(font));
+    }
+
+    return entry.atlas.get();
+}
+
+CFontCache &CFontCache::GetInstance()
+{
+    std::call_once(s_onceFlag,
+                   [] {
+                       s_sharedFontCache = std::make_unique<jojogame::CFontCache>();
+                   });
+
+    return *s_sharedFontCache;
+}
+
+HFONT CFontCache::_CreateFont(const FontKey &key)
+{
+    return CreateFontW(key.size,
+                       0,
+                       0,
+                       0,
+                       FW_NORMAL,
+                       static_cast<DWORD>(key.isItalic),
+                       static_cast<DWORD>(key.isUnderline),
+                       static_cast<DWORD>(key.isBold),
+                       HANGEUL_CHARSET,
+                       0,
+                       0,
+                       0,
+                       VARIABLE_PITCH | FF_ROMAN,
+                       key.name.c_str());
+}
+
+std::unique_ptr<FontMetrics> CFontCache::_CreateMetrics(HFONT font)
+{
+    auto metrics = std::make_unique<FontMetrics>();
+    auto originalFont = SelectFont(_measureDC, font);
+
+    TEXTMETRICW textMetric;
+    GetTextMetricsW(_measureDC, &textMetric);
+    metrics->height = textMetric.tmHeight;
+    metrics->ascent = textMetric.tmAscent;
+    metrics->descent = textMetric.tmDescent;
+    metrics->averageCharWidth = textMetric.tmAveCharWidth;
+
+    metrics->asciiAdvances.resize(ASCII_LAST - ASCII_FIRST + 1);
+    metrics->hangulAdvances.resize(HANGUL_LAST - HANGUL_FIRST + 1);
+
+    // 기울임꼴은 오버행 때문에 폭이 글자 폭의 합과 달라진다.
+    metrics->isMeasurable =
+        textMetric.tmItalic == 0 && textMetric.tmOverhang == 0 &&
+        GetCharWidth32W(_measureDC, ASCII_FIRST, ASCII_LAST, metrics->asciiAdvances.data()) &&
+        GetCharWidth32W(_measureDC, HANGUL_FIRST, HANGUL_LAST, metrics->hangulAdvances.data());
+
+    SelectFont(_measureDC, originalFont);
+    return metrics;
+}
+} // namespace jojogame
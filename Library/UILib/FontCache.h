@@ -0,0 +1,80 @@
+#pragma once
+
+#include "BaseLib\GlyphAtlas.h"
+#include "LuaLib\LuaTinker.h"
+
+#include <Windows.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace jojogame
+{
+struct FontKey
+{
+    std::wstring name;
+    int size;
+    bool isBold;
+    bool isItalic;
+    bool isUnderline;
+
+    bool operator<(const FontKey &other) const;
+};
+
+struct FontMetrics
+{
+    int height;
+    int ascent;
+    int descent;
+    int averageCharWidth;
+    bool isMeasurable;
+    std::vector<int> asciiAdvances;
+    std::vector<int> hangulAdvances;
+};
+
+class CFontCache
+{
+public:
+    static void RegisterFunctions(lua_State *L);
+
+    CFontCache();
+    virtual ~CFontCache();
+
+    int GetFontCount() const;
+    bool IsGlyphAtlas() const;
+
+    void SetGlyphAtlas(bool value);
+
+    HFONT Acquire(const FontKey &key);
+    void Release(HFONT font);
+
+    const FontMetrics *GetMetrics(HFONT font);
+    bool MeasureText(HFONT font, const std::wstring &text, SIZE &size);
+    CGlyphAtlas *GetGlyphAtlas(HFONT font);
+
+    static CFontCache &GetInstance();
+
+private:
+    struct FontEntry
+    {
+        HFONT font;
+        int refCount;
+        std::unique_ptr<FontMetrics> metrics;
+        std::unique_ptr<CGlyphAtlas> atlas;
+    };
+
+    HFONT _CreateFont(const FontKey &key);
+    std::unique_ptr<FontMetrics> _CreateMetrics(HFONT font);
+
+    std::map<FontKey, FontEntry> _fonts;
+    std::map<HFONT, std::map<FontKey, FontEntry>::iterator> _handles;
+
+    HDC _measureDC;
+    bool _isGlyphAtlas = false;
+
+    static std::once_flag s_onceFlag;
+    static std::unique_ptr<CFontCache> s_sharedFontCache;
+};
+} // namespace jojogame
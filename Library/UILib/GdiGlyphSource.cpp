@@ -0,0 +1,74 @@
+#include "GdiGlyphSource.h"
+
+#include <windowsx.h>
+
+namespace jojogame
+{
+CGdiGlyphSource::CGdiGlyphSource(HFONT font)
+{
+    _dc = CreateCompatibleDC(nullptr);
+    _oldFont = SelectFont(_dc, font);
+
+    TEXTMETRICW textMetric;
+    GetTextMetricsW(_dc, &textMetric);
+    _lineHeight = textMetric.tmHeight;
+    _ascent = textMetric.tmAscent;
+}
+
+CGdiGlyphSource::~CGdiGlyphSource()
+{
+    SelectFont(_dc, _oldFont);
+    DeleteDC(_dc);
+}
+
+int CGdiGlyphSource::GetLineHeight() const
+{
+    return _lineHeight;
+}
+
+bool CGdiGlyphSource::RasterizeGlyph(wchar_t ch, GlyphBitmap &glyph)
+{
+    MAT2 matrix{{0, 1}, {0, 0}, {0, 0}, {0, 1}};
+    GLYPHMETRICS metrics;
+
+    DWORD size = GetGlyphOutlineW(_dc, ch, GGO_GRAY8_BITMAP, &metrics, 0, nullptr, &matrix);
+    if (size == GDI_ERROR)
+    {
+        return false;
+    }
+
+    glyph.advance = metrics.gmCellIncX;
+    glyph.offsetX = metrics.gmptGlyphOrigin.x;
+    glyph.offsetY = _ascent - metrics.gmptGlyphOrigin.y;
+    glyph.width = 0;
+    glyph.height = 0;
+
+    if (size == 0)
+    {
+        return true;
+    }
+
+    std::vector<BYTE> buffer(size);
+    if (GetGlyphOutlineW(_dc, ch, GGO_GRAY8_BITMAP, &metrics, size, buffer.data(), &matrix) == GDI_ERROR)
+    {
+        return false;
+    }
+
+    // GGO_GRAY8_BITMAP 은 0~64 단계이고 한 줄이 4바이트 단위로 맞춰져 있다.
+    int pitch = (metrics.gmBlackBoxX + 3) & ~3;
+    glyph.width = metrics.gmBlackBoxX;
+    glyph.height = metrics.gmBlackBoxY;
+    glyph.coverage.resize(size_t(glyph.width) * glyph.height);
+
+    for (int y = 0; y < glyph.height; ++y)
+    {
+        for (int x = 0; x < glyph.width; ++x)
+        {
+            int level = buffer[size_t(y) * pitch + x];
+            glyph.coverage[size_t(y) * glyph.width + x] = BYTE(level >= 64 ? 255 : level * 255 / 64);
+        }
+    }
+
+    return true;
+}
+} // namespace jojogame
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "BaseLib\GlyphAtlas.h"
+
+#include <Windows.h>
+
+namespace jojogame
+{
+class CGdiGlyphSource : public IGlyphSource
+{
+public:
+    CGdiGlyphSource(HFONT font);
+    virtual ~CGdiGlyphSource();
+
+    int GetLineHeight() const override;
+    bool RasterizeGlyph(wchar_t ch, GlyphBitmap &glyph) override;
+
+private:
+    HDC _dc;
+    HFONT _oldFont;
+    int _lineHeight = 0;
+    int _ascent = 0;
+};
+} // namespace jojogame
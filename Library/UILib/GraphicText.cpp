@@ -1,4 +1,5 @@
 ﻿#include "GraphicText.h"
+#include "FontCache.h"
 #include <windowsx.h>
 
 namespace jojogame
@@ -10,9 +11,11 @@ void CGraphicText::RegisterFunctions(lua_State *L)
     LUA_METHOD(GetFont);
     LUA_METHOD(GetText);
     LUA_METHOD(GetTextColor);
+    LUA_METHOD(IsCached);
 
     LUA_METHOD(SetText);
     LUA_METHOD(SetTextColor);
+    LUA_METHOD(SetCached);
 }
 
 CGraphicText::CGraphicText()
@@ -21,6 +24,7 @@ CGraphicText::CGraphicText()
 
 CGraphicText::~CGraphicText()
 {
+    _DeleteCacheBitmap();
 }
 
 CTextFont *CGraphicText::GetFont()
@@ -40,29 +44,40 @@ COLORREF CGraphicText::GetTextColor()
 
 int CGraphicText::GetWidth(HDC hdc)
 {
-    auto originalFont = SelectFont(hdc, _font.GetHFont());
-
-    RECT rect{0, 0, 0, 0};
-    DrawText(hdc, _text.c_str(), _text.length(), &rect, DT_CALCRECT);
-    SelectFont(hdc, originalFont);
-
-    return rect.right;
+    _UpdateExtent();
+    return _extent.cx;
 }
 
 int CGraphicText::GetHeight(HDC hdc)
 {
-    auto originalFont = SelectFont(hdc, _font.GetHFont());
+    _UpdateExtent();
+    return _extent.cy;
+}
 
-    RECT rect{0, 0, 0, 0};
-    DrawText(hdc, _text.c_str(), _text.length(), &rect, DT_CALCRECT);
-    SelectFont(hdc, originalFont);
+bool CGraphicText::IsCached() const
+{
+    return _isCached;
+}
+
+CGlyphAtlas *CGraphicText::GetGlyphAtlas()
+{
+    // 캐시 비트맵으로 그리거나 DrawText 가 따로 처리하는 글자가 있으면 GDI 로 그린다.
+    if (_isCached || _text.find_first_of(L"&\t\r\n") != std::wstring::npos)
+    {
+        return nullptr;
+    }
 
-    return rect.bottom;
+    return CFontCache::GetInstance().GetGlyphAtlas(_font.GetHFont());
 }
 
 void CGraphicText::SetText(std::wstring text)
 {
-    _text = text;
+    if (_text != text)
+    {
+        _text = text;
+        _isExtentValid = false;
+        _isCacheValid = false;
+    }
 }
 
 void CGraphicText::SetTextColor(COLORREF color)
@@ -70,19 +85,200 @@ void CGraphicText::SetTextColor(COLORREF color)
     _textColor = color;
 }
 
+void CGraphicText::SetCached(bool value)
+{
+    _isCached = value;
+    if (!_isCached)
+    {
+        _DeleteCacheBitmap();
+    }
+}
+
 void CGraphicText::Draw(HDC hdc, POINT position)
 {
+    _UpdateExtent();
+    if (_extent.cx <= 0 || _extent.cy <= 0)
+    {
+        return;
+    }
+
+    if (_isCached)
+    {
+        _UpdateCacheBitmap();
+        if (_cacheBitmap != nullptr)
+        {
+            HDC cacheDC = _GetMeasureDC();
+            auto oldBitmap = SelectBitmap(cacheDC, _cacheBitmap);
+
+            BLENDFUNCTION blend{AC_SRC_OVER, 0, 255, AC_SRC_ALPHA};
+            GdiAlphaBlend(hdc, position.x, position.y, _extent.cx, _extent.cy, cacheDC, 0, 0, _extent.cx,
+                          _extent.cy, blend);
+
+            SelectBitmap(cacheDC, oldBitmap);
+            return;
+        }
+    }
+    else if (_DrawWithGlyphAtlas(hdc, position))
+    {
+        return;
+    }
+
     auto originalFont = SelectFont(hdc, _font.GetHFont());
     auto originalTextColor = ::SetTextColor(hdc, _textColor);
     SetBkMode(hdc, TRANSPARENT);
 
-    RECT rect{0, 0, 0, 0};
-    DrawText(hdc, _text.c_str(), _text.length(), &rect, DT_CALCRECT);
-    SetRect(&rect, position.x, position.y, position.x + rect.right, position.y + rect.bottom);
+    RECT rect;
+    SetRect(&rect, position.x, position.y, position.x + _extent.cx, position.y + _extent.cy);
     DrawText(hdc, _text.c_str(), _text.length(), &rect, DT_NOCLIP);
 
     ::SetTextColor(hdc, originalTextColor);
     SelectFont(hdc, originalFont);
 }
 
+HDC CGraphicText::_GetMeasureDC()
+{
+    // 크기 측정과 캐시 비트맵 작성에 같이 쓰는 메모리 DC
+    static HDC s_measureDC = CreateCompatibleDC(nullptr);
+    return s_measureDC;
+}
+
+void CGraphicText::_UpdateExtent()
+{
+    if (_isExtentValid && _extentFontVersion == _font.GetVersion())
+    {
+        return;
+    }
+
+    // 한 줄짜리 한글/ASCII 문자열은 글꼴 캐시의 글자 폭 표로 바로 계산한다.
+    if (!CFontCache::GetInstance().MeasureText(_font.GetHFont(), _text, _extent))
+    {
+        HDC measureDC = _GetMeasureDC();
+        auto originalFont = SelectFont(measureDC, _font.GetHFont());
+
+        RECT rect{0, 0, 0, 0};
+        DrawText(measureDC, _text.c_str(), _text.length(), &rect, DT_CALCRECT);
+        SelectFont(measureDC, originalFont);
+
+        _extent.cx = rect.right;
+        _extent.cy = rect.bottom;
+    }
+    _extentFontVersion = _font.GetVersion();
+    _isExtentValid = true;
+}
+
+bool CGraphicText::_DrawWithGlyphAtlas(HDC hdc, POINT position)
+{
+    auto atlas = GetGlyphAtlas();
+    if (atlas == nullptr)
+    {
+        return false;
+    }
+
+    // 위에서 아래로 쌓인 32비트 DIB 섹션에 그릴 때만 픽셀을 직접 쓴다.
+    DIBSECTION dibSection;
+    HGDIOBJ bitmap = GetCurrentObject(hdc, OBJ_BITMAP);
+    if (bitmap == nullptr || GetObject(bitmap, sizeof(DIBSECTION), &dibSection) != sizeof(DIBSECTION) ||
+        dibSection.dsBm.bmBitsPixel != 32 || dibSection.dsBmih.biHeight >= 0 || dibSection.dsBm.bmBits == nullptr)
+    {
+        return false;
+    }
+
+    POINT origin;
+    RECT clipBox;
+    GetViewportOrgEx(hdc, &origin);
+    if (GetClipBox(hdc, &clipBox) == ERROR)
+    {
+        return false;
+    }
+
+    GdiFlush();
+
+    CFrameBuffer frameBuffer(static_cast<uint32_t *>(dibSection.dsBm.bmBits), dibSection.dsBm.bmWidth,
+                             dibSection.dsBm.bmHeight, dibSection.dsBm.bmWidthBytes / 4);
+    FrameRect clipingRect{clipBox.left + origin.x, clipBox.top + origin.y, clipBox.right + origin.x,
+                          clipBox.bottom + origin.y};
+    uint32_t color = 0xFF000000 | (GetRValue(_textColor) << 16) | (GetGValue(_textColor) << 8) | GetBValue(_textColor);
+
+    atlas->DrawString(frameBuffer, position.x + origin.x, position.y + origin.y, _text, color, clipingRect);
+    return true;
+}
+
+void CGraphicText::_UpdateCacheBitmap()
+{
+    if (_cacheBitmap != nullptr && _isCacheValid && _cacheFontVersion == _font.GetVersion() &&
+        _cacheTextColor == _textColor)
+    {
+        return;
+    }
+
+    _DeleteCacheBitmap();
+
+    BITMAPINFO bitmapInfo{};
+    bitmapInfo.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bitmapInfo.bmiHeader.biWidth = _extent.cx;
+    bitmapInfo.bmiHeader.biHeight = -_extent.cy;
+    bitmapInfo.bmiHeader.biPlanes = 1;
+    bitmapInfo.bmiHeader.biBitCount = 32;
+    bitmapInfo.bmiHeader.biCompression = BI_RGB;
+
+    void *bits = nullptr;
+    _cacheBitmap = CreateDIBSection(nullptr, &bitmapInfo, DIB_RGB_COLORS, &bits, nullptr, 0);
+    if (_cacheBitmap == nullptr)
+    {
+        return;
+    }
+
+    HDC cacheDC = _GetMeasureDC();
+    auto oldBitmap = SelectBitmap(cacheDC, _cacheBitmap);
+    auto originalFont = SelectFont(cacheDC, _font.GetHFont());
+
+    // 검은 바탕에 흰 글자를 그린 뒤 밝기를 알파로 삼아 미리 곱한 색으로 바꾼다.
+    int pixelCount = _extent.cx * _extent.cy;
+    auto pixels = static_cast<DWORD *>(bits);
+    ZeroMemory(pixels, sizeof(DWORD) * pixelCount);
+
+    ::SetTextColor(cacheDC, RGB(255, 255, 255));
+    SetBkMode(cacheDC, TRANSPARENT);
+    RECT rect{0, 0, _extent.cx, _extent.cy};
+    DrawText(cacheDC, _text.c_str(), _text.length(), &rect, DT_NOCLIP);
+    GdiFlush();
+
+    BYTE red = GetRValue(_textColor);
+    BYTE green = GetGValue(_textColor);
+    BYTE blue = GetBValue(_textColor);
+    for (int i = 0; i < pixelCount; ++i)
+    {
+        DWORD pixel = pixels[i];
+        BYTE alpha = BYTE(pixel & 0xFF);
+        if (BYTE((pixel >> 8) & 0xFF) > alpha)
+        {
+            alpha = BYTE((pixel >> 8) & 0xFF);
+        }
+        if (BYTE((pixel >> 16) & 0xFF) > alpha)
+        {
+            alpha = BYTE((pixel >> 16) & 0xFF);
+        }
+
+        pixels[i] = (DWORD(alpha) << 24) | (DWORD(red * alpha / 255) << 16) | (DWORD(green * alpha / 255) << 8) |
+                    DWORD(blue * alpha / 255);
+    }
+
+    SelectFont(cacheDC, originalFont);
+    SelectBitmap(cacheDC, oldBitmap);
+
+    _cacheFontVersion = _font.GetVersion();
+    _cacheTextColor = _textColor;
+    _isCacheValid = true;
+}
+
+void CGraphicText::_DeleteCacheBitmap()
+{
+    if (_cacheBitmap != nullptr)
+    {
+        DeleteBitmap(_cacheBitmap);
+        _cacheBitmap = nullptr;
+    }
+    _isCacheValid = false;
+}
+
 } // namespace jojogame
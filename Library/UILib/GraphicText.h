@@ -3,6 +3,8 @@
 
 namespace jojogame
 {
+class CGlyphAtlas;
+
 class CGraphicText
 {
 public:
@@ -14,17 +16,37 @@ public:
     CTextFont *GetFont();
     std::wstring GetText();
     COLORREF GetTextColor();
-    int GetWidth(HDC hdc);
-    int GetHeight(HDC hdc);
+    int GetWidth(HDC hdc = nullptr);
+    int GetHeight(HDC hdc = nullptr);
+    bool IsCached() const;
+    CGlyphAtlas *GetGlyphAtlas();
 
     void SetText(std::wstring text);
     void SetTextColor(COLORREF color);
+    void SetCached(bool value);
 
     void Draw(HDC hdc, POINT position);
 
 private:
+    static HDC _GetMeasureDC();
+
+    void _UpdateExtent();
+    bool _DrawWithGlyphAtlas(HDC hdc, POINT position);
+    void _UpdateCacheBitmap();
+    void _DeleteCacheBitmap();
+
     std::wstring _text = L"";
     COLORREF _textColor = RGB(0, 0, 0);
     CTextFont _font;
+
+    SIZE _extent{0, 0};
+    int _extentFontVersion = -1;
+    bool _isExtentValid = false;
+
+    bool _isCached = false;
+    HBITMAP _cacheBitmap = nullptr;
+    int _cacheFontVersion = -1;
+    COLORREF _cacheTextColor = RGB(0, 0, 0);
+    bool _isCacheValid = false;
 };
 } // namespace jojogame
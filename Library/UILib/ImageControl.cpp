@@ -1,6 +1,8 @@
 #include "ImageControl.h"
 
+#include "ScaledImageCache.h"
 #include "BaseLib/Color.h"
+#include "BaseLib/Profiler.h"
 #include "CommonLib/ME5File.h"
 #include "CommonLib/FileManager.h"
 #include "CommonLib/lodepng.h"
@@ -12,6 +14,7 @@ extern "C"
 
 #include <iterator>
 #include <vector>
+#include <windowsx.h>
 
 namespace jojogame
 {
@@ -185,8 +188,10 @@ void CImageControl::RegisterFunctions(lua_State *L)
 
     LUA_METHOD(GetWidth);
     LUA_METHOD(GetHeight);
+    LUA_METHOD(IsOpaque);
 
     LUA_METHOD(SetDisplayMirror);
+    LUA_METHOD(SetOpaque);
 
     LUA_METHOD(SetClipingRect);
     LUA_METHOD(ResetClipingRect);
@@ -202,6 +207,8 @@ CImageControl::CImageControl()
 
 CImageControl::~CImageControl()
 {
+    CScaledImageCache::GetInstance().Invalidate(this);
+
     if (_image)
     {
         DeleteObject(_image);
@@ -226,6 +233,8 @@ CImageControl::~CImageControl()
 
 void CImageControl::ReadJpeg(BYTE *src, int size, COLORREF maskColor, double brightness, bool mirror)
 {
+    PROFILE_ZONE("Image Decode");
+
     struct jpeg_decompress_struct cinfo;
     struct jpeg_error_mgr jerr;
 
@@ -286,6 +295,8 @@ void CImageControl::ReadJpeg(BYTE *src, int size, COLORREF maskColor, double bri
     HDC imageDC = CreateCompatibleDC(dc);
     HDC maskDC = CreateCompatibleDC(dc);
 
+    // 마스크 색이 한 픽셀도 없으면 불투명 이미지로 취급한다.
+    _isOpaque = true;
     int lineWidth = _size.cx;
     for (int y = 0; y < _size.cy; ++y)
     {
@@ -298,6 +309,7 @@ void CImageControl::ReadJpeg(BYTE *src, int size, COLORREF maskColor, double bri
 
             if (r == GetRValue(maskColor) && g == GetGValue(maskColor) && b == GetBValue(maskColor))
             {
+                _isOpaque = false;
                 continue;
             }
             RgbToHsv(r, g, b, h, s, v);
@@ -355,6 +367,8 @@ void CImageControl::ReadJpeg(BYTE *src, int size, COLORREF maskColor, double bri
         delete[] copyBytes;
     }
 
+    _pixels[0].reset();
+    _pixels[1].reset();
     _image = CreateDIBitmap(dc, &bmpInfo.bmiHeader, CBM_INIT, (void *)bits, &bmpInfo, DIB_RGB_COLORS);
     _maskImage = CreateBitmap(_size.cx, _size.cy, 1, 1, nullptr);
 
@@ -378,6 +392,8 @@ void CImageControl::ReadJpeg(BYTE *src, int size, COLORREF maskColor, double bri
 
 void CImageControl::ReadPng(BYTE *src, int size, COLORREF maskColor, double brightness, bool mirror)
 {
+    PROFILE_ZONE("Image Decode");
+
     std::vector<BYTE> bmp;
     PngToBmp(bmp, src, size);
 
@@ -400,6 +416,8 @@ void CImageControl::ReadPng(BYTE *src, int size, COLORREF maskColor, double brig
     HDC imageDC = CreateCompatibleDC(dc);
     HDC maskDC = CreateCompatibleDC(dc);
 
+    // 마스크 색이 한 픽셀도 없으면 불투명 이미지로 취급한다.
+    _isOpaque = true;
     int lineWidth = _size.cx;
     for (int y = 0; y < _size.cy; ++y)
     {
@@ -412,6 +430,7 @@ void CImageControl::ReadPng(BYTE *src, int size, COLORREF maskColor, double brig
 
             if (r == GetRValue(maskColor) && g == GetGValue(maskColor) && b == GetBValue(maskColor))
             {
+                _isOpaque = false;
                 continue;
             }
             RgbToHsv(r, g, b, h, s, v);
@@ -469,6 +488,8 @@ void CImageControl::ReadPng(BYTE *src, int size, COLORREF maskColor, double brig
         delete[] copyBytes;
     }
 
+    _pixels[0].reset();
+    _pixels[1].reset();
     _image = CreateDIBitmap(dc, bmpInfoHeader, CBM_INIT, (void *)bits, bmpInfo, DIB_RGB_COLORS);
     _maskImage = CreateBitmap(_size.cx, _size.cy, 1, 1, nullptr);
 
@@ -522,6 +543,8 @@ void CImageControl::LoadImageFromMe5FileByIndex(std::wstring filePath, int group
 
     imageFile.GetItemByteArr(by, groupIndex, subIndex);
 
+    CScaledImageCache::GetInstance().Invalidate(this);
+
     _maskColor = maskColor;
     if (by[0] == 0xFF && by[1] == 0xD8)
     {
@@ -565,6 +588,74 @@ HBITMAP CImageControl::GetMaskMirrorImageHandle()
     return _maskMirrorImage;
 }
 
+const CFrameBuffer *CImageControl::GetPixels(HDC imageDC)
+{
+    int index = _isDisplayMirror ? 1 : 0;
+    if (_pixels[index] != nullptr)
+    {
+        return _pixels[index].get();
+    }
+
+    HBITMAP maskBitmap = _isDisplayMirror ? _maskMirrorImage : _maskImage;
+    if (imageDC == nullptr || maskBitmap == nullptr || _size.cx <= 0 || _size.cy <= 0)
+    {
+        return nullptr;
+    }
+
+    BITMAPINFO bitmapInfo{};
+    bitmapInfo.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bitmapInfo.bmiHeader.biWidth = _size.cx;
+    bitmapInfo.bmiHeader.biHeight = -_size.cy;
+    bitmapInfo.bmiHeader.biPlanes = 1;
+    bitmapInfo.bmiHeader.biBitCount = 32;
+    bitmapInfo.bmiHeader.biCompression = BI_RGB;
+
+    void *bits = nullptr;
+    HBITMAP readBitmap = CreateDIBSection(nullptr, &bitmapInfo, DIB_RGB_COLORS, &bits, nullptr, 0);
+    if (readBitmap == nullptr)
+    {
+        return nullptr;
+    }
+
+    // 이미지 비트맵은 레이아웃의 DC 에 선택된 채로 있으므로 그 DC 에서 복사해 읽는다.
+    HDC readDC = CreateCompatibleDC(imageDC);
+    HDC maskDC = CreateCompatibleDC(imageDC);
+    auto oldReadBitmap = SelectBitmap(readDC, readBitmap);
+    auto oldMask = SelectBitmap(maskDC, maskBitmap);
+    SetTextColor(readDC, RGB(0, 0, 0));
+    SetBkColor(readDC, RGB(255, 255, 255));
+
+    auto pixels = std::make_unique<CFrameBuffer>(_size.cx, _size.cy);
+    auto readPixels = static_cast<const uint32_t *>(bits);
+    size_t pixelCount = size_t(_size.cx) * _size.cy;
+
+    BitBlt(readDC, 0, 0, _size.cx, _size.cy, maskDC, 0, 0, SRCCOPY);
+    GdiFlush();
+    for (size_t i = 0; i < pixelCount; ++i)
+    {
+        pixels->GetPixels()[i] = (readPixels[i] & 0x00FFFFFF) != 0 ? 0 : 0xFF000000;
+    }
+
+    BitBlt(readDC, 0, 0, _size.cx, _size.cy, imageDC, 0, 0, SRCCOPY);
+    GdiFlush();
+    for (size_t i = 0; i < pixelCount; ++i)
+    {
+        if (pixels->GetPixels()[i] != 0)
+        {
+            pixels->GetPixels()[i] |= readPixels[i] & 0x00FFFFFF;
+        }
+    }
+
+    SelectBitmap(maskDC, oldMask);
+    SelectBitmap(readDC, oldReadBitmap);
+    DeleteDC(maskDC);
+    DeleteDC(readDC);
+    DeleteBitmap(readBitmap);
+
+    _pixels[index] = std::move(pixels);
+    return _pixels[index].get();
+}
+
 BITMAPINFO CImageControl::GetBitmapInfo()
 {
     return _info;
@@ -580,11 +671,21 @@ bool CImageControl::IsDisplayMirror()
     return _isDisplayMirror;
 }
 
+bool CImageControl::IsOpaque()
+{
+    return _isOpaque;
+}
+
 void CImageControl::SetDisplayMirror(bool value)
 {
     _isDisplayMirror = value;
 }
 
+void CImageControl::SetOpaque(bool value)
+{
+    _isOpaque = value;
+}
+
 void CImageControl::SetClipingRect(int left, int top, int right, int bottom)
 {
     _clipingRect.left = left;
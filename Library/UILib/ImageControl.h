@@ -1,8 +1,10 @@
 #pragma once
 
+#include "BaseLib\FrameBuffer.h"
 #include "LuaLib\LuaTinker.h"
 
 #include <Windows.h>
+#include <memory>
 
 namespace jojogame
 {
@@ -28,11 +30,14 @@ public:
     HBITMAP GetMirrorImageHandle();
     HBITMAP GetMaskImageHandle();
     HBITMAP GetMaskMirrorImageHandle();
+    const CFrameBuffer *GetPixels(HDC imageDC);
     BITMAPINFO GetBitmapInfo();
     COLORREF GetMaskColor();
     bool IsDisplayMirror();
+    bool IsOpaque();
 
     void SetDisplayMirror(bool value);
+    void SetOpaque(bool value);
 
     void SetClipingRect(int left, int top, int right, int bottom);
     void ResetClipingRect();
@@ -53,5 +58,9 @@ private:
     COLORREF _maskColor;
 
     bool _isDisplayMirror = false;
+    bool _isOpaque = false;
+
+    // 소프트웨어 합성용 32비트 픽셀 (마스크로 가려지는 곳은 알파 0), 일반/좌우 반전
+    std::unique_ptr<CFrameBuffer> _pixels[2];
 };
 }; // namespace jojogame
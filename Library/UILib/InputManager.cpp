@@ -0,0 +1,268 @@
+#include "InputManager.h"
+
+#include "WindowControl.h"
+#include "BaseLib/Profiler.h"
+
+namespace jojogame
+{
+std::once_flag CInputManager::s_onceFlag;
+std::unique_ptr<CInputManager> CInputManager::s_sharedInputManager;
+
+void CInputManager::RegisterFunctions(lua_State *L)
+{
+    LUA_BEGIN(CInputManager, "_InputManager");
+
+    LUA_METHOD(GetPendingCount);
+    LUA_METHOD(IsKeyDown);
+    LUA_METHOD(GetMouseX);
+    LUA_METHOD(GetMouseY);
+
+    LUA_METHOD(SetInputEvent);
+
+    LUA_METHOD(ResetKeyStates);
+
+    lua_tinker::set(L, "INPUT_KEY_DOWN", static_cast<int>(INPUT_KEY_DOWN));
+    lua_tinker::set(L, "INPUT_KEY_UP", static_cast<int>(INPUT_KEY_UP));
+    lua_tinker::set(L, "INPUT_MOUSE_MOVE", static_cast<int>(INPUT_MOUSE_MOVE));
+    lua_tinker::set(L, "INPUT_MOUSE_LBUTTON_DOWN", static_cast<int>(INPUT_MOUSE_LBUTTON_DOWN));
+    lua_tinker::set(L, "INPUT_MOUSE_LBUTTON_UP", static_cast<int>(INPUT_MOUSE_LBUTTON_UP));
+    lua_tinker::set(L, "INPUT_MOUSE_ENTER", static_cast<int>(INPUT_MOUSE_ENTER));
+    lua_tinker::set(L, "INPUT_MOUSE_LEAVE", static_cast<int>(INPUT_MOUSE_LEAVE));
+}
+
+CInputManager::CInputManager()
+{
+}
+
+CInputManager::~CInputManager()
+{
+}
+
+int CInputManager::GetInputEvent() const
+{
+    return _inputEvent;
+}
+
+int CInputManager::GetPendingCount() const
+{
+    return int(_events.size());
+}
+
+bool CInputManager::IsKeyDown(int key) const
+{
+    if (key < 0 || key >= int(_keyStates.size()))
+    {
+        return false;
+    }
+
+    return _keyStates.test(key);
+}
+
+int CInputManager::GetMouseX() const
+{
+    return _mousePosition.x;
+}
+
+int CInputManager::GetMouseY() const
+{
+    return _mousePosition.y;
+}
+
+void CInputManager::SetInputEvent()
+{
+    auto l = CLuaTinker::GetLuaTinker().GetLuaState();
+    if (_inputEvent != LUA_NOREF)
+    {
+        luaL_unref(l, LUA_REGISTRYINDEX, _inputEvent);
+        _inputEvent = LUA_NOREF;
+    }
+
+    // 함수가 아니면(nil 등) 핸들러를 지우고 창마다 입력을 전달하던 방식으로 돌아간다.
+    if (lua_isfunction(l, -1))
+    {
+        lua_pushvalue(l, -1);
+        _inputEvent = luaL_ref(l, LUA_REGISTRYINDEX);
+    }
+
+    lua_pop(l, 1);
+}
+
+void CInputManager::Push(CWindowControl *window, int type, int key, int x, int y)
+{
+    switch (type)
+    {
+    case INPUT_KEY_DOWN:
+    case INPUT_KEY_UP:
+        if (key >= 0 && key < int(_keyStates.size()))
+        {
+            _keyStates.set(key, type == INPUT_KEY_DOWN);
+        }
+        break;
+    case INPUT_MOUSE_LBUTTON_DOWN:
+    case INPUT_MOUSE_LBUTTON_UP:
+        _keyStates.set(VK_LBUTTON, type == INPUT_MOUSE_LBUTTON_DOWN);
+        _mousePosition.x = x;
+        _mousePosition.y = y;
+        break;
+    case INPUT_MOUSE_MOVE:
+        _mousePosition.x = x;
+        _mousePosition.y = y;
+
+        // 연달아 들어온 이동은 마지막 위치 하나로 합친다.
+        if (!_events.empty() && _events.back().type == INPUT_MOUSE_MOVE && _events.back().window == window)
+        {
+            _events.back().key = key;
+            _events.back().x = x;
+            _events.back().y = y;
+            return;
+        }
+        break;
+    default:
+        break;
+    }
+
+    _events.push_back({window, type, key, x, y});
+}
+
+void CInputManager::RemoveWindow(CWindowControl *window)
+{
+    for (auto &event : _events)
+    {
+        if (event.window == window)
+        {
+            event.window = nullptr;
+        }
+    }
+}
+
+void CInputManager::ResetKeyStates()
+{
+    _keyStates.reset();
+}
+
+int CInputManager::Dispatch()
+{
+    if (_events.empty())
+    {
+        return 0;
+    }
+
+    PROFILE_ZONE("Input");
+
+    int count = int(_events.size());
+    if (_inputEvent != LUA_NOREF)
+    {
+        _DispatchBatch();
+        return count;
+    }
+
+    // 핸들러 안에서 메시지 루프가 다시 돌면 뒤에 쌓인 입력을 먼저 보낼 수 있으므로 하나씩 꺼낸다.
+    for (int i = 0; i < count && !_events.empty(); ++i)
+    {
+        InputEvent event = _events.front();
+        _events.pop_front();
+        _DispatchToWindow(event);
+    }
+
+    return count;
+}
+
+CInputManager &CInputManager::GetInstance()
+{
+    std::call_once(s_onceFlag,
+                   [] {
+                       s_sharedInputManager = std::make_unique<jojogame::CInputManager>();
+                   });
+
+    return *s_sharedInputManager;
+}
+
+void CInputManager::_DispatchBatch()
+{
+    auto &luaTinker = CLuaTinker::GetLuaTinker();
+    auto l = luaTinker.GetMainLuaState();
+
+    lua_tinker::table events(l);
+    int index = 0;
+    for (auto &event : _events)
+    {
+        if (event.window == nullptr)
+        {
+            continue;
+        }
+
+        lua_createtable(l, 0, 5);
+        lua_pushinteger(l, event.type);
+        lua_setfield(l, -2, "type");
+        lua_tinker::push(l, event.window);
+        lua_setfield(l, -2, "window");
+        lua_pushinteger(l, event.key);
+        lua_setfield(l, -2, "key");
+        lua_pushinteger(l, event.x);
+        lua_setfield(l, -2, "x");
+        lua_pushinteger(l, event.y);
+        lua_setfield(l, -2, "y");
+        lua_rawseti(l, events.m_obj->m_index, ++index);
+    }
+    _events.clear();
+
+    luaTinker.Call(_inputEvent, events);
+}
+
+void CInputManager::_DispatchToWindow(const InputEvent &event)
+{
+    auto window = event.window;
+    if (window == nullptr)
+    {
+        return;
+    }
+
+    int eventRef = LUA_NOREF;
+    switch (event.type)
+    {
+    case INPUT_KEY_DOWN:
+        eventRef = window->GetKeyDownEvent();
+        break;
+    case INPUT_KEY_UP:
+        eventRef = window->GetKeyUpEvent();
+        break;
+    case INPUT_MOUSE_MOVE:
+        eventRef = window->GetMouseMoveEvent();
+        break;
+    case INPUT_MOUSE_LBUTTON_DOWN:
+        eventRef = window->GetMouseLButtonDownEvent();
+        break;
+    case INPUT_MOUSE_LBUTTON_UP:
+        eventRef = window->GetMouseLButtonUpEvent();
+        break;
+    case INPUT_MOUSE_ENTER:
+        eventRef = window->GetMouseEnterEvent();
+        break;
+    case INPUT_MOUSE_LEAVE:
+        eventRef = window->GetMouseLeaveEvent();
+        break;
+    default:
+        break;
+    }
+
+    if (eventRef == LUA_NOREF)
+    {
+        return;
+    }
+
+    switch (event.type)
+    {
+    case INPUT_KEY_DOWN:
+    case INPUT_KEY_UP:
+        CLuaTinker::GetLuaTinker().Call(eventRef, window, event.key);
+        break;
+    case INPUT_MOUSE_ENTER:
+    case INPUT_MOUSE_LEAVE:
+        CLuaTinker::GetLuaTinker().Call(eventRef, window);
+        break;
+    default:
+        CLuaTinker::GetLuaTinker().Call(eventRef, window, event.key, event.x, event.y);
+        break;
+    }
+}
+} // namespace jojogame
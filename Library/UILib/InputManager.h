@@ -0,0 +1,72 @@
+#pragma once
+
+#include "LuaLib\LuaTinker.h"
+
+#include <Windows.h>
+#include <bitset>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace jojogame
+{
+class CWindowControl;
+
+enum INPUT_EVENT_TYPE
+{
+    INPUT_KEY_DOWN = 0,
+    INPUT_KEY_UP = 1,
+    INPUT_MOUSE_MOVE = 2,
+    INPUT_MOUSE_LBUTTON_DOWN = 3,
+    INPUT_MOUSE_LBUTTON_UP = 4,
+    INPUT_MOUSE_ENTER = 5,
+    INPUT_MOUSE_LEAVE = 6,
+};
+
+struct InputEvent
+{
+    CWindowControl *window;
+    int type;
+    int key;
+    int x;
+    int y;
+};
+
+// 윈도우 프로시저에서 받은 입력을 모아 두었다가 메인 루프의 고정 업데이트 틱마다 한 번 루아로 보낸다.
+class CInputManager
+{
+public:
+    static void RegisterFunctions(lua_State *L);
+
+    CInputManager();
+    virtual ~CInputManager();
+
+    int GetInputEvent() const;
+    int GetPendingCount() const;
+    bool IsKeyDown(int key) const;
+    int GetMouseX() const;
+    int GetMouseY() const;
+
+    void SetInputEvent();
+
+    void Push(CWindowControl *window, int type, int key, int x, int y);
+    void RemoveWindow(CWindowControl *window);
+    void ResetKeyStates();
+    int Dispatch();
+
+    static CInputManager &GetInstance();
+
+private:
+    void _DispatchBatch();
+    void _DispatchToWindow(const InputEvent &event);
+
+    std::deque<InputEvent> _events;
+    std::bitset<256> _keyStates;
+    POINT _mousePosition{};
+
+    int _inputEvent = LUA_NOREF;
+
+    static std::once_flag s_onceFlag;
+    static std::unique_ptr<CInputManager> s_sharedInputManager;
+};
+} // namespace jojogame
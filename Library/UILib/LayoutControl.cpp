@@ -1,12 +1,20 @@
 #include "LayoutControl.h"
 
 #include "WindowControl.h"
+#include "ListviewControl.h"
 #include "ImageControl.h"
 #include "GraphicText.h"
+#include "ScaledImageCache.h"
+#include "TileRenderer.h"
+#include "BaseLib/GlyphAtlas.h"
 #include "BaseLib/Color.h"
+#include "BaseLib/Profiler.h"
 #include "CommonLib/GameManager.h"
 #include "ControlManager.h"
 
+#include <map>
+#include <tuple>
+
 namespace jojogame
 {
 void CLayoutControl::RegisterFunctions(lua_State *L)
@@ -20,26 +28,54 @@ void CLayoutControl::RegisterFunctions(lua_State *L)
 
     LUA_METHOD(SetX);
     LUA_METHOD(SetY);
+    LUA_METHOD(SetPosition);
     LUA_METHOD(SetWidth);
     LUA_METHOD(SetHeight);
     LUA_METHOD(SetRatioX);
     LUA_METHOD(SetRatioY);
     LUA_METHOD(SetHide);
+    LUA_METHOD(IsOpaque);
+    LUA_METHOD(SetOpaque);
+    LUA_METHOD(GetAlpha);
+    LUA_METHOD(SetAlpha);
 
     LUA_METHOD(AddImage);
     LUA_METHOD(DeleteImage);
     LUA_METHOD(MoveImage);
     LUA_METHOD(HideImage);
     LUA_METHOD(ShowImage);
+    LUA_METHOD(GetImageX);
+    LUA_METHOD(GetImageY);
+    LUA_METHOD(GetImageAlpha);
+    LUA_METHOD(SetImageAlpha);
+    LUA_METHOD(GetImageBrightness);
+    LUA_METHOD(GetImageTintColor);
+    LUA_METHOD(GetImageTintAmount);
+    LUA_METHOD(SetImageBrightness);
+    LUA_METHOD(SetImageTint);
 
     LUA_METHOD(AddText);
     LUA_METHOD(DeleteText);
     LUA_METHOD(MoveText);
     LUA_METHOD(HideText);
     LUA_METHOD(ShowText);
+    LUA_METHOD(GetTextX);
+    LUA_METHOD(GetTextY);
+
+    LUA_METHOD(MoveImages);
+    LUA_METHOD(SetImagesVisible);
+    LUA_METHOD(QueueCommands);
+    LUA_METHOD(ApplyCommands);
 
     LUA_METHOD(Refresh);
     LUA_METHOD(Erase);
+
+    lua_tinker::set(L, "LAYOUT_MOVE_IMAGE", static_cast<int>(LAYOUT_MOVE_IMAGE));
+    lua_tinker::set(L, "LAYOUT_SHOW_IMAGE", static_cast<int>(LAYOUT_SHOW_IMAGE));
+    lua_tinker::set(L, "LAYOUT_HIDE_IMAGE", static_cast<int>(LAYOUT_HIDE_IMAGE));
+    lua_tinker::set(L, "LAYOUT_MOVE_TEXT", static_cast<int>(LAYOUT_MOVE_TEXT));
+    lua_tinker::set(L, "LAYOUT_SHOW_TEXT", static_cast<int>(LAYOUT_SHOW_TEXT));
+    lua_tinker::set(L, "LAYOUT_HIDE_TEXT", static_cast<int>(LAYOUT_HIDE_TEXT));
 }
 
 CLayoutControl::CLayoutControl()
@@ -67,6 +103,15 @@ CLayoutControl::~CLayoutControl()
         DeleteDC(imageInfo.mirrorDC);
     }
     DeleteDC(_dc);
+
+    if (_alphaDC != nullptr)
+    {
+        if (_alphaBitmap != nullptr)
+        {
+            DeleteBitmap(SelectBitmap(_alphaDC, _oldAlphaBitmap));
+        }
+        DeleteDC(_alphaDC);
+    }
 }
 
 int CLayoutControl::GetX() const
@@ -94,122 +139,34 @@ bool CLayoutControl::IsHide() const
     return _isHide;
 }
 
-void CLayoutControl::SetX(int x, bool isRedraw)
+bool CLayoutControl::IsOpaque() const
 {
-    if (_position.x != x)
-    {
-        if (isRedraw)
-        {
-            if (!_parents.empty())
-            {
-                for (auto &parent : _parents)
-                {
-                    int width = _size.cx;
-                    int height = _size.cy;
-                    if (width == 0)
-                    {
-                        width = parent->GetWidth();
-                    }
-                    if (height == 0)
-                    {
-                        height = parent->GetHeight();
-                    }
-
-                    RECT rect;
-                    SetRect(&rect, _position.x, _position.y, _position.x + int(width * _ratioX),
-                            _position.y + int(height * _ratioY));
-                    _refreshRect.push_back(rect);
-                }
-            }
+    return _isOpaque;
+}
 
-            _position.x = x;
+int CLayoutControl::GetAlpha() const
+{
+    return _alpha;
+}
 
-            if (!_parents.empty())
-            {
-                for (auto &parent : _parents)
-                {
-                    int width = _size.cx;
-                    int height = _size.cy;
-                    if (width == 0)
-                    {
-                        width = parent->GetWidth();
-                    }
-                    if (height == 0)
-                    {
-                        height = parent->GetHeight();
-                    }
+int CLayoutControl::GetImageCount() const
+{
+    return int(_images.size());
+}
 
-                    RECT rect;
-                    SetRect(&rect, _position.x, _position.y, _position.x + int(width * _ratioX),
-                            _position.y + int(height * _ratioY));
-                    _refreshRect.push_back(rect);
-                }
-            }
-        }
-        else
-        {
-            _position.x = x;
-        }
-    }
+void CLayoutControl::SetX(int x, bool isRedraw)
+{
+    _MoveTo(x, _position.y, isRedraw);
 }
 
 void CLayoutControl::SetY(int y, bool isRedraw)
 {
-    if (_position.y != y)
-    {
-        if (isRedraw)
-        {
-            if (!_parents.empty())
-            {
-                for (auto &parent : _parents)
-                {
-                    int width = _size.cx;
-                    int height = _size.cy;
-                    if (width == 0)
-                    {
-                        width = parent->GetWidth();
-                    }
-                    if (height == 0)
-                    {
-                        height = parent->GetHeight();
-                    }
-
-                    RECT rect;
-                    SetRect(&rect, _position.x, _position.y, _position.x + int(width * _ratioX),
-                            _position.y + int(height * _ratioY));
-                    _refreshRect.push_back(rect);
-                }
-            }
-
-            _position.y = y;
-
-            if (!_parents.empty())
-            {
-                for (auto &parent : _parents)
-                {
-                    int width = _size.cx;
-                    int height = _size.cy;
-                    if (width == 0)
-                    {
-                        width = parent->GetWidth();
-                    }
-                    if (height == 0)
-                    {
-                        height = parent->GetHeight();
-                    }
+    _MoveTo(_position.x, y, isRedraw);
+}
 
-                    RECT rect;
-                    SetRect(&rect, _position.x, _position.y, _position.x + int(width * _ratioX),
-                            _position.y + int(height * _ratioY));
-                    _refreshRect.push_back(rect);
-                }
-            }
-        }
-        else
-        {
-            _position.y = y;
-        }
-    }
+void CLayoutControl::SetPosition(int x, int y, bool isRedraw)
+{
+    _MoveTo(x, y, isRedraw);
 }
 
 void CLayoutControl::SetWidth(int cx, bool isRedraw)
@@ -261,6 +218,7 @@ void CLayoutControl::SetWidth(int cx, bool isRedraw)
                     SetRect(&rect, _position.x, _position.y, _position.x + int(width * _ratioX),
                             _position.y + int(height * _ratioY));
                     _refreshRect.push_back(rect);
+                    _MarkDirty();
                 }
             }
         }
@@ -318,6 +276,7 @@ void CLayoutControl::SetHeight(int cy, bool isRedraw)
                 SetRect(&rect, _position.x, _position.y, _position.x + int(width * _ratioX),
                         _position.y + int(height * _ratioY));
                 _refreshRect.push_back(rect);
+                _MarkDirty();
             }
         }
     }
@@ -374,6 +333,7 @@ void CLayoutControl::SetRatioX(double ratio, bool isRedraw)
                 SetRect(&rect, _position.x, _position.y, _position.x + int(width * _ratioX),
                         _position.y + int(height * _ratioY));
                 _refreshRect.push_back(rect);
+                _MarkDirty();
             }
         }
     }
@@ -430,6 +390,7 @@ void CLayoutControl::SetRatioY(double ratio, bool isRedraw)
                 SetRect(&rect, _position.x, _position.y, _position.x + int(width * _ratioX),
                         _position.y + int(height * _ratioY));
                 _refreshRect.push_back(rect);
+                _MarkDirty();
             }
         }
     }
@@ -445,9 +406,46 @@ void CLayoutControl::SetHide(bool value)
     this->Refresh();
 }
 
+void CLayoutControl::SetOpaque(bool value)
+{
+    _isOpaque = value;
+}
+
+void CLayoutControl::SetAlpha(int alpha)
+{
+    alpha = alpha < 0 ? 0 : (alpha > 255 ? 255 : alpha);
+    if (_alpha != alpha)
+    {
+        _alpha = alpha;
+
+        for (auto &parent : _parents)
+        {
+            int width = _size.cx;
+            int height = _size.cy;
+            if (width == 0)
+            {
+                width = parent->GetWidth();
+            }
+            if (height == 0)
+            {
+                height = parent->GetHeight();
+            }
+
+            RECT rect;
+            SetRect(&rect, _position.x, _position.y, _position.x + int(width * _ratioX),
+                    _position.y + int(height * _ratioY));
+            _refreshRect.push_back(rect);
+            _MarkDirty();
+        }
+    }
+}
+
 void CLayoutControl::AddParentWindow(CWindowControl *parent)
 {
     _parents.push_back(parent);
+
+    // 부모가 없는 동안 쌓인 갱신 영역을 내보내야 한다.
+    _MarkDirty();
 }
 
 void CLayoutControl::RemoveParentWIndow(CWindowControl *parent)
@@ -507,8 +505,16 @@ int CLayoutControl::AddImage(CImageControl *image, int x, int y, bool isShow)
     imageInfo.position.y = y;
     imageInfo.isHide = !isShow;
     imageInfo.isRefresh = true;
+    imageInfo.isOccluded = false;
+    imageInfo.alpha = 255;
+    imageInfo.brightness = 100;
+    imageInfo.tintColor = RGB(0, 0, 0);
+    imageInfo.tintAmount = 0;
+    imageInfo.lookup = nullptr;
 
     _images.push_back(imageInfo);
+    _MarkDirty();
+    _isImageLookupDirty = true;
 
     return index;
 }
@@ -528,6 +534,7 @@ void CLayoutControl::DeleteImage(int index, bool isUpdate)
             DeleteDC(iter->imageDC);
             _reusingImageIndex.push(iter->index);
             iter = _images.erase(iter);
+            _isImageLookupDirty = true;
 
             int imageX = int(position.x * _ratioX) + _position.x;
             int imageY = int(position.y * _ratioY) + _position.y;
@@ -535,6 +542,7 @@ void CLayoutControl::DeleteImage(int index, bool isUpdate)
             SetRect(&rect, imageX, imageY, imageX + int(image->GetWidth() * _ratioX),
                     imageY + int(image->GetHeight() * _ratioY));
             _refreshRect.push_back(rect);
+            _MarkDirty();
 
             break;
         }
@@ -544,58 +552,32 @@ void CLayoutControl::DeleteImage(int index, bool isUpdate)
 
 void CLayoutControl::MoveImage(int index, int x, int y, bool isUpdate)
 {
-    auto iter = std::begin(_images);
-
-    while (iter != std::end(_images))
+    auto image = _FindImage(index);
+    if (image != nullptr)
     {
-        if (iter->index == index)
-        {
-            RECT rect;
-            int imageX = int(iter->position.x * _ratioX) + _position.x;
-            int imageY = int(iter->position.y * _ratioY) + _position.y;
-            SetRect(&rect, imageX, imageY, imageX + int(iter->image->GetWidth() * _ratioX),
-                    imageY + int(iter->image->GetHeight() * _ratioY));
-            _refreshRect.push_back(rect);
-
-            iter->position.x = x;
-            iter->position.y = y;
-
-            iter->isRefresh = true;
-            break;
-        }
-        ++iter;
+        _MoveImage(*image, x, y);
     }
 }
 
 void CLayoutControl::HideImage(int index, bool isUpdate)
 {
-    auto iter = std::begin(_images);
-
-    while (iter != std::end(_images))
+    auto image = _FindImage(index);
+    if (image != nullptr)
     {
-        if (iter->index == index)
-        {
-            iter->isHide = true;
-            iter->isRefresh = true;
-            break;
-        }
-        ++iter;
+        image->isHide = true;
+        image->isRefresh = true;
+        _MarkDirty();
     }
 }
 
 void CLayoutControl::ShowImage(int index, bool isUpdate)
 {
-    auto iter = std::begin(_images);
-
-    while (iter != std::end(_images))
+    auto image = _FindImage(index);
+    if (image != nullptr)
     {
-        if (iter->index == index)
-        {
-            iter->isHide = false;
-            iter->isRefresh = true;
-            break;
-        }
-        ++iter;
+        image->isHide = false;
+        image->isRefresh = true;
+        _MarkDirty();
     }
 }
 
@@ -609,8 +591,10 @@ int CLayoutControl::AddText(CGraphicText *text, int x, int y, bool isShow)
     textInformation.position.y = y;
     textInformation.isHide = !isShow;
     textInformation.isRefresh = true;
+    textInformation.isOccluded = false;
 
     _texts.push_back(textInformation);
+    _MarkDirty();
 
     return index;
 }
@@ -637,10 +621,10 @@ void CLayoutControl::DeleteText(int index, bool isUpdate)
                     int textY = int(position.y * _ratioY) + _position.y;
                     RECT rect;
 
-                    HDC hdc = GetDC(parent->GetHWnd());
-                    SetRect(&rect, textX, textY, textX + int(text->GetWidth(hdc) * _ratioX),
-                            textY + int(text->GetHeight(hdc) * _ratioY));
+                    SetRect(&rect, textX, textY, textX + int(text->GetWidth() * _ratioX),
+                            textY + int(text->GetHeight() * _ratioY));
                     _refreshRect.push_back(rect);
+                    _MarkDirty();
                 }
             }
 
@@ -652,85 +636,303 @@ void CLayoutControl::DeleteText(int index, bool isUpdate)
 
 void CLayoutControl::MoveText(int index, int x, int y, bool isUpdate)
 {
-    auto iter = std::begin(_texts);
+    auto text = _FindText(index);
+    if (text != nullptr)
+    {
+        _MoveText(*text, x, y);
+    }
+}
 
-    while (iter != std::end(_texts))
+void CLayoutControl::HideText(int index, bool isUpdate)
+{
+    auto text = _FindText(index);
+    if (text != nullptr)
     {
-        if (iter->index == index)
-        {
-            if (!_parents.empty())
-            {
-                for (auto &parent : _parents)
-                {
-                    int textX = int(iter->position.x * _ratioX) + _position.x;
-                    int textY = int(iter->position.y * _ratioY) + _position.y;
-                    RECT rect;
+        text->isHide = true;
+        text->isRefresh = true;
+        _MarkDirty();
+    }
+}
 
-                    HDC hdc = GetDC(parent->GetHWnd());
-                    SetRect(&rect, textX, textY, textX + int(iter->text->GetWidth(hdc) * _ratioX),
-                            textY + int(iter->text->GetHeight(hdc) * _ratioY));
-                    _refreshRect.push_back(rect);
-                    ReleaseDC(parent->GetHWnd(), hdc);
-                }
-            }
+void CLayoutControl::ShowText(int index, bool isUpdate)
+{
+    auto text = _FindText(index);
+    if (text != nullptr)
+    {
+        text->isHide = false;
+        text->isRefresh = true;
+        _MarkDirty();
+    }
+}
 
-            iter->position.x = x;
-            iter->position.y = y;
-            iter->isRefresh = true;
-            break;
-        }
-        ++iter;
+int CLayoutControl::GetImageX(int index)
+{
+    auto image = _FindImage(index);
+    return image != nullptr ? image->position.x : 0;
+}
+
+int CLayoutControl::GetImageY(int index)
+{
+    auto image = _FindImage(index);
+    return image != nullptr ? image->position.y : 0;
+}
+
+int CLayoutControl::GetImageAlpha(int index)
+{
+    auto image = _FindImage(index);
+    return image != nullptr ? image->alpha : 0;
+}
+
+void CLayoutControl::SetImageAlpha(int index, int alpha)
+{
+    auto image = _FindImage(index);
+    alpha = alpha < 0 ? 0 : (alpha > 255 ? 255 : alpha);
+    if (image != nullptr && image->alpha != alpha)
+    {
+        image->alpha = BYTE(alpha);
+        image->isRefresh = true;
+        _MarkDirty();
     }
 }
 
-void CLayoutControl::HideText(int index, bool isUpdate)
+int CLayoutControl::GetImageBrightness(int index)
 {
-    auto iter = std::begin(_texts);
+    auto image = _FindImage(index);
+    return image != nullptr ? image->brightness : 100;
+}
 
-    while (iter != std::end(_texts))
+COLORREF CLayoutControl::GetImageTintColor(int index)
+{
+    auto image = _FindImage(index);
+    return image != nullptr ? image->tintColor : RGB(0, 0, 0);
+}
+
+int CLayoutControl::GetImageTintAmount(int index)
+{
+    auto image = _FindImage(index);
+    return image != nullptr ? image->tintAmount : 0;
+}
+
+void CLayoutControl::SetImageBrightness(int index, int brightness)
+{
+    auto image = _FindImage(index);
+    brightness = brightness < 0 ? 0 : brightness;
+    if (image != nullptr && image->brightness != brightness)
     {
-        if (iter->index == index)
-        {
-            iter->isHide = true;
-            iter->isRefresh = true;
-            break;
-        }
-        ++iter;
+        image->brightness = brightness;
+        image->lookup = _GetPixelLookup(image->brightness, image->tintColor, image->tintAmount);
+        image->isRefresh = true;
+        _MarkDirty();
     }
 }
 
-void CLayoutControl::ShowText(int index, bool isUpdate)
+void CLayoutControl::SetImageTint(int index, COLORREF color, int amount)
 {
-    auto iter = std::begin(_texts);
+    auto image = _FindImage(index);
+    amount = amount < 0 ? 0 : (amount > 255 ? 255 : amount);
+    if (image != nullptr && (image->tintColor != color || image->tintAmount != amount))
+    {
+        image->tintColor = color;
+        image->tintAmount = BYTE(amount);
+        image->lookup = _GetPixelLookup(image->brightness, image->tintColor, image->tintAmount);
+        image->isRefresh = true;
+        _MarkDirty();
+    }
+}
 
-    while (iter != std::end(_texts))
+int CLayoutControl::GetTextX(int index)
+{
+    auto text = _FindText(index);
+    return text != nullptr ? text->position.x : 0;
+}
+
+int CLayoutControl::GetTextY(int index)
+{
+    auto text = _FindText(index);
+    return text != nullptr ? text->position.y : 0;
+}
+
+int CLayoutControl::MoveImages(lua_State *L)
+{
+    luaL_checktype(L, 2, LUA_TTABLE);
+
+    auto length = static_cast<int>(lua_rawlen(L, 2));
+    for (int i = 1; i + 2 <= length; i += 3)
     {
-        if (iter->index == index)
+        lua_rawgeti(L, 2, i);
+        lua_rawgeti(L, 2, i + 1);
+        lua_rawgeti(L, 2, i + 2);
+        int index = static_cast<int>(lua_tointeger(L, -3));
+        int x = static_cast<int>(lua_tointeger(L, -2));
+        int y = static_cast<int>(lua_tointeger(L, -1));
+        lua_pop(L, 3);
+
+        auto image = _FindImage(index);
+        if (image != nullptr)
         {
-            iter->isHide = false;
-            iter->isRefresh = true;
-            break;
+            _MoveImage(*image, x, y);
         }
-        ++iter;
     }
+
+    return 0;
 }
 
-void CLayoutControl::Draw(HDC destDC)
+int CLayoutControl::SetImagesVisible(lua_State *L)
 {
-    if (!_isHide)
+    luaL_checktype(L, 2, LUA_TTABLE);
+
+    // 세번째 인자가 테이블이면 핸들마다 따로, boolean 이면 전부 같은 값으로 설정한다.
+    bool isFlagTable = lua_istable(L, 3);
+    bool isVisible = lua_toboolean(L, 3) != 0;
+
+    auto length = static_cast<int>(lua_rawlen(L, 2));
+    for (int i = 1; i <= length; ++i)
     {
-        for (ImageInformation image : _images)
+        lua_rawgeti(L, 2, i);
+        int index = static_cast<int>(lua_tointeger(L, -1));
+        lua_pop(L, 1);
+
+        if (isFlagTable)
         {
-            if (!image.isHide)
-            {
-                HDC imageDC = image.image->IsDisplayMirror() ? image.mirrorDC : image.imageDC;
+            lua_rawgeti(L, 3, i);
+            isVisible = lua_toboolean(L, -1) != 0;
+            lua_pop(L, 1);
+        }
 
-                int imageX = int(image.position.x * _ratioX) + _position.x;
-                int imageY = int(image.position.y * +_ratioY) + _position.y;
-                int imageWidth = int(image.image->GetClipingWidth() * _ratioX);
-                int imageHeight = int(image.image->GetClipingHeight() * _ratioY);
+        auto image = _FindImage(index);
+        if (image != nullptr && image->isHide == isVisible)
+        {
+            image->isHide = !isVisible;
+            image->isRefresh = true;
+            _MarkDirty();
+        }
+    }
 
-                if (_ratioX == 1.0 && _ratioY == 1.0)
+    return 0;
+}
+
+// 명령 하나가 표에서 차지하는 칸 수. 모르는 명령이면 0 이다.
+static int GetLayoutCommandSize(int type)
+{
+    switch (type)
+    {
+    case LAYOUT_MOVE_IMAGE:
+    case LAYOUT_MOVE_TEXT:
+        return 4;
+    case LAYOUT_SHOW_IMAGE:
+    case LAYOUT_HIDE_IMAGE:
+    case LAYOUT_SHOW_TEXT:
+    case LAYOUT_HIDE_TEXT:
+        return 2;
+    default:
+        return 0;
+    }
+}
+
+int CLayoutControl::QueueCommands(lua_State *L)
+{
+    luaL_checktype(L, 2, LUA_TTABLE);
+
+    auto length = static_cast<int>(lua_rawlen(L, 2));
+
+    // 중간에 잘못된 명령이 있으면 앞의 명령도 넣지 않도록 표 전체를 먼저 확인한다.
+    int commandCount = 0;
+    for (int i = 1; i <= length;)
+    {
+        lua_rawgeti(L, 2, i);
+        int type = static_cast<int>(lua_tointeger(L, -1));
+        lua_pop(L, 1);
+
+        int size = GetLayoutCommandSize(type);
+        if (size == 0)
+        {
+            return luaL_error(L, "unknown layout command %d at %d", type, i);
+        }
+
+        i += size;
+        ++commandCount;
+    }
+
+    _commands.reserve(_commands.size() + commandCount);
+    for (int i = 1; i <= length;)
+    {
+        LayoutCommand command{};
+
+        lua_rawgeti(L, 2, i);
+        lua_rawgeti(L, 2, i + 1);
+        command.type = static_cast<int>(lua_tointeger(L, -2));
+        command.index = static_cast<int>(lua_tointeger(L, -1));
+        lua_pop(L, 2);
+
+        if (command.type == LAYOUT_MOVE_IMAGE || command.type == LAYOUT_MOVE_TEXT)
+        {
+            lua_rawgeti(L, 2, i + 2);
+            lua_rawgeti(L, 2, i + 3);
+            command.x = static_cast<int>(lua_tointeger(L, -2));
+            command.y = static_cast<int>(lua_tointeger(L, -1));
+            lua_pop(L, 2);
+        }
+
+        i += GetLayoutCommandSize(command.type);
+        _commands.push_back(command);
+    }
+
+    if (commandCount > 0)
+    {
+        _MarkDirty();
+    }
+
+    return 0;
+}
+
+void CLayoutControl::ApplyCommands()
+{
+    for (auto &command : _commands)
+    {
+        switch (command.type)
+        {
+        case LAYOUT_MOVE_IMAGE:
+            MoveImage(command.index, command.x, command.y, false);
+            break;
+        case LAYOUT_SHOW_IMAGE:
+            ShowImage(command.index, false);
+            break;
+        case LAYOUT_HIDE_IMAGE:
+            HideImage(command.index, false);
+            break;
+        case LAYOUT_MOVE_TEXT:
+            MoveText(command.index, command.x, command.y, false);
+            break;
+        case LAYOUT_SHOW_TEXT:
+            ShowText(command.index, false);
+            break;
+        case LAYOUT_HIDE_TEXT:
+            HideText(command.index, false);
+            break;
+        }
+    }
+
+    _commands.clear();
+}
+
+void CLayoutControl::Draw(HDC destDC)
+{
+    PROFILE_ZONE("Layout Draw");
+
+    if (!_isHide)
+    {
+        for (ImageInformation image : _images)
+        {
+            if (!image.isHide)
+            {
+                HDC imageDC = image.image->IsDisplayMirror() ? image.mirrorDC : image.imageDC;
+
+                int imageX = int(image.position.x * _ratioX) + _position.x;
+                int imageY = int(image.position.y * +_ratioY) + _position.y;
+                int imageWidth = int(image.image->GetClipingWidth() * _ratioX);
+                int imageHeight = int(image.image->GetClipingHeight() * _ratioY);
+
+                if (_ratioX == 1.0 && _ratioY == 1.0)
                 {
                     if (imageX + imageWidth > _size.cx)
                     {
@@ -741,6 +943,13 @@ void CLayoutControl::Draw(HDC destDC)
                         imageHeight = _size.cy - imageY;
                     }
 
+                    RECT imageRect;
+                    SetRect(&imageRect, imageX, imageY, imageX + imageWidth, imageY + imageHeight);
+                    if (image.lookup != nullptr && _DrawImageWithLookup(destDC, image, imageRect, imageRect, 255))
+                    {
+                        continue;
+                    }
+
                     auto maskDC = CreateCompatibleDC(destDC);
                     HBITMAP maskBitmap = image.image->IsDisplayMirror()
                                              ? image.image->GetMaskMirrorImageHandle()
@@ -761,24 +970,13 @@ void CLayoutControl::Draw(HDC destDC)
                 }
                 else
                 {
-                    int originalImageWidth = imageWidth;
-                    int originalImageHeight = imageHeight;
-
-                    auto memDC = CreateCompatibleDC(destDC);
-                    auto memBitmap = CreateCompatibleBitmap(destDC, originalImageWidth, originalImageHeight);
-                    auto oldBitmap = SelectBitmap(memDC, memBitmap);
-
-                    auto maskBitmap = CreateBitmap(imageWidth, imageHeight, 1, 1, nullptr);
-                    auto maskDC = CreateCompatibleDC(destDC);
-                    auto oldMask = SelectBitmap(maskDC, maskBitmap);
-
-                    SetStretchBltMode(memDC, COLORONCOLOR);
-                    StretchBlt(memDC, 0, 0, imageWidth, imageHeight, imageDC, image.image->GetClipingLeft(),
-                               image.image->GetClipingTop(), image.image->GetClipingWidth(),
-                               image.image->GetClipingHeight(), SRCCOPY);
-
-                    auto oldColor = SetBkColor(memDC, image.image->GetMaskColor());
-                    BitBlt(maskDC, 0, 0, originalImageWidth, originalImageHeight, memDC, 0, 0, SRCCOPY);
+                    auto &scaledImageCache = CScaledImageCache::GetInstance();
+                    auto scaledImage = scaledImageCache.GetScaledImage(destDC, imageDC, image.image, _ratioX, _ratioY,
+                                                                       image.lookup);
+                    if (scaledImage == nullptr)
+                    {
+                        continue;
+                    }
 
                     if (imageX + imageWidth > _size.cx)
                     {
@@ -789,16 +987,7 @@ void CLayoutControl::Draw(HDC destDC)
                         imageHeight = _size.cy - imageY;
                     }
 
-                    BitBlt(destDC, imageX, imageY, imageWidth, imageHeight, memDC, 0, 0, SRCINVERT);
-                    BitBlt(destDC, imageX, imageY, imageWidth, imageHeight, maskDC, 0, 0, SRCAND);
-                    BitBlt(destDC, imageX, imageY, imageWidth, imageHeight, memDC, 0, 0, SRCINVERT);
-
-                    SetBkColor(memDC, oldColor);
-                    SelectBitmap(memDC, oldBitmap);
-                    DeleteBitmap(memBitmap);
-                    SelectBitmap(maskDC, oldMask);
-                    DeleteDC(memDC);
-                    DeleteDC(maskDC);
+                    scaledImageCache.Draw(destDC, scaledImage, imageX, imageY, imageWidth, imageHeight, 0, 0);
                 }
             }
         }
@@ -818,11 +1007,22 @@ void CLayoutControl::Draw(HDC destDC)
 
 void CLayoutControl::Draw(HDC destDC, RECT &clipingRect)
 {
+    Draw(destDC, clipingRect, POINT{0, 0}, SIZE{0, 0});
+}
+
+void CLayoutControl::Draw(HDC destDC, RECT &clipingRect, POINT offset, SIZE fitSize)
+{
+    PROFILE_ZONE("Layout Draw");
+
+    // 레이아웃 상태를 바꾸지 않고 offset 만큼 옮기고, 크기가 0 인 방향은 fitSize 로 맞춰 그린다.
+    POINT position{_position.x + offset.x, _position.y + offset.y};
+    SIZE size{_size.cx != 0 ? _size.cx : fitSize.cx, _size.cy != 0 ? _size.cy : fitSize.cy};
+
     if (!_isHide)
     {
         RECT realClipingRect;
         RECT layoutRect;
-        SetRect(&layoutRect, _position.x, _position.y, _position.x + _size.cx, _position.y + _size.cy);
+        SetRect(&layoutRect, position.x, position.y, position.x + size.cx, position.y + size.cy);
         if (!IntersectRect(&realClipingRect, &layoutRect, &clipingRect))
         {
             return;
@@ -830,24 +1030,25 @@ void CLayoutControl::Draw(HDC destDC, RECT &clipingRect)
 
         for (ImageInformation image : _images)
         {
-            if (!image.isHide)
+            BYTE alpha = BYTE(image.alpha * _alpha / 255);
+            if (!image.isHide && !image.isOccluded && alpha > 0)
             {
                 HDC imageDC = image.image->IsDisplayMirror() ? image.mirrorDC : image.imageDC;
 
-                int imageX = int(image.position.x * _ratioX) + _position.x;
-                int imageY = int(image.position.y * _ratioY) + _position.y;
+                int imageX = int(image.position.x * _ratioX) + position.x;
+                int imageY = int(image.position.y * _ratioY) + position.y;
                 int imageWidth = int(image.image->GetClipingWidth() * _ratioX);
                 int imageHeight = int(image.image->GetClipingHeight() * _ratioY);
 
                 if (_ratioX == 1.0 && _ratioY == 1.0)
                 {
-                    if (imageX + imageWidth > _size.cx)
+                    if (imageX + imageWidth > size.cx)
                     {
-                        imageWidth = _size.cx - imageX;
+                        imageWidth = size.cx - imageX;
                     }
-                    if (imageY + imageHeight > _size.cy)
+                    if (imageY + imageHeight > size.cy)
                     {
-                        imageHeight = _size.cy - imageY;
+                        imageHeight = size.cy - imageY;
                     }
 
                     RECT imageRect;
@@ -858,6 +1059,14 @@ void CLayoutControl::Draw(HDC destDC, RECT &clipingRect)
                         continue;
                     }
 
+                    if (image.lookup != nullptr &&
+                        _DrawImageWithLookup(destDC, image, realDrawRect, imageRect, alpha))
+                    {
+                        continue;
+                    }
+
+                    HDC drawDC = alpha < 255 ? _BeginAlphaDraw(destDC, realDrawRect) : destDC;
+
                     auto maskDC = CreateCompatibleDC(destDC);
                     HBITMAP maskBitmap = image.image->IsDisplayMirror()
                                              ? image.image->GetMaskMirrorImageHandle()
@@ -865,15 +1074,15 @@ void CLayoutControl::Draw(HDC destDC, RECT &clipingRect)
                     auto oldMask = SelectBitmap(maskDC, maskBitmap);
                     auto oldColor = SetBkColor(imageDC, image.image->GetMaskColor());
 
-                    BitBlt(destDC, realDrawRect.left, realDrawRect.top, realDrawRect.right - realDrawRect.left,
+                    BitBlt(drawDC, realDrawRect.left, realDrawRect.top, realDrawRect.right - realDrawRect.left,
                            realDrawRect.bottom - realDrawRect.top, imageDC,
                            realDrawRect.left - imageRect.left + image.image->GetClipingLeft(),
                            realDrawRect.top - imageRect.top + image.image->GetClipingTop(), SRCINVERT);
-                    BitBlt(destDC, realDrawRect.left, realDrawRect.top, realDrawRect.right - realDrawRect.left,
+                    BitBlt(drawDC, realDrawRect.left, realDrawRect.top, realDrawRect.right - realDrawRect.left,
                            realDrawRect.bottom - realDrawRect.top, maskDC,
                            realDrawRect.left - imageRect.left + image.image->GetClipingLeft(),
                            realDrawRect.top - imageRect.top + image.image->GetClipingTop(), SRCAND);
-                    BitBlt(destDC, realDrawRect.left, realDrawRect.top, realDrawRect.right - realDrawRect.left,
+                    BitBlt(drawDC, realDrawRect.left, realDrawRect.top, realDrawRect.right - realDrawRect.left,
                            realDrawRect.bottom - realDrawRect.top, imageDC,
                            realDrawRect.left - imageRect.left + image.image->GetClipingLeft(),
                            realDrawRect.top - imageRect.top + image.image->GetClipingTop(), SRCINVERT);
@@ -881,19 +1090,21 @@ void CLayoutControl::Draw(HDC destDC, RECT &clipingRect)
                     SetBkColor(imageDC, oldColor);
                     SelectBitmap(maskDC, oldMask);
                     DeleteDC(maskDC);
+
+                    if (drawDC != destDC)
+                    {
+                        _EndAlphaDraw(destDC, realDrawRect, alpha);
+                    }
                 }
                 else
                 {
-                    int originalImageWidth = imageWidth;
-                    int originalImageHeight = imageHeight;
-
-                    if (imageX + imageWidth > _size.cx)
+                    if (imageX + imageWidth > size.cx)
                     {
-                        imageWidth = _size.cx - imageX;
+                        imageWidth = size.cx - imageX;
                     }
-                    if (imageY + imageHeight > _size.cy)
+                    if (imageY + imageHeight > size.cy)
                     {
-                        imageHeight = _size.cy - imageY;
+                        imageHeight = size.cy - imageY;
                     }
 
                     RECT imageRect;
@@ -904,50 +1115,34 @@ void CLayoutControl::Draw(HDC destDC, RECT &clipingRect)
                         continue;
                     }
 
-                    auto memDC = CreateCompatibleDC(destDC);
-                    auto memBitmap = CreateCompatibleBitmap(destDC, originalImageWidth, originalImageHeight);
-                    auto oldBitmap = SelectBitmap(memDC, memBitmap);
-
-                    auto maskBitmap = CreateBitmap(imageWidth, imageHeight, 1, 1, nullptr);
-                    auto maskDC = CreateCompatibleDC(destDC);
-                    auto oldMask = SelectBitmap(maskDC, maskBitmap);
-
-                    SetStretchBltMode(memDC, COLORONCOLOR);
-                    StretchBlt(memDC, 0, 0, originalImageWidth, originalImageHeight, imageDC,
-                               image.image->GetClipingLeft(), image.image->GetClipingTop(),
-                               image.image->GetClipingWidth(),
-                               image.image->GetClipingHeight(), SRCCOPY);
+                    auto &scaledImageCache = CScaledImageCache::GetInstance();
+                    auto scaledImage = scaledImageCache.GetScaledImage(destDC, imageDC, image.image, _ratioX, _ratioY,
+                                                                       image.lookup);
+                    if (scaledImage == nullptr)
+                    {
+                        continue;
+                    }
 
-                    auto oldColor = SetBkColor(memDC, image.image->GetMaskColor());
-                    BitBlt(maskDC, 0, 0, originalImageWidth, originalImageHeight, memDC, 0, 0, SRCCOPY);
+                    HDC drawDC = alpha < 255 ? _BeginAlphaDraw(destDC, realDrawRect) : destDC;
 
-                    BitBlt(destDC, realDrawRect.left, realDrawRect.top, realDrawRect.right - realDrawRect.left,
-                           realDrawRect.bottom - realDrawRect.top, memDC, realDrawRect.left - imageRect.left,
-                           realDrawRect.top - imageRect.top, SRCINVERT);
-                    BitBlt(destDC, realDrawRect.left, realDrawRect.top, realDrawRect.right - realDrawRect.left,
-                           realDrawRect.bottom - realDrawRect.top, maskDC, realDrawRect.left - imageRect.left,
-                           realDrawRect.top - imageRect.top, SRCAND);
-                    BitBlt(destDC, realDrawRect.left, realDrawRect.top, realDrawRect.right - realDrawRect.left,
-                           realDrawRect.bottom - realDrawRect.top, memDC, realDrawRect.left - imageRect.left,
-                           realDrawRect.top - imageRect.top, SRCINVERT);
+                    scaledImageCache.Draw(drawDC, scaledImage, realDrawRect.left, realDrawRect.top,
+                                          realDrawRect.right - realDrawRect.left, realDrawRect.bottom - realDrawRect.top,
+                                          realDrawRect.left - imageRect.left, realDrawRect.top - imageRect.top);
 
-                    SetBkColor(memDC, oldColor);
-                    SelectBitmap(maskDC, oldMask);
-                    SelectBitmap(memDC, oldBitmap);
-                    DeleteBitmap(memBitmap);
-                    DeleteBitmap(maskBitmap);
-                    DeleteDC(memDC);
-                    DeleteDC(maskDC);
+                    if (drawDC != destDC)
+                    {
+                        _EndAlphaDraw(destDC, realDrawRect, alpha);
+                    }
                 }
             }
         }
 
         for (TextInformation text : _texts)
         {
-            if (!text.isHide)
+            if (!text.isHide && !text.isOccluded && _alpha > 0)
             {
-                int textX = int(text.position.x * _ratioX) + _position.x;
-                int textY = int(text.position.y * _ratioY) + _position.y;
+                int textX = int(text.position.x * _ratioX) + position.x;
+                int textY = int(text.position.y * _ratioY) + position.y;
                 int textWidth = int(text.text->GetWidth(destDC) * _ratioX);
                 int textHeight = int(text.text->GetHeight(destDC) * _ratioY);
 
@@ -959,7 +1154,16 @@ void CLayoutControl::Draw(HDC destDC, RECT &clipingRect)
                     continue;
                 }
 
-                text.text->Draw(destDC, POINT{textX, textY});
+                if (_alpha < 255)
+                {
+                    HDC alphaDC = _BeginAlphaDraw(destDC, realDrawRect);
+                    text.text->Draw(alphaDC, POINT{textX, textY});
+                    _EndAlphaDraw(destDC, realDrawRect, BYTE(_alpha));
+                }
+                else
+                {
+                    text.text->Draw(destDC, POINT{textX, textY});
+                }
             }
         }
     }
@@ -967,11 +1171,21 @@ void CLayoutControl::Draw(HDC destDC, RECT &clipingRect)
 
 void CLayoutControl::Draw(HDC destDC, RECT &clipingRect, COLORREF mixedColor)
 {
+    Draw(destDC, clipingRect, mixedColor, POINT{0, 0}, SIZE{0, 0});
+}
+
+void CLayoutControl::Draw(HDC destDC, RECT &clipingRect, COLORREF mixedColor, POINT offset, SIZE fitSize)
+{
+    PROFILE_ZONE("Layout Draw");
+
+    POINT position{_position.x + offset.x, _position.y + offset.y};
+    SIZE size{_size.cx != 0 ? _size.cx : fitSize.cx, _size.cy != 0 ? _size.cy : fitSize.cy};
+
     if (!_isHide)
     {
         RECT realClipingRect;
         RECT layoutRect;
-        SetRect(&layoutRect, _position.x, _position.y, _position.x + _size.cx, _position.y + _size.cy);
+        SetRect(&layoutRect, position.x, position.y, position.x + size.cx, position.y + size.cy);
         if (!IntersectRect(&realClipingRect, &layoutRect, &clipingRect))
         {
             return;
@@ -983,8 +1197,8 @@ void CLayoutControl::Draw(HDC destDC, RECT &clipingRect, COLORREF mixedColor)
             {
                 HDC imageDC = image.image->IsDisplayMirror() ? image.mirrorDC : image.imageDC;
 
-                int imageX = int(image.position.x * _ratioX) + _position.x;
-                int imageY = int(image.position.y * +_ratioY) + _position.y;
+                int imageX = int(image.position.x * _ratioX) + position.x;
+                int imageY = int(image.position.y * +_ratioY) + position.y;
                 auto width = image.image->GetClipingWidth();
                 int height = image.image->GetClipingHeight();
                 int imageWidth = int(width * _ratioX);
@@ -992,13 +1206,13 @@ void CLayoutControl::Draw(HDC destDC, RECT &clipingRect, COLORREF mixedColor)
 
                 if (_ratioX == 1.0 && _ratioY == 1.0)
                 {
-                    if (imageX + imageWidth > _size.cx)
+                    if (imageX + imageWidth > size.cx)
                     {
-                        imageWidth = _size.cx - imageX;
+                        imageWidth = size.cx - imageX;
                     }
-                    if (imageY + imageHeight > _size.cy)
+                    if (imageY + imageHeight > size.cy)
                     {
-                        imageHeight = _size.cy - imageY;
+                        imageHeight = size.cy - imageY;
                     }
 
                     RECT imageRect;
@@ -1085,13 +1299,13 @@ void CLayoutControl::Draw(HDC destDC, RECT &clipingRect, COLORREF mixedColor)
                     int originalImageWidth = imageWidth;
                     int originalImageHeight = imageHeight;
 
-                    if (imageX + imageWidth > _size.cx)
+                    if (imageX + imageWidth > size.cx)
                     {
-                        imageWidth = _size.cx - imageX;
+                        imageWidth = size.cx - imageX;
                     }
-                    if (imageY + imageHeight > _size.cy)
+                    if (imageY + imageHeight > size.cy)
                     {
-                        imageHeight = _size.cy - imageY;
+                        imageHeight = size.cy - imageY;
                     }
 
                     RECT imageRect;
@@ -1180,8 +1394,8 @@ void CLayoutControl::Draw(HDC destDC, RECT &clipingRect, COLORREF mixedColor)
         {
             if (!text.isHide)
             {
-                int textX = int(text.position.x * _ratioX) + _position.x;
-                int textY = int(text.position.y * _ratioY) + _position.y;
+                int textX = int(text.position.x * _ratioX) + position.x;
+                int textY = int(text.position.y * _ratioY) + position.y;
                 int textWidth = int(text.text->GetWidth(destDC) * _ratioX);
                 int textHeight = int(text.text->GetHeight(destDC) * _ratioY);
 
@@ -1215,6 +1429,7 @@ void CLayoutControl::Erase()
 
     _images.clear();
     _texts.clear();
+    _isImageLookupDirty = true;
     while (!_reusingImageIndex.empty())
     {
         _reusingImageIndex.pop();
@@ -1240,7 +1455,6 @@ void CLayoutControl::Erase()
             }
         }
 
-        HDC hdc = GetDC(parent->GetHWnd());
         for (TextInformation text : tempTexts)
         {
             if (!text.isHide)
@@ -1249,26 +1463,260 @@ void CLayoutControl::Erase()
                 int textY = int(text.position.y * _ratioY) + _position.y;
 
                 RECT rect;
-                SetRect(&rect, textX, textY, textX + int(text.text->GetWidth(hdc) * _ratioX),
-                        textY + int(text.text->GetHeight(hdc) * _ratioY));
+                SetRect(&rect, textX, textY, textX + int(text.text->GetWidth() * _ratioX),
+                        textY + int(text.text->GetHeight() * _ratioY));
                 InvalidateRect(parent->GetHWnd(), &rect, FALSE);
             }
         }
-        ReleaseDC(parent->GetHWnd(), hdc);
+    }
+}
+
+bool CLayoutControl::BuildRasterCommands(std::vector<RasterCommand> &commands, const RECT &clipingRect)
+{
+    // Draw 와 같은 위치 계산으로 명령을 만들고, 소프트웨어로 그릴 수 없으면 false 를 돌려준다.
+    if (_isHide)
+    {
+        return true;
+    }
+
+    RECT realClipingRect;
+    RECT layoutRect;
+    SetRect(&layoutRect, _position.x, _position.y, _position.x + _size.cx, _position.y + _size.cy);
+    if (!IntersectRect(&realClipingRect, &layoutRect, &clipingRect))
+    {
+        return true;
+    }
+
+    if (_ratioX != 1.0 || _ratioY != 1.0)
+    {
+        return false;
+    }
+
+    for (auto &image : _images)
+    {
+        BYTE alpha = BYTE(image.alpha * _alpha / 255);
+        if (image.isHide || image.isOccluded || alpha == 0)
+        {
+            continue;
+        }
+
+        int imageX = image.position.x + _position.x;
+        int imageY = image.position.y + _position.y;
+        int imageWidth = image.image->GetClipingWidth();
+        int imageHeight = image.image->GetClipingHeight();
+        if (imageX + imageWidth > _size.cx)
+        {
+            imageWidth = _size.cx - imageX;
+        }
+        if (imageY + imageHeight > _size.cy)
+        {
+            imageHeight = _size.cy - imageY;
+        }
+
+        RECT imageRect;
+        RECT realDrawRect;
+        SetRect(&imageRect, imageX, imageY, imageX + imageWidth, imageY + imageHeight);
+        if (!IntersectRect(&realDrawRect, &imageRect, &realClipingRect))
+        {
+            continue;
+        }
+
+        auto pixels = image.image->GetPixels(image.image->IsDisplayMirror() ? image.mirrorDC : image.imageDC);
+        if (pixels == nullptr)
+        {
+            return false;
+        }
+
+        RasterCommand command{};
+        command.type = RASTER_IMAGE;
+        command.bounds = FrameRect{realDrawRect.left, realDrawRect.top, realDrawRect.right, realDrawRect.bottom};
+        command.image = pixels;
+        command.sourceX = realDrawRect.left - imageRect.left + image.image->GetClipingLeft();
+        command.sourceY = realDrawRect.top - imageRect.top + image.image->GetClipingTop();
+        command.alpha = alpha;
+        command.lookup = image.lookup.get();
+        commands.push_back(std::move(command));
+    }
+
+    for (auto &text : _texts)
+    {
+        if (text.isHide || text.isOccluded || _alpha <= 0)
+        {
+            continue;
+        }
+
+        int textX = text.position.x + _position.x;
+        int textY = text.position.y + _position.y;
+
+        RECT textRect;
+        RECT realDrawRect;
+        SetRect(&textRect, textX, textY, textX + text.text->GetWidth(), textY + text.text->GetHeight());
+        if (!IntersectRect(&realDrawRect, &textRect, &realClipingRect))
+        {
+            continue;
+        }
+
+        auto atlas = text.text->GetGlyphAtlas();
+        if (atlas == nullptr)
+        {
+            return false;
+        }
+
+        // 글자 래스터화는 아틀라스를 바꾸므로 여기서 미리 해 두고 작업 스레드는 읽기만 한다.
+        auto textString = text.text->GetText();
+        atlas->MeasureString(textString);
+
+        COLORREF textColor = text.text->GetTextColor();
+        RasterCommand command{};
+        command.type = RASTER_TEXT;
+        command.bounds = FrameRect{realDrawRect.left, realDrawRect.top, realDrawRect.right, realDrawRect.bottom};
+        command.atlas = atlas;
+        command.text = std::move(textString);
+        command.x = textX;
+        command.y = textY;
+        command.color = (uint32_t(_alpha) << 24) | (GetRValue(textColor) << 16) | (GetGValue(textColor) << 8) |
+                        GetBValue(textColor);
+        commands.push_back(std::move(command));
+    }
+
+    return true;
+}
+
+void CLayoutControl::Cull(HDC destDC, HRGN coverage, RECT &clipingRect, LONGLONG &visibleArea, LONGLONG &drawnArea)
+{
+    if (_isHide)
+    {
+        return;
+    }
+
+    RECT realClipingRect;
+    RECT layoutRect;
+    SetRect(&layoutRect, _position.x, _position.y, _position.x + _size.cx, _position.y + _size.cy);
+    if (!IntersectRect(&realClipingRect, &layoutRect, &clipingRect))
+    {
+        return;
+    }
+
+    // 앞에 그려지는 것부터 거꾸로 보면서 이미 불투명한 영역에 완전히 가려진 것은 그리지 않는다.
+    auto isCovered = [coverage](RECT &rect) {
+        HRGN region = CreateRectRgnIndirect(&rect);
+        int result = CombineRgn(region, region, coverage, RGN_DIFF);
+        DeleteRgn(region);
+        return result == NULLREGION;
+    };
+
+    for (auto text = _texts.rbegin(); text != _texts.rend(); ++text)
+    {
+        if (text->isHide)
+        {
+            continue;
+        }
+
+        int textX = int(text->position.x * _ratioX) + _position.x;
+        int textY = int(text->position.y * _ratioY) + _position.y;
+        int textWidth = int(text->text->GetWidth(destDC) * _ratioX);
+        int textHeight = int(text->text->GetHeight(destDC) * _ratioY);
+
+        RECT textRect;
+        RECT realDrawRect;
+        SetRect(&textRect, textX, textY, textX + textWidth, textY + textHeight);
+        if (!IntersectRect(&realDrawRect, &textRect, &realClipingRect))
+        {
+            continue;
+        }
+
+        LONGLONG area = LONGLONG(realDrawRect.right - realDrawRect.left) * (realDrawRect.bottom - realDrawRect.top);
+        visibleArea += area;
+        text->isOccluded = isCovered(realDrawRect);
+        if (!text->isOccluded)
+        {
+            drawnArea += area;
+        }
+    }
+
+    for (auto image = _images.rbegin(); image != _images.rend(); ++image)
+    {
+        if (image->isHide)
+        {
+            continue;
+        }
+
+        int imageX = int(image->position.x * _ratioX) + _position.x;
+        int imageY = int(image->position.y * _ratioY) + _position.y;
+        int imageWidth = int(image->image->GetClipingWidth() * _ratioX);
+        int imageHeight = int(image->image->GetClipingHeight() * _ratioY);
+        if (imageX + imageWidth > _size.cx)
+        {
+            imageWidth = _size.cx - imageX;
+        }
+        if (imageY + imageHeight > _size.cy)
+        {
+            imageHeight = _size.cy - imageY;
+        }
+
+        RECT imageRect;
+        RECT realDrawRect;
+        SetRect(&imageRect, imageX, imageY, imageX + imageWidth, imageY + imageHeight);
+        if (!IntersectRect(&realDrawRect, &imageRect, &realClipingRect))
+        {
+            continue;
+        }
+
+        LONGLONG area = LONGLONG(realDrawRect.right - realDrawRect.left) * (realDrawRect.bottom - realDrawRect.top);
+        visibleArea += area;
+        image->isOccluded = isCovered(realDrawRect);
+        if (!image->isOccluded)
+        {
+            drawnArea += area;
+
+            if (image->image->IsOpaque() && image->alpha == 255 && _alpha == 255)
+            {
+                HRGN region = CreateRectRgnIndirect(&realDrawRect);
+                CombineRgn(coverage, coverage, region, RGN_OR);
+                DeleteRgn(region);
+            }
+        }
+    }
+
+    if (_isOpaque && _alpha == 255)
+    {
+        HRGN region = CreateRectRgnIndirect(&realClipingRect);
+        CombineRgn(coverage, coverage, region, RGN_OR);
+        DeleteRgn(region);
+    }
+}
+
+void CLayoutControl::ResetCulling()
+{
+    for (ImageInformation &image : _images)
+    {
+        image.isOccluded = false;
+    }
+    for (TextInformation &text : _texts)
+    {
+        text.isOccluded = false;
     }
 }
 
 void CLayoutControl::Refresh()
 {
+    PROFILE_ZONE("Layout Refresh");
+
+    // 그리는 도중에 바뀐 것은 다음 프레임에 다시 모이도록 먼저 내려 둔다.
+    _isDirty = false;
+
     bool update = false;
 
     if (!_parents.empty())
     {
         for (auto &parent : _parents)
         {
+            RECT updateRect{0, 0, 0, 0};
+
             for (RECT rect : _refreshRect)
             {
                 InvalidateRect(parent->GetHWnd(), &rect, FALSE);
+                UnionRect(&updateRect, &updateRect, &rect);
 
                 update = true;
             }
@@ -1289,6 +1737,7 @@ void CLayoutControl::Refresh()
                     SetRect(&rect, imageX, imageY, imageX + int(image.image->GetClipingWidth() * _ratioX),
                             imageY + int(image.image->GetClipingHeight() * _ratioY));
                     InvalidateRect(parent->GetHWnd(), &rect, FALSE);
+                    UnionRect(&updateRect, &updateRect, &rect);
 
                     image.isRefresh = false;
 
@@ -1296,7 +1745,6 @@ void CLayoutControl::Refresh()
                 }
             }
 
-            HDC hdc = GetDC(parent->GetHWnd());
             for (TextInformation &text : _texts)
             {
                 if (text.isRefresh)
@@ -1305,16 +1753,22 @@ void CLayoutControl::Refresh()
                     int textY = int(text.position.y * _ratioY) + _position.y;
 
                     RECT rect;
-                    SetRect(&rect, textX, textY, textX + int(text.text->GetWidth(hdc) * _ratioX),
-                            textY + int(text.text->GetHeight(hdc) * _ratioY));
+                    SetRect(&rect, textX, textY, textX + int(text.text->GetWidth() * _ratioX),
+                            textY + int(text.text->GetHeight() * _ratioY));
                     InvalidateRect(parent->GetHWnd(), &rect, FALSE);
+                    UnionRect(&updateRect, &updateRect, &rect);
 
                     text.isRefresh = false;
 
                     update = true;
                 }
             }
-            ReleaseDC(parent->GetHWnd(), hdc);
+
+            // 투명 배경 리스트뷰는 이 레이아웃을 행 이미지에 그려 두므로 겹치는 것만 지운다.
+            if (!IsRectEmpty(&updateRect))
+            {
+                CListViewControl::InvalidateTransparentRowImages(parent->GetHWnd(), updateRect);
+            }
 
             if (update)
             {
@@ -1324,6 +1778,15 @@ void CLayoutControl::Refresh()
     }
 }
 
+void CLayoutControl::_MarkDirty()
+{
+    if (!_isDirty)
+    {
+        _isDirty = true;
+        CControlManager::GetInstance().AddDirtyLayout(this);
+    }
+}
+
 int CLayoutControl::_GetNewImageIndex()
 {
     int index;
@@ -1341,6 +1804,281 @@ int CLayoutControl::_GetNewImageIndex()
     return index;
 }
 
+ImageInformation *CLayoutControl::_FindImage(int index)
+{
+    if (_isImageLookupDirty)
+    {
+        _imageLookup.assign(_images.size() + _reusingImageIndex.size(), -1);
+        for (size_t i = 0; i < _images.size(); ++i)
+        {
+            if (_images[i].index >= static_cast<int>(_imageLookup.size()))
+            {
+                _imageLookup.resize(_images[i].index + 1, -1);
+            }
+            _imageLookup[_images[i].index] = static_cast<int>(i);
+        }
+        _isImageLookupDirty = false;
+    }
+
+    if (index < 0 || index >= static_cast<int>(_imageLookup.size()) || _imageLookup[index] < 0)
+    {
+        return nullptr;
+    }
+
+    return &_images[_imageLookup[index]];
+}
+
+TextInformation *CLayoutControl::_FindText(int index)
+{
+    for (auto &text : _texts)
+    {
+        if (text.index == index)
+        {
+            return &text;
+        }
+    }
+
+    return nullptr;
+}
+
+void CLayoutControl::_MoveImage(ImageInformation &image, int x, int y)
+{
+    RECT rect;
+    int imageX = int(image.position.x * _ratioX) + _position.x;
+    int imageY = int(image.position.y * _ratioY) + _position.y;
+    SetRect(&rect, imageX, imageY, imageX + int(image.image->GetWidth() * _ratioX),
+            imageY + int(image.image->GetHeight() * _ratioY));
+    _refreshRect.push_back(rect);
+
+    image.position.x = x;
+    image.position.y = y;
+
+    image.isRefresh = true;
+    _MarkDirty();
+}
+
+void CLayoutControl::_MoveText(TextInformation &text, int x, int y)
+{
+    if (!_parents.empty())
+    {
+        for (auto &parent : _parents)
+        {
+            int textX = int(text.position.x * _ratioX) + _position.x;
+            int textY = int(text.position.y * _ratioY) + _position.y;
+            RECT rect;
+
+            SetRect(&rect, textX, textY, textX + int(text.text->GetWidth() * _ratioX),
+                    textY + int(text.text->GetHeight() * _ratioY));
+            _refreshRect.push_back(rect);
+        }
+    }
+
+    text.position.x = x;
+    text.position.y = y;
+    text.isRefresh = true;
+    _MarkDirty();
+}
+
+void CLayoutControl::_MoveTo(int x, int y, bool isRedraw)
+{
+    if (_position.x == x && _position.y == y)
+    {
+        return;
+    }
+
+    if (!isRedraw)
+    {
+        _position.x = x;
+        _position.y = y;
+        return;
+    }
+
+    // 두 축을 한 번에 옮겨서 이전 영역과 새 영역을 부모마다 한 번씩만 갱신한다.
+    _AddParentRefreshRects();
+    _position.x = x;
+    _position.y = y;
+    _AddParentRefreshRects();
+
+    if (!_parents.empty())
+    {
+        _MarkDirty();
+    }
+}
+
+void CLayoutControl::_AddParentRefreshRects()
+{
+    for (auto &parent : _parents)
+    {
+        int width = _size.cx;
+        int height = _size.cy;
+        if (width == 0)
+        {
+            width = parent->GetWidth();
+        }
+        if (height == 0)
+        {
+            height = parent->GetHeight();
+        }
+
+        RECT rect;
+        SetRect(&rect, _position.x, _position.y, _position.x + int(width * _ratioX),
+                _position.y + int(height * _ratioY));
+        _refreshRect.push_back(rect);
+    }
+}
+
+HDC CLayoutControl::_BeginAlphaDraw(HDC destDC, const RECT &rect)
+{
+    int width = rect.right - rect.left;
+    int height = rect.bottom - rect.top;
+
+    // 반투명 항목마다 비트맵을 만들지 않도록 가장 큰 크기로 하나를 두고 다시 쓴다.
+    if (_alphaDC == nullptr)
+    {
+        _alphaDC = CreateCompatibleDC(destDC);
+    }
+    if (width > _alphaBitmapSize.cx || height > _alphaBitmapSize.cy)
+    {
+        int bitmapWidth = width > _alphaBitmapSize.cx ? width : _alphaBitmapSize.cx;
+        int bitmapHeight = height > _alphaBitmapSize.cy ? height : _alphaBitmapSize.cy;
+
+        // 밝기/색조 표를 입힐 때도 쓰도록 픽셀을 직접 쓸 수 있는 32비트 DIB 로 만든다.
+        BITMAPINFO info{};
+        info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+        info.bmiHeader.biWidth = bitmapWidth;
+        info.bmiHeader.biHeight = -bitmapHeight;
+        info.bmiHeader.biPlanes = 1;
+        info.bmiHeader.biBitCount = 32;
+        info.bmiHeader.biCompression = BI_RGB;
+
+        void *bits = nullptr;
+        HBITMAP bitmap = CreateDIBSection(destDC, &info, DIB_RGB_COLORS, &bits, nullptr, 0);
+        if (bitmap != nullptr)
+        {
+            if (_alphaBitmap == nullptr)
+            {
+                _oldAlphaBitmap = SelectBitmap(_alphaDC, bitmap);
+            }
+            else
+            {
+                DeleteBitmap(SelectBitmap(_alphaDC, bitmap));
+            }
+            _alphaBitmap = bitmap;
+            _alphaBitmapSize.cx = bitmapWidth;
+            _alphaBitmapSize.cy = bitmapHeight;
+        }
+    }
+
+    // 뒤 배경을 복사한 비트맵에 그린 다음 AlphaBlend 로 섞는다.
+    BitBlt(_alphaDC, 0, 0, width, height, destDC, rect.left, rect.top, SRCCOPY);
+    SetViewportOrgEx(_alphaDC, -rect.left, -rect.top, nullptr);
+
+    return _alphaDC;
+}
+
+void CLayoutControl::_EndAlphaDraw(HDC destDC, const RECT &rect, BYTE alpha)
+{
+    int width = rect.right - rect.left;
+    int height = rect.bottom - rect.top;
+
+    SetViewportOrgEx(_alphaDC, 0, 0, nullptr);
+
+    BLENDFUNCTION blend{AC_SRC_OVER, 0, alpha, 0};
+    GdiAlphaBlend(destDC, rect.left, rect.top, width, height, _alphaDC, 0, 0, width, height, blend);
+}
+
+bool CLayoutControl::_DrawImageWithLookup(HDC destDC, const ImageInformation &image, const RECT &drawRect,
+                                          const RECT &imageRect, BYTE alpha)
+{
+    // 색 변환 표는 픽셀을 직접 써야 하므로 위에서 아래로 쌓인 32비트 DIB 에 그린다.
+    DIBSECTION dibSection;
+    HGDIOBJ bitmap = GetCurrentObject(destDC, OBJ_BITMAP);
+    if (bitmap == nullptr || GetObject(bitmap, sizeof(DIBSECTION), &dibSection) != sizeof(DIBSECTION) ||
+        dibSection.dsBm.bmBitsPixel != 32 || dibSection.dsBmih.biHeight >= 0 || dibSection.dsBm.bmBits == nullptr)
+    {
+        // 리스트 뷰 행 이미지 같은 DDB 에는 32비트 DIB 인 반투명용 비트맵에 그린 뒤 그대로 옮긴다.
+        if (destDC == _alphaDC)
+        {
+            return false;
+        }
+
+        HDC dibDC = _BeginAlphaDraw(destDC, drawRect);
+        bool isDrawn = _DrawImageWithLookup(dibDC, image, drawRect, imageRect, alpha);
+        _EndAlphaDraw(destDC, drawRect, 255);
+        return isDrawn;
+    }
+
+    auto pixels = image.image->GetPixels(image.image->IsDisplayMirror() ? image.mirrorDC : image.imageDC);
+    POINT origin;
+    RECT clipBox;
+    GetViewportOrgEx(destDC, &origin);
+    if (pixels == nullptr || GetClipBox(destDC, &clipBox) == ERROR)
+    {
+        return false;
+    }
+
+    GdiFlush();
+
+    CFrameBuffer frameBuffer(static_cast<uint32_t *>(dibSection.dsBm.bmBits), dibSection.dsBm.bmWidth,
+                             -dibSection.dsBmih.biHeight, dibSection.dsBm.bmWidthBytes / 4);
+    FrameRect destRect{drawRect.left + origin.x, drawRect.top + origin.y, drawRect.right + origin.x,
+                       drawRect.bottom + origin.y};
+    FrameRect clipingRect{clipBox.left + origin.x, clipBox.top + origin.y, clipBox.right + origin.x,
+                          clipBox.bottom + origin.y};
+    frameBuffer.DrawImage(*pixels, drawRect.left - imageRect.left + image.image->GetClipingLeft(),
+                          drawRect.top - imageRect.top + image.image->GetClipingTop(), destRect, alpha, clipingRect,
+                          image.lookup.get());
+    return true;
+}
+
+std::shared_ptr<const PixelLookup> CLayoutControl::_GetPixelLookup(int brightness, COLORREF tintColor,
+                                                                   int tintAmount)
+{
+    if (brightness == 100 && tintAmount == 0)
+    {
+        return nullptr;
+    }
+
+    // 같은 밝기/색조 조합은 배치끼리 표를 같이 쓰고, 쓰는 배치가 없어지면 표도 해제된다.
+    static std::map<std::tuple<int, COLORREF, int>, std::weak_ptr<PixelLookup>> s_lookups;
+    auto &entry = s_lookups[std::make_tuple(brightness, tintColor, tintAmount)];
+    auto lookup = entry.lock();
+    if (lookup == nullptr)
+    {
+        // 번쩍임처럼 값이 계속 바뀌면 빈 항목이 쌓이므로 만들 때마다 정리한다.
+        auto iter = s_lookups.begin();
+        while (iter != s_lookups.end())
+        {
+            if (iter->second.expired() && &iter->second != &entry)
+            {
+                iter = s_lookups.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+
+        lookup = std::make_shared<PixelLookup>();
+        entry = lookup;
+
+        BYTE tint[3] = {GetRValue(tintColor), GetGValue(tintColor), GetBValue(tintColor)};
+        uint8_t *channels[3] = {lookup->red, lookup->green, lookup->blue};
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            for (int value = 0; value < 256; ++value)
+            {
+                int result = value * brightness / 100;
+                result = result > 255 ? 255 : result;
+                result = (result * (255 - tintAmount) + tint[channel] * tintAmount + 127) / 255;
+                channels[channel][value] = uint8_t(result);
+            }
+        }
+    }
+
+    return lookup;
+}
+
 int CLayoutControl::_GetNewTextIndex()
 {
     int index;
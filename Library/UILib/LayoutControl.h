@@ -3,6 +3,7 @@
 #include "LuaLib\LuaTinker.h"
 
 #include <windows.h>
+#include <memory>
 #include <queue>
 #include <vector>
 
@@ -11,6 +12,8 @@ namespace jojogame
 class CWindowControl;
 class CImageControl;
 class CGraphicText;
+struct RasterCommand;
+struct PixelLookup;
 
 struct ImageInformation
 {
@@ -23,6 +26,12 @@ struct ImageInformation
     POINT position;
     bool isHide;
     bool isRefresh;
+    bool isOccluded;
+    BYTE alpha;
+    int brightness;
+    COLORREF tintColor;
+    BYTE tintAmount;
+    std::shared_ptr<const PixelLookup> lookup;
 };
 
 struct TextInformation
@@ -32,6 +41,25 @@ struct TextInformation
     POINT position;
     bool isHide;
     bool isRefresh;
+    bool isOccluded;
+};
+
+enum LAYOUT_COMMAND
+{
+    LAYOUT_MOVE_IMAGE = 1,
+    LAYOUT_SHOW_IMAGE = 2,
+    LAYOUT_HIDE_IMAGE = 3,
+    LAYOUT_MOVE_TEXT = 4,
+    LAYOUT_SHOW_TEXT = 5,
+    LAYOUT_HIDE_TEXT = 6,
+};
+
+struct LayoutCommand
+{
+    int type;
+    int index;
+    int x;
+    int y;
 };
 
 class CLayoutControl
@@ -47,14 +75,20 @@ public:
     int GetWidth() const;
     int GetHeight() const;
     bool IsHide() const;
+    bool IsOpaque() const;
+    int GetAlpha() const;
+    int GetImageCount() const;
 
     void SetX(int x, bool isRedraw = false);
     void SetY(int y, bool isRedraw = false);
+    void SetPosition(int x, int y, bool isRedraw = false);
     void SetWidth(int cx, bool isRedraw = false);
     void SetHeight(int cy, bool isRedraw = false);
     void SetRatioX(double ratio, bool isRedraw = false);
     void SetRatioY(double ratio, bool isRedraw = false);
     void SetHide(bool value);
+    void SetOpaque(bool value);
+    void SetAlpha(int alpha);
 
     void AddParentWindow(CWindowControl *parent);
     void RemoveParentWIndow(CWindowControl *parent);
@@ -64,38 +98,82 @@ public:
     void MoveImage(int index, int x, int y, bool isUpdate);
     void HideImage(int index, bool isUpdate);
     void ShowImage(int index, bool isUpdate);
+    int GetImageX(int index);
+    int GetImageY(int index);
+    int GetImageAlpha(int index);
+    void SetImageAlpha(int index, int alpha);
+    int GetImageBrightness(int index);
+    COLORREF GetImageTintColor(int index);
+    int GetImageTintAmount(int index);
+    void SetImageBrightness(int index, int brightness);
+    void SetImageTint(int index, COLORREF color, int amount);
 
     int AddText(CGraphicText *text, int x, int y, bool isShow);
     void DeleteText(int index, bool isUpdate);
     void MoveText(int index, int x, int y, bool isUpdate);
     void HideText(int index, bool isUpdate);
     void ShowText(int index, bool isUpdate);
+    int GetTextX(int index);
+    int GetTextY(int index);
+
+    int MoveImages(lua_State *L);
+    int SetImagesVisible(lua_State *L);
+    int QueueCommands(lua_State *L);
+    void ApplyCommands();
 
     void Draw(HDC destDC);
     void Draw(HDC destDC, RECT &rect);
     void Draw(HDC destDC, RECT &rect, COLORREF mixedColor);
+    void Draw(HDC destDC, RECT &rect, POINT offset, SIZE fitSize);
+    void Draw(HDC destDC, RECT &rect, COLORREF mixedColor, POINT offset, SIZE fitSize);
     void Erase();
+    bool BuildRasterCommands(std::vector<RasterCommand> &commands, const RECT &clipingRect);
+
+    void Cull(HDC destDC, HRGN coverage, RECT &clipingRect, LONGLONG &visibleArea, LONGLONG &drawnArea);
+    void ResetCulling();
 
     void Refresh();
 
 private:
     int _GetNewImageIndex();
     int _GetNewTextIndex();
+    ImageInformation *_FindImage(int index);
+    TextInformation *_FindText(int index);
+    void _MoveImage(ImageInformation &image, int x, int y);
+    void _MoveText(TextInformation &text, int x, int y);
+    void _MoveTo(int x, int y, bool isRedraw);
+    void _AddParentRefreshRects();
+    HDC _BeginAlphaDraw(HDC destDC, const RECT &rect);
+    void _EndAlphaDraw(HDC destDC, const RECT &rect, BYTE alpha);
+    bool _DrawImageWithLookup(HDC destDC, const ImageInformation &image, const RECT &drawRect,
+                              const RECT &imageRect, BYTE alpha);
+    static std::shared_ptr<const PixelLookup> _GetPixelLookup(int brightness, COLORREF tintColor, int tintAmount);
+    void _MarkDirty();
 
     HDC _dc;
+    HDC _alphaDC = nullptr;
+    HBITMAP _alphaBitmap = nullptr;
+    HBITMAP _oldAlphaBitmap = nullptr;
+    SIZE _alphaBitmapSize{};
     std::vector<CWindowControl *> _parents;
     std::vector<ImageInformation> _images;
     std::vector<TextInformation> _texts;
+    std::vector<int> _imageLookup;
+    bool _isImageLookupDirty = true;
 
     std::queue<int> _reusingImageIndex;
     std::queue<int> _reusingTextIndex;
 
     std::vector<RECT> _refreshRect;
+    std::vector<LayoutCommand> _commands;
+    bool _isDirty = false;
 
     SIZE _size{};
     POINT _position{};
     double _ratioX = 1.0;
     double _ratioY = 1.0;
     bool _isHide = false;
+    bool _isOpaque = false;
+    int _alpha = 255;
 };
 } // namespace jojogame
@@ -0,0 +1,197 @@
+#include "ListViewTable.h"
+
+namespace jojogame
+{
+void CListViewTable::RegisterFunctions(lua_State *L)
+{
+    LUA_BEGIN(CListViewTable, "_ListViewTable");
+
+    LUA_METHOD(GetColumnCount);
+    LUA_METHOD(GetTotalRowCount);
+    LUA_METHOD(GetViewRowCount);
+    LUA_METHOD(GetViewRow);
+    LUA_METHOD(GetColumnType);
+    LUA_METHOD(GetNumber);
+    LUA_METHOD(GetString);
+
+    LUA_METHOD(SetNumber);
+    LUA_METHOD(SetString);
+    LUA_METHOD(SetListView);
+
+    LUA_METHOD(AddNumberColumn);
+    LUA_METHOD(AddStringColumn);
+    LUA_METHOD(AddRow);
+    LUA_METHOD(Clear);
+
+    LUA_METHOD(AddSortKey);
+    LUA_METHOD(ClearSortKeys);
+    LUA_METHOD(AddPrefixFilter);
+    LUA_METHOD(AddRangeFilter);
+    LUA_METHOD(ClearFilters);
+    LUA_METHOD(Update);
+
+    lua_tinker::set(L, "LISTVIEW_TABLE_NUMBER", static_cast<int>(LISTVIEW_TABLE_NUMBER));
+    lua_tinker::set(L, "LISTVIEW_TABLE_STRING", static_cast<int>(LISTVIEW_TABLE_STRING));
+}
+
+CListViewTable::CListViewTable()
+{
+}
+
+CListViewTable::~CListViewTable()
+{
+    if (_listView != nullptr)
+    {
+        _listView->SetDataSource(nullptr);
+    }
+}
+
+int CListViewTable::GetColumnCount() const
+{
+    return _table.GetColumnCount();
+}
+
+int CListViewTable::GetTotalRowCount() const
+{
+    return _table.GetRowCount();
+}
+
+int CListViewTable::GetViewRowCount() const
+{
+    return _table.GetViewRowCount();
+}
+
+int CListViewTable::GetViewRow(int viewIndex) const
+{
+    return _table.GetViewRow(viewIndex - 1) + 1;
+}
+
+int CListViewTable::GetColumnType(int columnIndex) const
+{
+    return _table.GetColumnType(columnIndex - 1);
+}
+
+double CListViewTable::GetNumber(int rowIndex, int columnIndex) const
+{
+    return _table.GetNumber(rowIndex - 1, columnIndex - 1);
+}
+
+std::wstring CListViewTable::GetString(int rowIndex, int columnIndex) const
+{
+    return _table.GetString(rowIndex - 1, columnIndex - 1);
+}
+
+void CListViewTable::SetNumber(int rowIndex, int columnIndex, double value)
+{
+    _table.SetNumber(rowIndex - 1, columnIndex - 1, value);
+}
+
+void CListViewTable::SetString(int rowIndex, int columnIndex, std::wstring value)
+{
+    _table.SetString(rowIndex - 1, columnIndex - 1, std::move(value));
+}
+
+void CListViewTable::SetListView(CListViewControl *listView)
+{
+    if (_listView != nullptr && _listView != listView)
+    {
+        _listView->SetDataSource(nullptr);
+    }
+
+    _listView = listView;
+
+    if (_listView != nullptr)
+    {
+        _listView->SetDataSource(this);
+    }
+}
+
+int CListViewTable::AddNumberColumn()
+{
+    return _table.AddNumberColumn() + 1;
+}
+
+int CListViewTable::AddStringColumn()
+{
+    return _table.AddStringColumn() + 1;
+}
+
+int CListViewTable::AddRow()
+{
+    return _table.AddRow() + 1;
+}
+
+void CListViewTable::Clear()
+{
+    _table.Clear();
+
+    if (_listView != nullptr)
+    {
+        _listView->SetRowCount(0);
+    }
+}
+
+void CListViewTable::AddSortKey(int columnIndex, bool isAscending)
+{
+    _table.AddSortKey(columnIndex - 1, isAscending);
+}
+
+void CListViewTable::ClearSortKeys()
+{
+    _table.ClearSortKeys();
+}
+
+void CListViewTable::AddPrefixFilter(int columnIndex, std::wstring prefix)
+{
+    _table.AddPrefixFilter(columnIndex - 1, std::move(prefix));
+}
+
+void CListViewTable::AddRangeFilter(int columnIndex, double minimum, double maximum)
+{
+    _table.AddRangeFilter(columnIndex - 1, minimum, maximum);
+}
+
+void CListViewTable::ClearFilters()
+{
+    _table.ClearFilters();
+}
+
+void CListViewTable::Update()
+{
+    int oldViewCount = _table.GetViewRowCount();
+
+    _table.Update();
+
+    if (_listView != nullptr)
+    {
+        // 행 수가 그대로면 보이는 행만 다시 그린다.
+        int viewCount = _table.GetViewRowCount();
+        if (oldViewCount != viewCount || _listView->GetRowCount() != viewCount)
+        {
+            _listView->SetRowCount(viewCount);
+        }
+        else
+        {
+            _listView->InvalidateRows();
+        }
+    }
+}
+
+int CListViewTable::GetRowCount()
+{
+    return _table.GetViewRowCount();
+}
+
+std::wstring CListViewTable::GetCellText(int rowIndex, int columnIndex)
+{
+    return _table.GetText(_table.GetViewRow(rowIndex), columnIndex);
+}
+
+void CListViewTable::DetachListView(CListViewControl *listView)
+{
+    if (_listView == listView)
+    {
+        _listView = nullptr;
+    }
+}
+} // namespace jojogame
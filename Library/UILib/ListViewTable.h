@@ -0,0 +1,58 @@
+#pragma once
+
+#include "ListviewControl.h"
+#include "BaseLib\ColumnTable.h"
+
+#include <string>
+#include <vector>
+
+namespace jojogame
+{
+enum LISTVIEW_TABLE_COLUMN_TYPE
+{
+    LISTVIEW_TABLE_NUMBER = COLUMN_TABLE_NUMBER,
+    LISTVIEW_TABLE_STRING = COLUMN_TABLE_STRING,
+};
+
+// CColumnTable 을 루아(1 부터 세는 번호)와 가상 리스트뷰에 연결한다.
+class CListViewTable : public IListViewDataSource
+{
+public:
+    static void RegisterFunctions(lua_State *L);
+
+    CListViewTable();
+    virtual ~CListViewTable();
+
+    int GetColumnCount() const;
+    int GetTotalRowCount() const;
+    int GetViewRowCount() const;
+    int GetViewRow(int viewIndex) const;
+    int GetColumnType(int columnIndex) const;
+    double GetNumber(int rowIndex, int columnIndex) const;
+    std::wstring GetString(int rowIndex, int columnIndex) const;
+
+    void SetNumber(int rowIndex, int columnIndex, double value);
+    void SetString(int rowIndex, int columnIndex, std::wstring value);
+    void SetListView(CListViewControl *listView);
+
+    int AddNumberColumn();
+    int AddStringColumn();
+    int AddRow();
+    void Clear();
+
+    void AddSortKey(int columnIndex, bool isAscending);
+    void ClearSortKeys();
+    void AddPrefixFilter(int columnIndex, std::wstring prefix);
+    void AddRangeFilter(int columnIndex, double minimum, double maximum);
+    void ClearFilters();
+    void Update();
+
+    int GetRowCount() override;
+    std::wstring GetCellText(int rowIndex, int columnIndex) override;
+    void DetachListView(CListViewControl *listView) override;
+
+private:
+    CColumnTable _table;
+    CListViewControl *_listView = nullptr;
+};
+} // namespace jojogame
@@ -1,6 +1,7 @@
 #include "ListviewControl.h"
 
 #include "ControlManager.h"
+#include "BaseLib\MemoryPool.h"
 #include "WindowControl.h"
 
 #include <CommCtrl.h>
@@ -10,6 +11,12 @@ namespace jojogame
 {
 WNDPROC CListViewControl::s_originalProc = nullptr;
 
+bool ListViewRowImageKey::operator==(const ListViewRowImageKey &other) const
+{
+    return height == other.height && origin.x == other.origin.x && origin.y == other.origin.y &&
+           columnWidths == other.columnWidths && fontVersions == other.fontVersions;
+}
+
 LRESULT CListViewControl::OnControlProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
     TRACKMOUSEEVENT trackMouseEvent;
@@ -361,7 +368,17 @@ void CListViewItem::SetParentListRow(CListViewRow *parent)
 
 void CListViewItem::SetText(std::wstring text)
 {
+    if (_text == text)
+    {
+        return;
+    }
+
     _text = text;
+
+    if (_parentListRow)
+    {
+        _parentListRow->InvalidateCache();
+    }
 }
 
 void CListViewItem::SetNormalBackgroundColor(COLORREF color)
@@ -434,6 +451,11 @@ void CListViewItem::SetItemIndex(int itemIndex)
 
 void CListViewItem::_Update()
 {
+    if (_parentListRow)
+    {
+        _parentListRow->InvalidateCache();
+    }
+
     if (_parentListRow && _parentListRow->GetParentListView())
     {
         auto listView = _parentListRow->GetParentListView();
@@ -476,6 +498,7 @@ void CListViewRow::RegisterFunctions(lua_State *L)
     LUA_METHOD(IsEnabled);
     LUA_METHOD(GetActiveEvent);
     LUA_METHOD(GetItem);
+    LUA_METHOD(GetItemCount);
 
     LUA_METHOD(SetNormalBackgroundColor);
     LUA_METHOD(SetFocusedBackgroundColor);
@@ -498,6 +521,8 @@ CListViewRow::~CListViewRow()
     {
         luaL_unref(CLuaTinker::GetLuaTinker().GetLuaState(), LUA_REGISTRYINDEX, _activeEvent);
     }
+
+    InvalidateCache();
 }
 
 bool CListViewRow::IsEnabled()
@@ -525,14 +550,35 @@ CListViewItem *CListViewRow::GetItem(int subIndex)
     return _items[subIndex - 1];
 }
 
+int CListViewRow::GetItemCount()
+{
+    return static_cast<int>(_items.size());
+}
+
 int CListViewRow::GetRowIndex()
 {
     return _rowIndex;
 }
 
+HBITMAP CListViewRow::GetCachedImage(bool isSelected, const ListViewRowImageKey &key)
+{
+    int state = isSelected ? 1 : 0;
+    if (_cachedImages[state] != nullptr && _cachedKeys[state] == key)
+    {
+        if (_parentListView)
+        {
+            _parentListView->TouchRowImage(this);
+        }
+        return _cachedImages[state];
+    }
+
+    return nullptr;
+}
+
 void CListViewRow::SetEnabled(bool isEnabled)
 {
     _isEnabled = isEnabled;
+    InvalidateCache();
 
     if (_parentListView)
     {
@@ -600,6 +646,7 @@ void CListViewRow::SetItem(int subIndex, CListViewItem *item)
     }
 
     _items[subIndex - 1] = item;
+    InvalidateCache();
 }
 
 void CListViewRow::SetRowIndex(int index)
@@ -607,11 +654,48 @@ void CListViewRow::SetRowIndex(int index)
     _rowIndex = index;
 }
 
+void CListViewRow::SetCachedImage(bool isSelected, const ListViewRowImageKey &key, HBITMAP image)
+{
+    int state = isSelected ? 1 : 0;
+    if (_cachedImages[state] != nullptr && _cachedImages[state] != image)
+    {
+        DeleteBitmap(_cachedImages[state]);
+    }
+
+    _cachedImages[state] = image;
+    _cachedKeys[state] = key;
+
+    if (_parentListView)
+    {
+        _parentListView->TouchRowImage(this);
+    }
+}
+
 void CListViewRow::AddItem(CListViewItem *item)
 {
     item->SetParentListRow(this);
     item->SetItemIndex(_items.size());
     _items.push_back(item);
+    InvalidateCache();
+}
+
+void CListViewRow::InvalidateCache()
+{
+    bool isCached = false;
+    for (auto &image : _cachedImages)
+    {
+        if (image != nullptr)
+        {
+            DeleteBitmap(image);
+            image = nullptr;
+            isCached = true;
+        }
+    }
+
+    if (isCached && _parentListView)
+    {
+        _parentListView->RemoveRowImage(this);
+    }
 }
 
 void CListViewControl::RegisterFunctions(lua_State *L)
@@ -619,8 +703,11 @@ void CListViewControl::RegisterFunctions(lua_State *L)
     LUA_BEGIN_CHILD(CListViewControl, "_ListView", CWindowChildControl);
 
     LUA_METHOD(IsTransparentBackground);
+    LUA_METHOD(IsVirtual);
     LUA_METHOD(GetColumn);
     LUA_METHOD(GetRow);
+    LUA_METHOD(GetRowCount);
+    LUA_METHOD(GetVirtualRow);
 
     LUA_METHOD(SetShowBoder);
     LUA_METHOD(SetShowColumn);
@@ -629,9 +716,14 @@ void CListViewControl::RegisterFunctions(lua_State *L)
     LUA_METHOD(SetTrackingSelect);
     LUA_METHOD(SetTransparentBackground);
     LUA_METHOD(SetRowHeight);
+    LUA_METHOD(SetVirtual);
+    LUA_METHOD(SetRowCount);
+    LUA_METHOD(SetDataEvent);
 
     LUA_METHOD(AddColumn);
     LUA_METHOD(AddRow);
+    LUA_METHOD(InvalidateRows);
+    LUA_METHOD(AutoSizeColumns);
 
     LUA_METHOD(Create);
     LUA_METHOD(Destroy);
@@ -654,10 +746,23 @@ CListViewControl::CListViewControl()
 
 CListViewControl::~CListViewControl()
 {
+    InvalidateRowImages();
+
+    if (_dataSource != nullptr)
+    {
+        _dataSource->DetachListView(this);
+        _dataSource = nullptr;
+    }
+
     if (_backgroundBrush)
     {
         DeleteBrush(_backgroundBrush);
     }
+
+    if (_dataEvent != LUA_NOREF)
+    {
+        luaL_unref(CLuaTinker::GetLuaTinker().GetLuaState(), LUA_REGISTRYINDEX, _dataEvent);
+    }
 }
 
 bool CListViewControl::IsShowBorder() const
@@ -690,6 +795,11 @@ bool CListViewControl::IsTransparentBackground() const
     return _isTransparentBackground;
 }
 
+bool CListViewControl::IsVirtual() const
+{
+    return _isVirtual;
+}
+
 CListViewColumn *CListViewControl::GetColumn(int columnIndex)
 {
     if (columnIndex > _columns.size() || columnIndex < 1)
@@ -734,6 +844,37 @@ int CListViewControl::GetRowHeight()
     return _rowHeight;
 }
 
+int CListViewControl::GetRowCount()
+{
+    if (_isVirtual)
+    {
+        return _virtualRowCount;
+    }
+
+    return _rows.size();
+}
+
+int CListViewControl::GetDataEvent()
+{
+    return _dataEvent;
+}
+
+CListViewRow *CListViewControl::GetVirtualRow()
+{
+    if (_virtualRow == nullptr)
+    {
+        // 부모 리스트뷰를 지정하지 않아서 아이템을 바꿔도 화면 갱신을 요청하지 않는다.
+        _virtualRow = CMemoryPool<CListViewRow>::GetInstance().New();
+    }
+
+    while (_virtualRow->GetItemCount() < static_cast<int>(_columns.size()))
+    {
+        _virtualRow->AddItem(CMemoryPool<CListViewItem>::GetInstance().New());
+    }
+
+    return _virtualRow;
+}
+
 void CListViewControl::SetShowBoder(bool isShowBorder)
 {
     _isShowBorder = isShowBorder;
@@ -868,6 +1009,204 @@ void CListViewControl::SetRowHeight(int rowHeight)
     }
 }
 
+void CListViewControl::SetVirtual(bool isVirtual)
+{
+    // LVS_OWNERDATA 는 만든 뒤에 바꿀 수 없다.
+    if (_hWnd != nullptr)
+    {
+        return;
+    }
+
+    _isVirtual = isVirtual;
+    if (_isVirtual)
+    {
+        _style |= LVS_OWNERDATA;
+    }
+    else
+    {
+        _style &= ~LVS_OWNERDATA;
+    }
+}
+
+void CListViewControl::SetRowCount(int rowCount)
+{
+    if (!_isVirtual)
+    {
+        return;
+    }
+
+    _virtualRowCount = rowCount > 0 ? rowCount : 0;
+    _virtualTexts.clear();
+
+    if (_hWnd != nullptr)
+    {
+        ListView_SetItemCountEx(_hWnd, _virtualRowCount, LVSICF_NOSCROLL);
+        _AutoSizeVirtualColumns();
+    }
+}
+
+void CListViewControl::SetDataEvent()
+{
+    auto l = CLuaTinker::GetLuaTinker().GetLuaState();
+    if (lua_isfunction(l, -1))
+    {
+        if (_dataEvent != LUA_NOREF)
+        {
+            luaL_unref(l, LUA_REGISTRYINDEX, _dataEvent);
+        }
+
+        lua_pushvalue(l, -1);
+        _dataEvent = luaL_ref(l, LUA_REGISTRYINDEX);
+        _virtualTexts.clear();
+    }
+
+    lua_pop(l, 1);
+}
+
+void CListViewControl::SetDataSource(IListViewDataSource *dataSource)
+{
+    if (_dataSource != nullptr && _dataSource != dataSource)
+    {
+        _dataSource->DetachListView(this);
+    }
+
+    _dataSource = dataSource;
+
+    if (_dataSource != nullptr)
+    {
+        SetRowCount(_dataSource->GetRowCount());
+    }
+    else
+    {
+        InvalidateRows();
+    }
+}
+
+void CListViewControl::InvalidateRows()
+{
+    _virtualTexts.clear();
+
+    if (_hWnd != nullptr)
+    {
+        InvalidateRect(_hWnd, nullptr, FALSE);
+    }
+}
+
+void CListViewControl::TouchRowImage(CListViewRow *row)
+{
+    auto iter = _imageRowMap.find(row);
+    if (iter != _imageRowMap.end())
+    {
+        _imageRows.splice(_imageRows.begin(), _imageRows, iter->second);
+        return;
+    }
+
+    _imageRows.push_front(row);
+    _imageRowMap[row] = _imageRows.begin();
+    _TrimRowImages();
+}
+
+void CListViewControl::RemoveRowImage(CListViewRow *row)
+{
+    auto iter = _imageRowMap.find(row);
+    if (iter != _imageRowMap.end())
+    {
+        _imageRows.erase(iter->second);
+        _imageRowMap.erase(iter);
+    }
+}
+
+void CListViewControl::InvalidateRowImages()
+{
+    // 목록에서 먼저 빼야 행의 InvalidateCache 가 다시 이 목록을 건드리지 않는다.
+    auto rows = std::move(_imageRows);
+    _imageRows.clear();
+    _imageRowMap.clear();
+
+    for (auto row : rows)
+    {
+        row->InvalidateCache();
+    }
+}
+
+void CListViewControl::AutoSizeColumns()
+{
+    if (_isVirtual)
+    {
+        _AutoSizeVirtualColumns();
+        return;
+    }
+
+    if (_hWnd == nullptr)
+    {
+        return;
+    }
+
+    for (auto i = 0; i < _columns.size(); ++i)
+    {
+        if (_columns[i]->IsAutoSizeFitItem())
+        {
+            ListView_SetColumnWidth(_hWnd, i, LVSCW_AUTOSIZE);
+        }
+        else if (_columns[i]->IsAutoSizeFitHeader())
+        {
+            ListView_SetColumnWidth(_hWnd, i, LVSCW_AUTOSIZE_USEHEADER);
+        }
+    }
+}
+
+std::wstring CListViewControl::GetCellText(int rowIndex, int columnIndex)
+{
+    if (rowIndex < 0 || rowIndex >= _virtualRowCount || columnIndex < 0 ||
+        columnIndex >= static_cast<int>(_columns.size()))
+    {
+        return L"";
+    }
+
+    if (_dataSource != nullptr)
+    {
+        return _dataSource->GetCellText(rowIndex, columnIndex);
+    }
+
+    if (_dataEvent == LUA_NOREF)
+    {
+        return L"";
+    }
+
+    // 루아 호출은 비싸므로 한 행을 통째로 받아 두고 스크롤하는 동안 다시 쓴다.
+    auto iter = _virtualTexts.find(rowIndex);
+    if (iter == _virtualTexts.end())
+    {
+        if (static_cast<int>(_virtualTexts.size()) >= MAX_VIRTUAL_TEXT_ROWS)
+        {
+            _virtualTexts.clear();
+        }
+
+        int columnCount = static_cast<int>(_columns.size());
+        std::vector<std::wstring> texts(columnCount);
+        for (int i = 0; i < columnCount; ++i)
+        {
+            texts[i] = CLuaTinker::GetLuaTinker().Call<std::wstring>(_dataEvent, this, rowIndex + 1, i + 1);
+        }
+        iter = _virtualTexts.emplace(rowIndex, std::move(texts)).first;
+    }
+
+    return iter->second[columnIndex];
+}
+
+CListViewRow *CListViewControl::FillVirtualRow(int rowIndex)
+{
+    auto row = GetVirtualRow();
+    row->SetRowIndex(rowIndex);
+
+    for (int i = 0; i < static_cast<int>(_columns.size()); ++i)
+    {
+        row->GetItem(i + 1)->SetText(GetCellText(rowIndex, i));
+    }
+
+    return row;
+}
+
 void CListViewControl::AppendColumn(CListViewColumn *column)
 {
     int index;
@@ -915,7 +1254,7 @@ void CListViewControl::AddColumn(CListViewColumn *column)
 
 void CListViewControl::AppendRow(CListViewRow *row)
 {
-    if (_hWnd != nullptr)
+    if (_hWnd != nullptr && !_isVirtual)
     {
         int itemIndex;
 
@@ -1002,15 +1341,143 @@ bool CListViewControl::Create()
             this->AppendColumn(column);
         }
 
-        for (auto row : _rows)
+        if (_isVirtual)
+        {
+            ListView_SetItemCountEx(_hWnd, _virtualRowCount, LVSICF_NOSCROLL);
+            _AutoSizeVirtualColumns();
+        }
+        else
         {
-            this->AppendRow(row);
+            for (auto row : _rows)
+            {
+                this->AppendRow(row);
+            }
         }
     }
 
     return _hWnd != nullptr;
 }
 
+void CListViewControl::_AutoSizeVirtualColumns()
+{
+    if (_hWnd == nullptr || _columns.empty())
+    {
+        return;
+    }
+
+    // LVSCW_AUTOSIZE 는 가상 모드에서 모든 행을 물어보므로 몇 행만 골라서 직접 잰다.
+    auto row = GetVirtualRow();
+    int sampleCount = _virtualRowCount < MAX_AUTOSIZE_SAMPLE_ROWS ? _virtualRowCount : MAX_AUTOSIZE_SAMPLE_ROWS;
+    HDC measureDC = CreateCompatibleDC(nullptr);
+    HFONT headerFont = reinterpret_cast<HFONT>(SendMessage(_hWnd, WM_GETFONT, 0, 0));
+
+    for (auto i = 0; i < _columns.size(); ++i)
+    {
+        auto column = _columns[i];
+        if (!column->IsAutoSizeFitItem() && !column->IsAutoSizeFitHeader())
+        {
+            continue;
+        }
+
+        SIZE textSize;
+        int width = 0;
+        auto oldFont = SelectFont(measureDC, row->GetItem(i + 1)->GetFont()->GetHFont());
+        for (auto sample = 0; sample < sampleCount; ++sample)
+        {
+            int rowIndex = sampleCount > 1 ? int(static_cast<long long>(sample) * (_virtualRowCount - 1) / (sampleCount - 1)) : 0;
+            auto text = GetCellText(rowIndex, i);
+            GetTextExtentPoint32(measureDC, text.c_str(), int(text.size()), &textSize);
+            width = textSize.cx > width ? textSize.cx : width;
+        }
+
+        if (column->IsAutoSizeFitHeader())
+        {
+            auto text = column->GetText();
+            SelectFont(measureDC, headerFont);
+            GetTextExtentPoint32(measureDC, text.c_str(), int(text.size()), &textSize);
+            width = textSize.cx > width ? textSize.cx : width;
+        }
+        SelectFont(measureDC, oldFont);
+
+        ListView_SetColumnWidth(_hWnd, i, width + AUTOSIZE_PADDING);
+    }
+
+    DeleteDC(measureDC);
+}
+
+void CListViewControl::_TrimRowImages()
+{
+    // 화면 밖으로 스크롤된 행의 이미지는 바로 버린다.
+    if (_hWnd != nullptr)
+    {
+        int topIndex = ListView_GetTopIndex(_hWnd);
+        int bottomIndex = topIndex + ListView_GetCountPerPage(_hWnd);
+
+        auto iter = _imageRows.begin();
+        while (iter != _imageRows.end())
+        {
+            auto row = *iter;
+            if (row->GetRowIndex() < topIndex || row->GetRowIndex() > bottomIndex)
+            {
+                _imageRowMap.erase(row);
+                iter = _imageRows.erase(iter);
+                row->InvalidateCache();
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+    }
+
+    while (_imageRows.size() > MAX_ROW_IMAGES)
+    {
+        auto row = _imageRows.back();
+        _imageRowMap.erase(row);
+        _imageRows.pop_back();
+        row->InvalidateCache();
+    }
+}
+
+void CListViewControl::InvalidateTransparentRowImages(HWND parentHWnd, const RECT &rect)
+{
+    struct ChildSearch
+    {
+        HWND parentHWnd;
+        RECT rect;
+    };
+
+    ChildSearch search{parentHWnd, rect};
+    EnumChildWindows(parentHWnd,
+                     [](HWND hWnd, LPARAM lParam) -> BOOL {
+                         auto search = reinterpret_cast<ChildSearch *>(lParam);
+                         if (GetWindowLongPtr(hWnd, GWLP_WNDPROC) !=
+                             reinterpret_cast<LONG_PTR>(CListViewControl::OnControlProc))
+                         {
+                             return TRUE;
+                         }
+
+                         auto listView = reinterpret_cast<CListViewControl *>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
+                         if (listView == nullptr || !listView->IsTransparentBackground())
+                         {
+                             return TRUE;
+                         }
+
+                         // 바뀐 배경 영역과 겹치는 투명 리스트뷰만 행 이미지를 다시 그린다.
+                         RECT listViewRect;
+                         RECT intersectRect;
+                         GetWindowRect(hWnd, &listViewRect);
+                         MapWindowPoints(HWND_DESKTOP, search->parentHWnd, reinterpret_cast<POINT *>(&listViewRect), 2);
+                         if (IntersectRect(&intersectRect, &listViewRect, &search->rect))
+                         {
+                             listView->InvalidateRowImages();
+                         }
+
+                         return TRUE;
+                     },
+                     reinterpret_cast<LPARAM>(&search));
+}
+
 WNDPROC CListViewControl::GetOriginalProc()
 {
     return s_originalProc;
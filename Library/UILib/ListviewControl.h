@@ -3,6 +3,8 @@
 #include "TextFont.h"
 #include "WindowChildControl.h"
 
+#include <list>
+#include <unordered_map>
 #include <vector>
 #include <CommCtrl.h>
 
@@ -11,6 +13,17 @@ namespace jojogame
 class CWindowControl;
 class CListViewControl;
 
+// 그려 둔 행 이미지를 다시 쓸 수 있는지 비교하는 값 (투명 배경일 때는 창 안의 위치도 본다)
+struct ListViewRowImageKey
+{
+    int height = 0;
+    POINT origin{0, 0};
+    std::vector<int> columnWidths;
+    std::vector<int> fontVersions;
+
+    bool operator==(const ListViewRowImageKey &other) const;
+};
+
 struct ListViewItemColorState
 {
     COLORREF normal;
@@ -19,6 +32,23 @@ struct ListViewItemColorState
     COLORREF disableFocused;
 };
 
+// 가상 모드에서 셀 글자를 그때그때 넘겨주는 쪽 (행, 열 모두 0 부터)
+class IListViewDataSource
+{
+public:
+    virtual ~IListViewDataSource()
+    {
+    }
+
+    virtual int GetRowCount() = 0;
+    virtual std::wstring GetCellText(int rowIndex, int columnIndex) = 0;
+
+    // 리스트뷰가 이 데이터를 더 이상 쓰지 않을 때(해제, 다른 데이터로 교체) 불린다.
+    virtual void DetachListView(CListViewControl *listView)
+    {
+    }
+};
+
 class CListViewColumn
 {
 public:
@@ -118,7 +148,9 @@ public:
     CListViewControl *GetParentListView();
     int GetActiveEvent();
     CListViewItem *GetItem(int subIndex);
+    int GetItemCount();
     int GetRowIndex();
+    HBITMAP GetCachedImage(bool isSelected, const ListViewRowImageKey &key);
 
     void SetEnabled(bool isEnabled);
     void SetParentListView(CListViewControl *parent);
@@ -129,8 +161,10 @@ public:
     void SetActiveEvent();
     void SetItem(int subIndex, CListViewItem *item);
     void SetRowIndex(int index);
+    void SetCachedImage(bool isSelected, const ListViewRowImageKey &key, HBITMAP image);
 
     void AddItem(CListViewItem *item);
+    void InvalidateCache();
 
 private:
     bool _isEnabled = true;
@@ -140,6 +174,10 @@ private:
     int _rowIndex = -1;
     int _activeEvent = LUA_NOREF;
     std::vector<CListViewItem *> _items;
+
+    // 선택 안 됨/선택됨 상태별로 그려 둔 행 이미지
+    HBITMAP _cachedImages[2] = {nullptr, nullptr};
+    ListViewRowImageKey _cachedKeys[2];
 };
 
 class CListViewControl : public CWindowChildControl
@@ -156,12 +194,16 @@ public:
     bool IsOneClickItemActivated() const;
     bool IsTrackingSelect() const;
     bool IsTransparentBackground() const;
+    bool IsVirtual() const;
     CListViewColumn *GetColumn(int columnIndex);
     CListViewRow *GetRow(int rowIndex);
     int GetColumnCount();
     COLORREF GetBackgroundColor();
     HBRUSH GetBackgroundBrush();
     int GetRowHeight();
+    int GetRowCount();
+    int GetDataEvent();
+    CListViewRow *GetVirtualRow();
 
     void SetShowBoder(bool isShowBorder);
     void SetShowColumn(bool isShowColumn);
@@ -172,18 +214,33 @@ public:
     void SetParentWindow(CWindowControl *parent);
     void SetBackgroundColor(COLORREF color);
     void SetRowHeight(int rowHeight);
+    void SetVirtual(bool isVirtual);
+    void SetRowCount(int rowCount);
+    void SetDataEvent();
+    void SetDataSource(IListViewDataSource *dataSource);
 
     void AddColumn(CListViewColumn *column);
     void AddRow(CListViewRow *row);
 
+    void InvalidateRows();
+    void TouchRowImage(CListViewRow *row);
+    void RemoveRowImage(CListViewRow *row);
+    void InvalidateRowImages();
+    void AutoSizeColumns();
+    std::wstring GetCellText(int rowIndex, int columnIndex);
+    CListViewRow *FillVirtualRow(int rowIndex);
+
     bool Create() override;
 
+    static void InvalidateTransparentRowImages(HWND parentHWnd, const RECT &rect);
     static WNDPROC GetOriginalProc();
     static LRESULT CALLBACK OnControlProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
 private:
     void AppendColumn(CListViewColumn *column);
     void AppendRow(CListViewRow *row);
+    void _AutoSizeVirtualColumns();
+    void _TrimRowImages();
 
     int _rowHeight = 19;
 
@@ -202,6 +259,22 @@ private:
     std::vector<CListViewColumn *> _columns;
     std::vector<CListViewRow *> _rows;
 
+    // 행 이미지를 가진 행을 최근에 그린 순서로 둔다.
+    static const int MAX_ROW_IMAGES = 128;
+    std::list<CListViewRow *> _imageRows;
+    std::unordered_map<CListViewRow *, std::list<CListViewRow *>::iterator> _imageRowMap;
+
+    // 가상(LVS_OWNERDATA) 모드
+    static const int MAX_VIRTUAL_TEXT_ROWS = 512;
+    static const int MAX_AUTOSIZE_SAMPLE_ROWS = 64;
+    static const int AUTOSIZE_PADDING = 12;
+    bool _isVirtual = false;
+    int _virtualRowCount = 0;
+    int _dataEvent = LUA_NOREF;
+    IListViewDataSource *_dataSource = nullptr;
+    CListViewRow *_virtualRow = nullptr;
+    std::unordered_map<int, std::vector<std::wstring>> _virtualTexts;
+
     static WNDPROC s_originalProc;
 };
 } // namespace jojogame
@@ -1,11 +1,15 @@
 ﻿#include "MoviePlayerControl.h"
 #include "ControlManager.h"
 #include "WindowControl.h"
+#include "InputManager.h"
+#include "AudioPlayer.h"
 #include "ToolbarControl.h"
 
 #include <iostream>
 
 #include "BaseLib/ConsoleOutput.h"
+#include "BaseLib/JobSystem.h"
+#include "BaseLib/TraceRecorder.h"
 #include "CommonLib/FileManager.h"
 
 namespace jojogame
@@ -69,9 +73,16 @@ void CMoviePlayerControl::SetEndEvent()
     lua_pop(l, 1);
 }
 
+// 성능 표시에서 읽을 수 있도록 큐가 얼마나 찼는지 백분율로 남긴다.
+static void UpdateQueueFill(PacketQueue *queue)
+{
+    queue->fill.store(int(int64_t(queue->size) * 100 / MAX_AUDIOQ_SIZE), std::memory_order_relaxed);
+}
+
 void InitPacketQueue(PacketQueue *queue)
 {
     queue->size = 0;
+    queue->fill.store(0, std::memory_order_relaxed);
     queue->firstPacket = nullptr;
     queue->lastPacket = nullptr;
 }
@@ -102,6 +113,8 @@ int PutPacketQueue(PacketQueue *queue, AVPacket *packet)
     }
     queue->lastPacket = packetList;
     queue->size += packetList->pkt.size;
+    UpdateQueueFill(queue);
+    TRACE_FLOW_START("Movie Packet", reinterpret_cast<intptr_t>(packetList));
     queue->cond.notify_one();
     lock.unlock();
 
@@ -131,7 +144,9 @@ static int GetPacketQueue(VideoState *videoState, PacketQueue *queue, AVPacket *
                 queue->lastPacket = nullptr;
             }
             queue->size -= packetList->pkt.size;
+            UpdateQueueFill(queue);
             *packet = packetList->pkt;
+            TRACE_FLOW_END("Movie Packet", reinterpret_cast<intptr_t>(packetList));
             av_free(packetList);
             result = 1;
             break;
@@ -147,6 +162,8 @@ static int GetPacketQueue(VideoState *videoState, PacketQueue *queue, AVPacket *
             result = -1;
             break;
         }
+
+        TRACE_SCOPE("Wait Movie Packet");
         queue->cond.wait(lock);
     }
     lock.unlock();
@@ -321,6 +338,9 @@ int DecodeAudioFrame(VideoState *videoState, uint8_t *audioBuffer, int bufferSiz
 
 void AudioCallback(void *userdata, Uint8 *stream, int len)
 {
+    TRACE_THREAD_NAME("SDL Audio");
+    TRACE_SCOPE("Movie Audio Callback");
+
     auto videoState = (VideoState *)userdata;
     double pts;
 
@@ -357,39 +377,17 @@ void AudioCallback(void *userdata, Uint8 *stream, int len)
     }
 }
 
-static void RefreshTimerCallback(void *data)
-{
-    auto videoState = (VideoState *)data;
-    videoState->eventQueue.push(WM_REFRESH_EVENT);
-
-    //    PostThreadMessage(threadId, WM_REFRESH_EVENT, NULL, (LPARAM)data);
-
-    //    SDL_Event event;
-    //    event.type = WM_REFRESH_EVENT;
-    //    event.user.data1 = data;
-    //    SDL_PushEvent(&event);
-    //    return 0; /* 0 means stop timer */
-}
-
 /* schedule a video refresh in 'delay' ms */
 static void ScheduleRefresh(VideoState *is, int delay)
 {
-    //    auto mainThreadId = std::this_thread::get_id();
-    //    std::stringstream stringStream;
-    //    stringStream << mainThreadId;
-    //    auto id = (DWORD) std::stoull(stringStream.str());
-
-    std::thread([is, delay]() {
-        std::this_thread::sleep_for(std::chrono::milliseconds(delay));
-        RefreshTimerCallback(is);
-    })
-        .detach();
-
-    //    SDL_AddTimer(delay, RefreshTimerCallback, is);
+    // 프레임마다 스레드를 만들지 않고 재생 루프가 기한을 보고 직접 갱신한다.
+    is->refreshTime = av_gettime() + int64_t(delay) * 1000;
 }
 
 void DisplayVideo(VideoState *videoState)
 {
+    TRACE_SCOPE("Display Video");
+
     VideoFrame *videoFrame = &videoState->frameQueue[videoState->frameQueueRearIndex];
     if (videoFrame->dc)
     {
@@ -409,7 +407,10 @@ void DisplayVideo(VideoState *videoState)
 
 void RefreshVideoTimer(void *userdata)
 {
+    TRACE_SCOPE("Refresh Video");
+
     auto *videoState = (VideoState *)userdata;
+    TRACE_COUNTER("Frame Queue", videoState->frameQueueSize);
 
     if (videoState->videoStream)
     {
@@ -537,6 +538,7 @@ int QueuePicture(VideoState *videoState, AVFrame *frame, double pts)
     while (videoState->frameQueueSize >= VIDEO_FRAME_QUEUE_SIZE &&
            videoState->playing)
     {
+        TRACE_SCOPE("Wait Frame Slot");
         videoState->frameQueueCond.wait(lock);
     }
     lock.unlock();
@@ -623,6 +625,8 @@ int ThreadVideo(void *arg)
             break;
         }
 
+        TRACE_SCOPE("Decode Video");
+
         double pts = 0;
         if (avcodec_send_packet(videoState->videoCodecContext, &packet) == 0)
         {
@@ -818,6 +822,7 @@ bool PlayMovie(VideoState *videoState)
     videoState->videoCurrentPtsTime = av_gettime();
 
     auto t = std::thread([&]() {
+        TRACE_THREAD_NAME("Video Decode");
         ThreadVideo(videoState);
     });
 
@@ -853,10 +858,12 @@ bool PlayMovie(VideoState *videoState)
         if (packet.stream_index == videoState->videoStreamIndex)
         {
             PutPacketQueue(&videoState->videoQueue, &packet);
+            TRACE_COUNTER("Video Queue", videoState->videoQueue.size);
         }
         else if (packet.stream_index == videoState->audioStreamIndex)
         {
             PutPacketQueue(&videoState->audioQueue, &packet);
+            TRACE_COUNTER("Movie Audio Queue", videoState->audioQueue.size);
         }
         else
         {
@@ -871,14 +878,14 @@ bool PlayMovie(VideoState *videoState)
 
 void CMoviePlayerControl::Play()
 {
-    std::queue<int> queue;
-    _state.eventQueue.swap(queue);
     _state.playing = true;
     _state.finishQueue = false;
 
     ScheduleRefresh(&_state, 40);
+    CAudioPlayerControl::AddQueueFill(&_state.audioQueue.fill);
 
     auto t = std::thread([&]() {
+        TRACE_THREAD_NAME("Movie Demux");
         PlaySound(&_state);
         PlayMovie(&_state);
     });
@@ -922,14 +929,25 @@ void CMoviePlayerControl::Play()
         {
             break;
         }
-        else if (!_state.eventQueue.empty() && _state.eventQueue.front() == WM_REFRESH_EVENT)
+        else
         {
-            _state.eventQueue.pop();
-            RefreshVideoTimer(reinterpret_cast<void *>(&_state));
+            int64_t now = av_gettime();
+            if (now >= _state.refreshTime)
+            {
+                // 재생하는 동안에는 메인 루프가 돌지 않으므로 화면을 갱신할 때마다 입력을 보낸다.
+                CInputManager::GetInstance().Dispatch();
+                RefreshVideoTimer(reinterpret_cast<void *>(&_state));
+            }
+            else if (CJobSystem::GetInstance().RunMainThreadJobs() == 0)
+            {
+                auto timeout = DWORD((_state.refreshTime - now + 999) / 1000);
+                MsgWaitForMultipleObjects(0, nullptr, FALSE, timeout, QS_ALLINPUT);
+            }
         }
     }
 
     t.join();
+    CAudioPlayerControl::RemoveQueueFill(&_state.audioQueue.fill);
 
     if (_endEvent != LUA_NOREF)
     {
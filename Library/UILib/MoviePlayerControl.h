@@ -6,8 +6,6 @@
 #define MAX_AUDIOQ_SIZE (5 * 16 * 1024)
 #define MAX_VIDEOQ_SIZE (5 * 256 * 1024)
 
-#define WM_REFRESH_EVENT (WM_USER)
-
 #define AV_SYNC_THRESHOLD 0.01
 #define AV_NOSYNC_THRESHOLD 10.0
 
@@ -35,10 +33,10 @@ extern "C"
 
 #include <string>
 #include <sstream>
+#include <atomic>
 #include <mutex>
 #include <chrono>
 #include <thread>
-#include <queue>
 
 namespace jojogame
 {
@@ -54,6 +52,7 @@ struct PacketQueue
 {
     AVPacketList *firstPacket, *lastPacket;
     int size;
+    std::atomic<int> fill{0};
     std::mutex mutex;
     std::condition_variable cond;
 };
@@ -121,7 +120,7 @@ struct VideoState
     bool finishQueue;
     POINT position;
 
-    std::queue<int> eventQueue;
+    int64_t refreshTime; ///<time (av_gettime) at which the next video refresh is due
 };
 
 class CMoviePlayerControl
@@ -0,0 +1,290 @@
+#include "PerformanceHud.h"
+
+#include "AudioPlayer.h"
+#include "ControlManager.h"
+#include "LayoutControl.h"
+#include "ScaledImageCache.h"
+#include "ToolbarControl.h"
+#include "WindowControl.h"
+#include "BaseLib/Profiler.h"
+
+#include <windowsx.h>
+#include <cwchar>
+
+namespace jojogame
+{
+std::once_flag CPerformanceHud::s_onceFlag;
+std::unique_ptr<CPerformanceHud> CPerformanceHud::s_sharedPerformanceHud;
+
+static const int HUD_WIDTH = 240;
+static const int HUD_TEXT_HEIGHT = 16;
+static const int HUD_TEXT_LINES = 5;
+static const int HUD_GRAPH_HEIGHT = 50;
+static const int HUD_MARGIN = 4;
+
+// 그래프 전체 높이가 두 프레임(33.3ms)을 나타낸다.
+static const int64_t HUD_GRAPH_RANGE = 33333333;
+static const int64_t HUD_FRAME_BUDGET = 16666667;
+
+void CPerformanceHud::RegisterFunctions(lua_State *L)
+{
+    LUA_BEGIN(CPerformanceHud, "_PerformanceHud");
+
+    LUA_METHOD(IsVisible);
+    LUA_METHOD(GetWindow);
+    LUA_METHOD(GetFps);
+    LUA_METHOD(GetDrawTime);
+
+    LUA_METHOD(SetVisible);
+    LUA_METHOD(SetWindow);
+    LUA_METHOD(Toggle);
+}
+
+CPerformanceHud::CPerformanceHud()
+{
+    _backgroundBrush = CreateSolidBrush(RGB(0, 0, 0));
+    _updateBrush = CreateSolidBrush(RGB(80, 160, 255));
+    _renderBrush = CreateSolidBrush(RGB(255, 170, 60));
+    _budgetBrush = CreateSolidBrush(RGB(255, 60, 60));
+}
+
+CPerformanceHud::~CPerformanceHud()
+{
+    DeleteBrush(_backgroundBrush);
+    DeleteBrush(_updateBrush);
+    DeleteBrush(_renderBrush);
+    DeleteBrush(_budgetBrush);
+}
+
+bool CPerformanceHud::IsVisible() const
+{
+    return _isVisible;
+}
+
+CWindowControl *CPerformanceHud::GetWindow()
+{
+    return _window;
+}
+
+double CPerformanceHud::GetFps() const
+{
+    return _fps;
+}
+
+double CPerformanceHud::GetDrawTime() const
+{
+    return _drawTime / 1000000.0;
+}
+
+void CPerformanceHud::SetVisible(bool value)
+{
+    if (_isVisible == value)
+    {
+        return;
+    }
+
+    _isVisible = value;
+    _frameCount = 0;
+    _frameNext = 0;
+    _paintedArea = 0;
+
+    // 숨길 때는 표시가 있던 자리를 레이아웃으로 다시 그린다.
+    if (!_isVisible && _window != nullptr)
+    {
+        RECT rect = _GetRect();
+        InvalidateRect(_window->GetHWnd(), &rect, FALSE);
+    }
+}
+
+void CPerformanceHud::SetWindow(CWindowControl *window)
+{
+    if (_window != nullptr && _window != window && _isVisible)
+    {
+        RECT rect = _GetRect();
+        InvalidateRect(_window->GetHWnd(), &rect, FALSE);
+    }
+
+    _window = window;
+}
+
+void CPerformanceHud::Toggle()
+{
+    SetVisible(!_isVisible);
+}
+
+void CPerformanceHud::AddPaint(CWindowControl *window, const RECT &paintRect)
+{
+    if (!_isVisible)
+    {
+        return;
+    }
+
+    // 창을 지정하지 않았으면 처음 그려지는 창에 붙는다.
+    if (_window == nullptr)
+    {
+        _window = window;
+    }
+
+    // 표시 자체를 다시 그리는 영역은 화면 갱신 비율에 넣지 않는다.
+    if (_window == window && !_isDrawing)
+    {
+        _paintedArea += LONGLONG(paintRect.right - paintRect.left) * (paintRect.bottom - paintRect.top);
+    }
+}
+
+void CPerformanceHud::EndFrame(int64_t updateTime, int64_t renderTime)
+{
+    if (!_isVisible || _window == nullptr)
+    {
+        return;
+    }
+
+    auto &frame = _frames[_frameNext];
+    frame.time = CProfiler::GetNow();
+    frame.updateTime = updateTime;
+    frame.renderTime = renderTime;
+    _frameNext = (_frameNext + 1) % GRAPH_SIZE;
+    _frameCount = _frameCount < GRAPH_SIZE ? _frameCount + 1 : GRAPH_SIZE;
+
+    _Sample();
+
+    // 표시가 더하는 비용은 그리기만이 아니라 강제로 다시 칠하는 전체다.
+    PROFILE_ZONE("Performance HUD");
+    int64_t begin = CProfiler::GetNow();
+
+    _isDrawing = true;
+    RECT rect = _GetRect();
+    InvalidateRect(_window->GetHWnd(), &rect, FALSE);
+    UpdateWindow(_window->GetHWnd());
+    _isDrawing = false;
+
+    _drawTime = CProfiler::GetNow() - begin;
+}
+
+void CPerformanceHud::Draw(HDC destDC, const RECT &paintRect)
+{
+    RECT rect = _GetRect();
+    RECT intersectRect;
+    if (!_isVisible || !IntersectRect(&intersectRect, &rect, &paintRect))
+    {
+        return;
+    }
+
+    FillRect(destDC, &rect, _backgroundBrush);
+
+    wchar_t lines[HUD_TEXT_LINES][64];
+    swprintf(lines[0], 64, L"FPS %.1f   HUD %.3f ms", _fps, _drawTime / 1000000.0);
+    swprintf(lines[1], 64, L"Update %.2f ms   Render %.2f ms", _averageUpdateTime, _averageRenderTime);
+    swprintf(lines[2], 64, L"Lua %d KB   Sprites %d", _luaMemory, _spriteCount);
+    swprintf(lines[3], 64, L"Image cache %.1f MB", _imageCacheMemory);
+    swprintf(lines[4], 64, L"Dirty %.1f %%   Audio %d %%", _dirtyCoverage * 100.0, _audioQueueFill);
+
+    auto oldFont = SelectFont(destDC, GetStockFont(DEFAULT_GUI_FONT));
+    int oldBkMode = SetBkMode(destDC, TRANSPARENT);
+    COLORREF oldTextColor = SetTextColor(destDC, RGB(255, 255, 255));
+    for (int i = 0; i < HUD_TEXT_LINES; ++i)
+    {
+        TextOut(destDC, rect.left + HUD_MARGIN, rect.top + HUD_MARGIN + i * HUD_TEXT_HEIGHT, lines[i],
+                int(wcslen(lines[i])));
+    }
+    SetTextColor(destDC, oldTextColor);
+    SetBkMode(destDC, oldBkMode);
+    SelectFont(destDC, oldFont);
+
+    // 프레임마다 업데이트 시간 위에 렌더 시간을 쌓은 막대를 그린다.
+    int graphLeft = rect.left + HUD_MARGIN;
+    int graphBottom = rect.bottom - HUD_MARGIN;
+    int barWidth = (HUD_WIDTH - HUD_MARGIN * 2) / GRAPH_SIZE;
+    barWidth = barWidth > 0 ? barWidth : 1;
+
+    int budgetY = graphBottom - int(HUD_FRAME_BUDGET * HUD_GRAPH_HEIGHT / HUD_GRAPH_RANGE);
+    RECT budgetRect;
+    SetRect(&budgetRect, graphLeft, budgetY, graphLeft + barWidth * GRAPH_SIZE, budgetY + 1);
+    FillRect(destDC, &budgetRect, _budgetBrush);
+
+    int first = (_frameNext - _frameCount + GRAPH_SIZE) % GRAPH_SIZE;
+    for (int i = 0; i < _frameCount; ++i)
+    {
+        const auto &frame = _frames[(first + i) % GRAPH_SIZE];
+        int64_t updateTime = frame.updateTime < HUD_GRAPH_RANGE ? frame.updateTime : HUD_GRAPH_RANGE;
+        int64_t totalTime = frame.updateTime + frame.renderTime;
+        totalTime = totalTime < HUD_GRAPH_RANGE ? totalTime : HUD_GRAPH_RANGE;
+
+        int x = graphLeft + i * barWidth;
+        int updateY = graphBottom - int(updateTime * HUD_GRAPH_HEIGHT / HUD_GRAPH_RANGE);
+        int totalY = graphBottom - int(totalTime * HUD_GRAPH_HEIGHT / HUD_GRAPH_RANGE);
+
+        RECT bar;
+        SetRect(&bar, x, updateY, x + barWidth, graphBottom);
+        FillRect(destDC, &bar, _updateBrush);
+        SetRect(&bar, x, totalY, x + barWidth, updateY);
+        FillRect(destDC, &bar, _renderBrush);
+    }
+}
+
+void CPerformanceHud::SetHudFlag(bool flag)
+{
+    CPerformanceHud::GetInstance().SetVisible(flag);
+}
+
+CPerformanceHud &CPerformanceHud::GetInstance()
+{
+    std::call_once(s_onceFlag,
+                   [] {
+                       s_sharedPerformanceHud = std::make_unique<jojogame::CPerformanceHud>();
+                   });
+
+    return *s_sharedPerformanceHud;
+}
+
+RECT CPerformanceHud::_GetRect() const
+{
+    int top = HUD_MARGIN;
+    auto toolbar = _window != nullptr ? _window->GetToolbar() : nullptr;
+    if (toolbar)
+    {
+        top += toolbar->GetHeight();
+    }
+
+    RECT rect;
+    SetRect(&rect, HUD_MARGIN, top, HUD_MARGIN + HUD_WIDTH,
+            top + HUD_MARGIN * 3 + HUD_TEXT_LINES * HUD_TEXT_HEIGHT + HUD_GRAPH_HEIGHT);
+    return rect;
+}
+
+void CPerformanceHud::_Sample()
+{
+    int first = (_frameNext - _frameCount + GRAPH_SIZE) % GRAPH_SIZE;
+    int last = (_frameNext - 1 + GRAPH_SIZE) % GRAPH_SIZE;
+    int64_t elapsed = _frames[last].time - _frames[first].time;
+    _fps = _frameCount > 1 && elapsed > 0 ? (_frameCount - 1) * 1000000000.0 / elapsed : 0.0;
+
+    int64_t updateTime = 0;
+    int64_t renderTime = 0;
+    for (int i = 0; i < _frameCount; ++i)
+    {
+        updateTime += _frames[i].updateTime;
+        renderTime += _frames[i].renderTime;
+    }
+    _averageUpdateTime = updateTime / 1000000.0 / _frameCount;
+    _averageRenderTime = renderTime / 1000000.0 / _frameCount;
+
+    RECT clientRect;
+    GetClientRect(_window->GetHWnd(), &clientRect);
+    LONGLONG clientArea = LONGLONG(clientRect.right - clientRect.left) * (clientRect.bottom - clientRect.top);
+    _dirtyCoverage = clientArea > 0 ? double(_paintedArea) / clientArea : 0.0;
+    _paintedArea = 0;
+
+    auto l = CLuaTinker::GetLuaTinker().GetMainLuaState();
+    _luaMemory = lua_gc(l, LUA_GCCOUNT, 0);
+
+    _spriteCount = 0;
+    for (auto layout : CControlManager::GetInstance().GetLayouts())
+    {
+        _spriteCount += layout->GetImageCount();
+    }
+
+    _imageCacheMemory = CScaledImageCache::GetInstance().GetUsedMemory();
+    _audioQueueFill = CAudioPlayerControl::GetQueueFill();
+}
+} // namespace jojogame
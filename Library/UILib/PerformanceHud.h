@@ -0,0 +1,79 @@
+#pragma once
+
+#include "LuaLib\LuaTinker.h"
+
+#include <Windows.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace jojogame
+{
+class CWindowControl;
+
+// 엔진 카운터를 모아 창의 맨 위 레이어에 그리는 성능 표시
+class CPerformanceHud
+{
+public:
+    static const int GRAPH_SIZE = 120;
+
+    static void RegisterFunctions(lua_State *L);
+
+    CPerformanceHud();
+    virtual ~CPerformanceHud();
+
+    bool IsVisible() const;
+    CWindowControl *GetWindow();
+    double GetFps() const;
+    double GetDrawTime() const;
+
+    void SetVisible(bool value);
+    void SetWindow(CWindowControl *window);
+    void Toggle();
+
+    void AddPaint(CWindowControl *window, const RECT &paintRect);
+    void EndFrame(int64_t updateTime, int64_t renderTime);
+    void Draw(HDC destDC, const RECT &paintRect);
+
+    static void SetHudFlag(bool flag);
+    static CPerformanceHud &GetInstance();
+
+private:
+    struct FrameSample
+    {
+        int64_t time;
+        int64_t updateTime;
+        int64_t renderTime;
+    };
+
+    RECT _GetRect() const;
+    void _Sample();
+
+    bool _isVisible = false;
+    bool _isDrawing = false;
+    CWindowControl *_window = nullptr;
+
+    FrameSample _frames[GRAPH_SIZE]{};
+    int _frameCount = 0;
+    int _frameNext = 0;
+
+    LONGLONG _paintedArea = 0;
+    double _dirtyCoverage = 0.0;
+    double _fps = 0.0;
+    double _averageUpdateTime = 0.0;
+    double _averageRenderTime = 0.0;
+    int _luaMemory = 0;
+    int _spriteCount = 0;
+    double _imageCacheMemory = 0.0;
+    int _audioQueueFill = 0;
+    int64_t _drawTime = 0;
+
+    HBRUSH _backgroundBrush;
+    HBRUSH _updateBrush;
+    HBRUSH _renderBrush;
+    HBRUSH _budgetBrush;
+
+    static std::once_flag s_onceFlag;
+    static std::unique_ptr<CPerformanceHud> s_sharedPerformanceHud;
+};
+} // namespace jojogame
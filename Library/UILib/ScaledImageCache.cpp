@@ -0,0 +1,299 @@
+#include "ScaledImageCache.h"
+
+#include "ImageControl.h"
+#include "BaseLib/FrameBuffer.h"
+
+#include <windowsx.h>
+#include <tuple>
+#include <vector>
+
+namespace jojogame
+{
+std::once_flag CScaledImageCache::s_onceFlag;
+std::unique_ptr<CScaledImageCache> CScaledImageCache::s_sharedScaledImageCache;
+
+bool ScaledImageKey::operator<(const ScaledImageKey &other) const
+{
+    return std::tie(image, isMirror, clipingRect.left, clipingRect.top, clipingRect.right, clipingRect.bottom, ratioX,
+                    ratioY, lookup) < std::tie(other.image, other.isMirror, other.clipingRect.left,
+                                               other.clipingRect.top, other.clipingRect.right,
+                                               other.clipingRect.bottom, other.ratioX, other.ratioY, other.lookup);
+}
+
+void CScaledImageCache::RegisterFunctions(lua_State *L)
+{
+    LUA_BEGIN(CScaledImageCache, "_ScaledImageCache");
+
+    LUA_METHOD(GetMemoryLimit);
+    LUA_METHOD(GetUsedMemory);
+    LUA_METHOD(IsHighQuality);
+
+    LUA_METHOD(SetMemoryLimit);
+    LUA_METHOD(SetHighQuality);
+
+    LUA_METHOD(Clear);
+}
+
+CScaledImageCache::CScaledImageCache()
+{
+    _imageDC = CreateCompatibleDC(nullptr);
+    _maskDC = CreateCompatibleDC(nullptr);
+}
+
+CScaledImageCache::~CScaledImageCache()
+{
+    Clear();
+
+    DeleteDC(_imageDC);
+    DeleteDC(_maskDC);
+}
+
+int CScaledImageCache::GetMemoryLimit() const
+{
+    return int(_memoryLimit / (1024 * 1024));
+}
+
+// 한도와 같은 MB 단위로 돌려준다.
+double CScaledImageCache::GetUsedMemory() const
+{
+    return _usedMemory / (1024.0 * 1024.0);
+}
+
+bool CScaledImageCache::IsHighQuality() const
+{
+    return _isHighQuality;
+}
+
+void CScaledImageCache::SetMemoryLimit(int megabytes)
+{
+    _memoryLimit = megabytes > 0 ? size_t(megabytes) * 1024 * 1024 : 0;
+    _Trim(0);
+}
+
+void CScaledImageCache::SetHighQuality(bool value)
+{
+    if (_isHighQuality != value)
+    {
+        _isHighQuality = value;
+        Clear();
+    }
+}
+
+const ScaledImage *CScaledImageCache::GetScaledImage(HDC destDC, HDC sourceDC, CImageControl *image, double ratioX,
+                                                     double ratioY, const std::shared_ptr<const PixelLookup> &lookup)
+{
+    ScaledImageKey key;
+    key.image = image;
+    key.isMirror = image->IsDisplayMirror();
+    SetRect(&key.clipingRect, image->GetClipingLeft(), image->GetClipingTop(),
+            image->GetClipingLeft() + image->GetClipingWidth(), image->GetClipingTop() + image->GetClipingHeight());
+    key.ratioX = ratioX;
+    key.ratioY = ratioY;
+    key.lookup = lookup.get();
+
+    auto iter = _cacheMap.find(key);
+    if (iter != _cacheMap.end())
+    {
+        _cacheList.splice(_cacheList.begin(), _cacheList, iter->second);
+        return &iter->second->second;
+    }
+
+    int width = int(image->GetClipingWidth() * ratioX);
+    int height = int(image->GetClipingHeight() * ratioY);
+    if (width <= 0 || height <= 0)
+    {
+        return nullptr;
+    }
+
+    ScaledImage scaledImage = _CreateScaledImage(destDC, sourceDC, image, width, height);
+    if (scaledImage.image == nullptr || scaledImage.mask == nullptr)
+    {
+        _DeleteScaledImage(scaledImage);
+        return nullptr;
+    }
+
+    // 밝기/색조는 늘린 이미지에 미리 입혀서 같은 표를 쓰는 동안 다시 계산하지 않는다.
+    if (lookup != nullptr)
+    {
+        _ApplyLookup(scaledImage, *lookup);
+        scaledImage.lookup = lookup;
+    }
+
+    // 한도보다 큰 이미지는 캐시를 비우지 않고 이번 그리기에만 쓴 뒤 다음 요청에서 지운다.
+    if (scaledImage.byteSize > _memoryLimit)
+    {
+        _DeleteScaledImage(_uncachedImage);
+        _uncachedImage = scaledImage;
+        return &_uncachedImage;
+    }
+
+    _Trim(scaledImage.byteSize);
+
+    _cacheList.emplace_front(key, scaledImage);
+    _cacheMap[key] = _cacheList.begin();
+    _usedMemory += scaledImage.byteSize;
+
+    return &_cacheList.front().second;
+}
+
+void CScaledImageCache::Draw(HDC destDC, const ScaledImage *scaledImage, int x, int y, int width, int height,
+                             int srcX, int srcY)
+{
+    auto oldImage = SelectBitmap(_imageDC, scaledImage->image);
+    auto oldMask = SelectBitmap(_maskDC, scaledImage->mask);
+
+    BitBlt(destDC, x, y, width, height, _imageDC, srcX, srcY, SRCINVERT);
+    BitBlt(destDC, x, y, width, height, _maskDC, srcX, srcY, SRCAND);
+    BitBlt(destDC, x, y, width, height, _imageDC, srcX, srcY, SRCINVERT);
+
+    SelectBitmap(_maskDC, oldMask);
+    SelectBitmap(_imageDC, oldImage);
+}
+
+void CScaledImageCache::Invalidate(CImageControl *image)
+{
+    auto iter = _cacheList.begin();
+    while (iter != _cacheList.end())
+    {
+        if (iter->first.image == image)
+        {
+            _usedMemory -= iter->second.byteSize;
+            _DeleteScaledImage(iter->second);
+            _cacheMap.erase(iter->first);
+            iter = _cacheList.erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+}
+
+void CScaledImageCache::Clear()
+{
+    for (auto &cache : _cacheList)
+    {
+        _DeleteScaledImage(cache.second);
+    }
+
+    _cacheList.clear();
+    _cacheMap.clear();
+    _usedMemory = 0;
+
+    _DeleteScaledImage(_uncachedImage);
+}
+
+CScaledImageCache &CScaledImageCache::GetInstance()
+{
+    std::call_once(s_onceFlag,
+                   [] {
+                       s_sharedScaledImageCache = std::make_unique<jojogame::CScaledImageCache>();
+                   });
+
+    return *s_sharedScaledImageCache;
+}
+
+ScaledImage CScaledImageCache::_CreateScaledImage(HDC destDC, HDC sourceDC, CImageControl *image, int width,
+                                                  int height)
+{
+    ScaledImage scaledImage;
+    scaledImage.size.cx = width;
+    scaledImage.size.cy = height;
+    scaledImage.image = CreateCompatibleBitmap(destDC, width, height);
+    scaledImage.mask = CreateBitmap(width, height, 1, 1, nullptr);
+    scaledImage.byteSize = size_t(width) * height * 4 + size_t((width + 15) / 16 * 2) * height;
+
+    if (scaledImage.image == nullptr || scaledImage.mask == nullptr)
+    {
+        return scaledImage;
+    }
+
+    auto oldImage = SelectBitmap(_imageDC, scaledImage.image);
+    auto oldMask = SelectBitmap(_maskDC, scaledImage.mask);
+
+    // HALFTONE 은 색을 섞기 때문에 마스크는 항상 원본 마스크를 COLORONCOLOR 로 늘려서 만든다.
+    if (_isHighQuality)
+    {
+        SetStretchBltMode(_imageDC, HALFTONE);
+        SetBrushOrgEx(_imageDC, 0, 0, nullptr);
+    }
+    else
+    {
+        SetStretchBltMode(_imageDC, COLORONCOLOR);
+    }
+    StretchBlt(_imageDC, 0, 0, width, height, sourceDC, image->GetClipingLeft(), image->GetClipingTop(),
+               image->GetClipingWidth(), image->GetClipingHeight(), SRCCOPY);
+
+    HDC sourceMaskDC = CreateCompatibleDC(nullptr);
+    HBITMAP sourceMask = image->IsDisplayMirror() ? image->GetMaskMirrorImageHandle() : image->GetMaskImageHandle();
+    auto oldSourceMask = SelectBitmap(sourceMaskDC, sourceMask);
+
+    SetStretchBltMode(_maskDC, COLORONCOLOR);
+    StretchBlt(_maskDC, 0, 0, width, height, sourceMaskDC, image->GetClipingLeft(), image->GetClipingTop(),
+               image->GetClipingWidth(), image->GetClipingHeight(), SRCCOPY);
+
+    SelectBitmap(sourceMaskDC, oldSourceMask);
+    DeleteDC(sourceMaskDC);
+
+    SelectBitmap(_maskDC, oldMask);
+    SelectBitmap(_imageDC, oldImage);
+
+    return scaledImage;
+}
+
+void CScaledImageCache::_ApplyLookup(ScaledImage &scaledImage, const PixelLookup &lookup)
+{
+    int width = scaledImage.size.cx;
+    int height = scaledImage.size.cy;
+
+    BITMAPINFO info{};
+    info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    info.bmiHeader.biWidth = width;
+    info.bmiHeader.biHeight = -height;
+    info.bmiHeader.biPlanes = 1;
+    info.bmiHeader.biBitCount = 32;
+    info.bmiHeader.biCompression = BI_RGB;
+
+    // 마스크로 가려지는 픽셀은 어떤 값이든 화면에 남지 않으므로 전체를 바꿔도 된다.
+    std::vector<uint32_t> pixels(size_t(width) * height);
+    if (GetDIBits(_imageDC, scaledImage.image, 0, height, pixels.data(), &info, DIB_RGB_COLORS) == 0)
+    {
+        return;
+    }
+
+    for (auto &pixel : pixels)
+    {
+        pixel = (pixel & 0xFF000000) | (uint32_t(lookup.red[(pixel >> 16) & 0xFF]) << 16) |
+                (uint32_t(lookup.green[(pixel >> 8) & 0xFF]) << 8) | lookup.blue[pixel & 0xFF];
+    }
+
+    SetDIBits(_imageDC, scaledImage.image, 0, height, pixels.data(), &info, DIB_RGB_COLORS);
+}
+
+void CScaledImageCache::_DeleteScaledImage(ScaledImage &scaledImage)
+{
+    if (scaledImage.image != nullptr)
+    {
+        DeleteBitmap(scaledImage.image);
+        scaledImage.image = nullptr;
+    }
+    if (scaledImage.mask != nullptr)
+    {
+        DeleteBitmap(scaledImage.mask);
+        scaledImage.mask = nullptr;
+    }
+    scaledImage.lookup.reset();
+}
+
+void CScaledImageCache::_Trim(size_t reserveBytes)
+{
+    while (!_cacheList.empty() && _usedMemory + reserveBytes > _memoryLimit)
+    {
+        auto &last = _cacheList.back();
+        _usedMemory -= last.second.byteSize;
+        _DeleteScaledImage(last.second);
+        _cacheMap.erase(last.first);
+        _cacheList.pop_back();
+    }
+}
+} // namespace jojogame
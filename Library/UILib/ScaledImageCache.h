@@ -0,0 +1,89 @@
+#pragma once
+
+#include "LuaLib\LuaTinker.h"
+
+#include <Windows.h>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace jojogame
+{
+class CImageControl;
+struct PixelLookup;
+
+struct ScaledImageKey
+{
+    CImageControl *image;
+    bool isMirror;
+    RECT clipingRect;
+    double ratioX;
+    double ratioY;
+    const PixelLookup *lookup;
+
+    bool operator<(const ScaledImageKey &other) const;
+};
+
+struct ScaledImage
+{
+    HBITMAP image;
+    HBITMAP mask;
+    SIZE size;
+    size_t byteSize;
+
+    // 캐시에 있는 동안 같은 주소에 다른 표가 만들어지지 않도록 붙잡아 둔다.
+    std::shared_ptr<const PixelLookup> lookup;
+};
+
+class CScaledImageCache
+{
+public:
+    static void RegisterFunctions(lua_State *L);
+
+    CScaledImageCache();
+    virtual ~CScaledImageCache();
+
+    int GetMemoryLimit() const;
+    double GetUsedMemory() const;
+    bool IsHighQuality() const;
+
+    void SetMemoryLimit(int megabytes);
+    void SetHighQuality(bool value);
+
+    const ScaledImage *GetScaledImage(HDC destDC, HDC sourceDC, CImageControl *image, double ratioX,
+                                      double ratioY, const std::shared_ptr<const PixelLookup> &lookup = nullptr);
+    void Draw(HDC destDC, const ScaledImage *scaledImage, int x, int y, int width, int height, int srcX, int srcY);
+
+    void Invalidate(CImageControl *image);
+    void Clear();
+
+    static CScaledImageCache &GetInstance();
+
+private:
+    typedef std::list<std::pair<ScaledImageKey, ScaledImage>> CacheList;
+
+    ScaledImage _CreateScaledImage(HDC destDC, HDC sourceDC, CImageControl *image, int width, int height);
+    void _ApplyLookup(ScaledImage &scaledImage, const PixelLookup &lookup);
+    void _DeleteScaledImage(ScaledImage &scaledImage);
+    void _Trim(size_t reserveBytes);
+
+    CacheList _cacheList;
+    std::map<ScaledImageKey, CacheList::iterator> _cacheMap;
+    ScaledImage _uncachedImage{};
+
+    HDC _imageDC;
+    HDC _maskDC;
+
+    size_t _memoryLimit = 64 * 1024 * 1024;
+    size_t _usedMemory = 0;
+#ifdef JOJO_SCALED_IMAGE_HALFTONE
+    bool _isHighQuality = true;
+#else
+    bool _isHighQuality = false;
+#endif
+
+    static std::once_flag s_onceFlag;
+    static std::unique_ptr<CScaledImageCache> s_sharedScaledImageCache;
+};
+} // namespace jojogame
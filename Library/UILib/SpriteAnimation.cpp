@@ -0,0 +1,195 @@
+#include "SpriteAnimation.h"
+
+#include "AnimationManager.h"
+#include "LayoutControl.h"
+
+namespace jojogame
+{
+void CSpriteAnimation::RegisterFunctions(lua_State *L)
+{
+    LUA_BEGIN(CSpriteAnimation, "_SpriteAnimation");
+
+    LUA_METHOD(GetLayout);
+    LUA_METHOD(GetMode);
+    LUA_METHOD(GetFrameCount);
+    LUA_METHOD(GetCurrentFrame);
+    LUA_METHOD(IsPlaying);
+
+    LUA_METHOD(SetLayout);
+    LUA_METHOD(SetMode);
+    LUA_METHOD(SetEndEvent);
+
+    LUA_METHOD(AddFrame);
+    LUA_METHOD(ClearFrames);
+
+    LUA_METHOD(Play);
+    LUA_METHOD(Stop);
+
+    lua_tinker::set(L, "ANIMATION_ONCE", static_cast<int>(ANIMATION_ONCE));
+    lua_tinker::set(L, "ANIMATION_LOOP", static_cast<int>(ANIMATION_LOOP));
+    lua_tinker::set(L, "ANIMATION_PINGPONG", static_cast<int>(ANIMATION_PINGPONG));
+}
+
+CSpriteAnimation::CSpriteAnimation()
+{
+}
+
+CSpriteAnimation::~CSpriteAnimation()
+{
+    CAnimationManager::GetInstance().RemoveAnimation(this);
+}
+
+CLayoutControl *CSpriteAnimation::GetLayout()
+{
+    return _layout;
+}
+
+int CSpriteAnimation::GetMode() const
+{
+    return _mode;
+}
+
+int CSpriteAnimation::GetFrameCount() const
+{
+    return static_cast<int>(_frames.size());
+}
+
+int CSpriteAnimation::GetCurrentFrame() const
+{
+    return _currentFrame;
+}
+
+int CSpriteAnimation::GetEndEvent() const
+{
+    return _endEvent;
+}
+
+bool CSpriteAnimation::IsPlaying() const
+{
+    return _isPlaying;
+}
+
+void CSpriteAnimation::SetLayout(CLayoutControl *layout)
+{
+    _layout = layout;
+}
+
+void CSpriteAnimation::SetMode(int mode)
+{
+    _mode = mode;
+}
+
+void CSpriteAnimation::SetEndEvent()
+{
+    auto l = CLuaTinker::GetLuaTinker().GetLuaState();
+    if (lua_isfunction(l, -1))
+    {
+        lua_pushvalue(l, -1);
+        _endEvent = luaL_ref(l, LUA_REGISTRYINDEX);
+    }
+
+    lua_pop(l, 1);
+}
+
+void CSpriteAnimation::AddFrame(int imageIndex, int duration)
+{
+    _frames.push_back(AnimationFrame{imageIndex, duration > 0 ? duration : 1});
+}
+
+void CSpriteAnimation::ClearFrames()
+{
+    Stop();
+    _frames.clear();
+    _currentFrame = 0;
+}
+
+void CSpriteAnimation::Play()
+{
+    if (_layout == nullptr || _frames.empty())
+    {
+        return;
+    }
+
+    for (auto &frame : _frames)
+    {
+        _layout->HideImage(frame.imageIndex, false);
+    }
+
+    _currentFrame = 0;
+    _direction = 1;
+    _elapsed = 0;
+    _ShowFrame(0);
+
+    _isPlaying = true;
+    CAnimationManager::GetInstance().AddAnimation(this);
+}
+
+void CSpriteAnimation::Stop()
+{
+    _isPlaying = false;
+}
+
+void CSpriteAnimation::Update(int elapsed)
+{
+    if (!_isPlaying)
+    {
+        return;
+    }
+
+    int frameCount = static_cast<int>(_frames.size());
+    int nextFrame = _currentFrame;
+    bool isEnd = false;
+
+    _elapsed += elapsed;
+    while (_elapsed >= _frames[nextFrame].duration)
+    {
+        _elapsed -= _frames[nextFrame].duration;
+
+        if (_mode == ANIMATION_LOOP)
+        {
+            nextFrame = (nextFrame + 1) % frameCount;
+        }
+        else if (_mode == ANIMATION_PINGPONG)
+        {
+            if (frameCount > 1)
+            {
+                if (nextFrame + _direction < 0 || nextFrame + _direction >= frameCount)
+                {
+                    _direction = -_direction;
+                }
+                nextFrame += _direction;
+            }
+        }
+        else
+        {
+            if (nextFrame + 1 >= frameCount)
+            {
+                isEnd = true;
+                break;
+            }
+            ++nextFrame;
+        }
+    }
+
+    if (nextFrame != _currentFrame)
+    {
+        _layout->HideImage(_frames[_currentFrame].imageIndex, false);
+        _ShowFrame(nextFrame);
+    }
+
+    if (isEnd)
+    {
+        _isPlaying = false;
+        if (_endEvent != LUA_NOREF)
+        {
+            CLuaTinker::GetLuaTinker().Call(_endEvent, this);
+        }
+    }
+}
+
+void CSpriteAnimation::_ShowFrame(int frame)
+{
+    _currentFrame = frame;
+    _layout->ShowImage(_frames[frame].imageIndex, false);
+}
+} // namespace jojogame
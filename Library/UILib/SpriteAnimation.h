@@ -0,0 +1,65 @@
+#pragma once
+
+#include "LuaLib\LuaTinker.h"
+
+#include <vector>
+
+namespace jojogame
+{
+class CLayoutControl;
+
+enum ANIMATION_MODE
+{
+    ANIMATION_ONCE = 0,
+    ANIMATION_LOOP = 1,
+    ANIMATION_PINGPONG = 2,
+};
+
+struct AnimationFrame
+{
+    int imageIndex;
+    int duration;
+};
+
+class CSpriteAnimation
+{
+public:
+    static void RegisterFunctions(lua_State *L);
+
+    CSpriteAnimation();
+    virtual ~CSpriteAnimation();
+
+    CLayoutControl *GetLayout();
+    int GetMode() const;
+    int GetFrameCount() const;
+    int GetCurrentFrame() const;
+    int GetEndEvent() const;
+    bool IsPlaying() const;
+
+    void SetLayout(CLayoutControl *layout);
+    void SetMode(int mode);
+    void SetEndEvent();
+
+    void AddFrame(int imageIndex, int duration);
+    void ClearFrames();
+
+    void Play();
+    void Stop();
+
+    void Update(int elapsed);
+
+private:
+    void _ShowFrame(int frame);
+
+    CLayoutControl *_layout = nullptr;
+    std::vector<AnimationFrame> _frames;
+
+    int _mode = ANIMATION_ONCE;
+    int _currentFrame = 0;
+    int _direction = 1;
+    int _elapsed = 0;
+    bool _isPlaying = false;
+
+    int _endEvent = LUA_NOREF;
+};
+} // namespace jojogame
@@ -1,5 +1,6 @@
 #include "TextFont.h"
 #include "BaseControl.h"
+#include "FontCache.h"
 
 namespace jojogame
 {
@@ -42,7 +43,7 @@ CTextFont::~CTextFont()
 {
     if (_font != nullptr)
     {
-        DeleteFont(_font);
+        CFontCache::GetInstance().Release(_font);
         _font = nullptr;
     }
 }
@@ -52,6 +53,11 @@ HFONT CTextFont::GetHFont() const
     return _font;
 }
 
+int CTextFont::GetVersion() const
+{
+    return _version;
+}
+
 bool CTextFont::IsBold() const
 {
     return _isBold;
@@ -109,26 +115,14 @@ void CTextFont::SetFontName(std::wstring fontName)
 
 void CTextFont::ResetFont()
 {
+    // 같은 글꼴이면 핸들을 새로 만들지 않도록 먼저 얻고 나중에 놓는다.
+    HFONT font = CFontCache::GetInstance().Acquire(FontKey{_fontName, _fontSize, _isBold, _isItalic, _isUnderline});
     if (_font != nullptr)
     {
-        DeleteFont(_font);
-        _font = nullptr;
+        CFontCache::GetInstance().Release(_font);
     }
-
-    _font = CreateFontW(_fontSize,
-                        0,
-                        0,
-                        0,
-                        FW_NORMAL,
-                        static_cast<DWORD>(_isItalic),
-                        static_cast<DWORD>(_isUnderline),
-                        static_cast<DWORD>(_isBold),
-                        HANGEUL_CHARSET,
-                        0,
-                        0,
-                        0,
-                        VARIABLE_PITCH | FF_ROMAN,
-                        _fontName.c_str());
+    _font = font;
+    ++_version;
 
     if (_control)
     {
@@ -19,6 +19,7 @@ public:
     virtual ~CTextFont();
 
     HFONT GetHFont() const;
+    int GetVersion() const;
 
     bool IsBold() const;
     bool IsItalic() const;
@@ -38,6 +39,7 @@ protected:
     CBaseControl *_control = nullptr;
 
     HFONT _font = nullptr;
+    int _version = 0;
     bool _isBold = false;
     bool _isItalic = false;
     bool _isUnderline = false;
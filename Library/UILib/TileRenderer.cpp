@@ -0,0 +1,178 @@
+#include "TileRenderer.h"
+
+#include "LayoutControl.h"
+#include "BaseLib\GlyphAtlas.h"
+
+namespace jojogame
+{
+std::once_flag CTileRenderer::s_onceFlag;
+std::unique_ptr<CTileRenderer> CTileRenderer::s_sharedTileRenderer;
+
+void CTileRenderer::RegisterFunctions(lua_State *L)
+{
+    LUA_BEGIN(CTileRenderer, "_TileRenderer");
+
+    LUA_METHOD(GetThreadCount);
+    LUA_METHOD(GetTileSize);
+    LUA_METHOD(GetLastTileCount);
+    LUA_METHOD(GetLastCommandCount);
+
+    LUA_METHOD(SetTileSize);
+}
+
+CTileRenderer::CTileRenderer()
+{
+}
+
+CTileRenderer::~CTileRenderer()
+{
+}
+
+int CTileRenderer::GetThreadCount() const
+{
+    return CJobSystem::GetInstance().GetThreadCount();
+}
+
+int CTileRenderer::GetTileSize() const
+{
+    return _tileSize;
+}
+
+int CTileRenderer::GetLastTileCount() const
+{
+    return _tileCount;
+}
+
+int CTileRenderer::GetLastCommandCount() const
+{
+    return static_cast<int>(_commands.size());
+}
+
+void CTileRenderer::SetTileSize(int tileSize)
+{
+    _tileSize = tileSize < 16 ? 16 : tileSize;
+}
+
+bool CTileRenderer::Render(HDC destDC, const RECT &paintRect, const std::vector<CLayoutControl *> &layouts,
+                           COLORREF backgroundColor, bool isBackgroundCovered)
+{
+    // 위에서 아래로 쌓인 32비트 DIB 섹션에 그릴 때만 픽셀을 직접 쓴다.
+    DIBSECTION dibSection;
+    HGDIOBJ bitmap = GetCurrentObject(destDC, OBJ_BITMAP);
+    if (bitmap == nullptr || GetObject(bitmap, sizeof(DIBSECTION), &dibSection) != sizeof(DIBSECTION) ||
+        dibSection.dsBm.bmBitsPixel != 32 || dibSection.dsBmih.biHeight >= 0 || dibSection.dsBm.bmBits == nullptr)
+    {
+        return false;
+    }
+
+    // 그리기 명령은 UI 스레드에서 모두 만들어 두고, 작업 스레드는 명령과 픽셀만 읽는다.
+    _commands.clear();
+    for (auto layout : layouts)
+    {
+        if (!layout->BuildRasterCommands(_commands, paintRect))
+        {
+            return false;
+        }
+    }
+
+    FrameRect paintFrame{paintRect.left, paintRect.top, paintRect.right, paintRect.bottom};
+    int firstColumn = paintRect.left / _tileSize;
+    int firstRow = paintRect.top / _tileSize;
+    int columnCount = (paintRect.right + _tileSize - 1) / _tileSize - firstColumn;
+    int rowCount = (paintRect.bottom + _tileSize - 1) / _tileSize - firstRow;
+    if (columnCount <= 0 || rowCount <= 0)
+    {
+        return true;
+    }
+
+    _tileCount = columnCount * rowCount;
+    if (static_cast<int>(_tiles.size()) < _tileCount)
+    {
+        _tiles.resize(_tileCount);
+    }
+
+    for (int row = 0; row < rowCount; ++row)
+    {
+        for (int column = 0; column < columnCount; ++column)
+        {
+            auto &tile = _tiles[row * columnCount + column];
+            FrameRect tileRect{(firstColumn + column) * _tileSize, (firstRow + row) * _tileSize,
+                               (firstColumn + column + 1) * _tileSize, (firstRow + row + 1) * _tileSize};
+            CFrameBuffer::IntersectFrameRect(tile.rect, tileRect, paintFrame);
+            tile.commands.clear();
+        }
+    }
+
+    // 명령이 걸치는 타일에만 순서대로 넣어서 타일마다 그리기 목록을 만든다.
+    for (int i = 0; i < static_cast<int>(_commands.size()); ++i)
+    {
+        auto &bounds = _commands[i].bounds;
+        int left = bounds.left / _tileSize - firstColumn;
+        int top = bounds.top / _tileSize - firstRow;
+        int right = (bounds.right - 1) / _tileSize - firstColumn;
+        int bottom = (bounds.bottom - 1) / _tileSize - firstRow;
+
+        for (int row = top < 0 ? 0 : top; row <= bottom && row < rowCount; ++row)
+        {
+            for (int column = left < 0 ? 0 : left; column <= right && column < columnCount; ++column)
+            {
+                _tiles[row * columnCount + column].commands.push_back(i);
+            }
+        }
+    }
+
+    GdiFlush();
+
+    CFrameBuffer target(static_cast<uint32_t *>(dibSection.dsBm.bmBits), dibSection.dsBm.bmWidth,
+                        -dibSection.dsBmih.biHeight, dibSection.dsBm.bmWidthBytes / 4);
+    uint32_t background = (GetRValue(backgroundColor) << 16) | (GetGValue(backgroundColor) << 8) |
+                          GetBValue(backgroundColor);
+
+    // 타일끼리는 픽셀이 겹치지 않으므로 스레드 수와 상관없이 결과가 같다.
+    CJobSystem::GetInstance().ParallelFor(_tileCount, [this, &target, background, isBackgroundCovered](int index)
+    {
+        _RenderTile(target, _tiles[index], background, isBackgroundCovered);
+    });
+
+    return true;
+}
+
+CTileRenderer &CTileRenderer::GetInstance()
+{
+    std::call_once(s_onceFlag,
+                   [] {
+                       s_sharedTileRenderer = std::make_unique<jojogame::CTileRenderer>();
+                   });
+
+    return *s_sharedTileRenderer;
+}
+
+void CTileRenderer::_RenderTile(CFrameBuffer &target, const Tile &tile, uint32_t backgroundColor,
+                                bool isBackgroundCovered)
+{
+    if (!isBackgroundCovered)
+    {
+        target.FillRect(tile.rect, backgroundColor);
+    }
+
+    for (auto index : tile.commands)
+    {
+        auto &command = _commands[index];
+        FrameRect clipingRect;
+        if (!CFrameBuffer::IntersectFrameRect(clipingRect, command.bounds, tile.rect))
+        {
+            continue;
+        }
+
+        if (command.type == RASTER_IMAGE)
+        {
+            target.DrawImage(*command.image, command.sourceX, command.sourceY, command.bounds, command.alpha,
+                             clipingRect, command.lookup);
+        }
+        else if (command.type == RASTER_TEXT)
+        {
+            command.atlas->DrawString(target, command.x, command.y, command.text, command.color, clipingRect);
+        }
+    }
+}
+} // namespace jojogame
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "BaseLib\FrameBuffer.h"
+#include "BaseLib\JobSystem.h"
+#include "LuaLib\LuaTinker.h"
+
+#include <Windows.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace jojogame
+{
+class CGlyphAtlas;
+class CLayoutControl;
+
+enum RASTER_COMMAND_TYPE
+{
+    RASTER_IMAGE = 0,
+    RASTER_TEXT = 1,
+};
+
+// 레이아웃을 소프트웨어로 그릴 때 쓰는 그리기 명령 하나 (bounds 는 이미 클리핑된 영역)
+struct RasterCommand
+{
+    int type;
+    FrameRect bounds;
+    const CFrameBuffer *image;
+    int sourceX;
+    int sourceY;
+    BYTE alpha;
+    const PixelLookup *lookup;
+    CGlyphAtlas *atlas;
+    std::wstring text;
+    int x;
+    int y;
+    uint32_t color;
+};
+
+class CTileRenderer
+{
+public:
+    static void RegisterFunctions(lua_State *L);
+
+    CTileRenderer();
+    virtual ~CTileRenderer();
+
+    int GetThreadCount() const;
+    int GetTileSize() const;
+    int GetLastTileCount() const;
+    int GetLastCommandCount() const;
+
+    void SetTileSize(int tileSize);
+
+    bool Render(HDC destDC, const RECT &paintRect, const std::vector<CLayoutControl *> &layouts,
+                COLORREF backgroundColor, bool isBackgroundCovered);
+
+    static CTileRenderer &GetInstance();
+
+private:
+    struct Tile
+    {
+        FrameRect rect;
+        std::vector<int> commands;
+    };
+
+    void _RenderTile(CFrameBuffer &target, const Tile &tile, uint32_t backgroundColor, bool isBackgroundCovered);
+
+    int _tileSize = 128;
+
+    std::vector<RasterCommand> _commands;
+    std::vector<Tile> _tiles;
+    int _tileCount = 0;
+
+    static std::once_flag s_onceFlag;
+    static std::unique_ptr<CTileRenderer> s_sharedTileRenderer;
+};
+} // namespace jojogame
@@ -0,0 +1,506 @@
+#include "Tween.h"
+
+#include "AnimationManager.h"
+#include "LayoutControl.h"
+
+#include <cmath>
+
+namespace jojogame
+{
+void CTween::RegisterFunctions(lua_State *L)
+{
+    LUA_BEGIN(CTween, "_Tween");
+
+    LUA_METHOD(GetType);
+    LUA_METHOD(GetDuration);
+    LUA_METHOD(GetDelay);
+    LUA_METHOD(GetEasing);
+    LUA_METHOD(IsPlaying);
+
+    LUA_METHOD(SetLayoutTarget);
+    LUA_METHOD(SetImageTarget);
+    LUA_METHOD(SetTextTarget);
+    LUA_METHOD(SetDuration);
+    LUA_METHOD(SetDelay);
+    LUA_METHOD(SetEasing);
+    LUA_METHOD(SetEndEvent);
+
+    LUA_METHOD(MoveTo);
+    LUA_METHOD(FadeTo);
+    LUA_METHOD(SetVisible);
+
+    LUA_METHOD(AddTween);
+    LUA_METHOD(ClearTweens);
+
+    LUA_METHOD(Play);
+    LUA_METHOD(Stop);
+
+    lua_tinker::set(L, "TWEEN_SINGLE", static_cast<int>(TWEEN_SINGLE));
+    lua_tinker::set(L, "TWEEN_SEQUENCE", static_cast<int>(TWEEN_SEQUENCE));
+    lua_tinker::set(L, "TWEEN_PARALLEL", static_cast<int>(TWEEN_PARALLEL));
+
+    lua_tinker::set(L, "TWEEN_LINEAR", static_cast<int>(TWEEN_LINEAR));
+    lua_tinker::set(L, "TWEEN_EASE_IN_QUAD", static_cast<int>(TWEEN_EASE_IN_QUAD));
+    lua_tinker::set(L, "TWEEN_EASE_OUT_QUAD", static_cast<int>(TWEEN_EASE_OUT_QUAD));
+    lua_tinker::set(L, "TWEEN_EASE_IN_OUT_QUAD", static_cast<int>(TWEEN_EASE_IN_OUT_QUAD));
+    lua_tinker::set(L, "TWEEN_EASE_IN_CUBIC", static_cast<int>(TWEEN_EASE_IN_CUBIC));
+    lua_tinker::set(L, "TWEEN_EASE_OUT_CUBIC", static_cast<int>(TWEEN_EASE_OUT_CUBIC));
+    lua_tinker::set(L, "TWEEN_EASE_IN_OUT_CUBIC", static_cast<int>(TWEEN_EASE_IN_OUT_CUBIC));
+    lua_tinker::set(L, "TWEEN_EASE_OUT_BACK", static_cast<int>(TWEEN_EASE_OUT_BACK));
+    lua_tinker::set(L, "TWEEN_EASE_OUT_BOUNCE", static_cast<int>(TWEEN_EASE_OUT_BOUNCE));
+}
+
+CTween::CTween(int type) : _type(type)
+{
+}
+
+CTween::~CTween()
+{
+    // 그룹과 자식 트윈은 루아가 따로 해제하므로 서로 가리키는 포인터를 끊어 둔다.
+    if (_parent != nullptr)
+    {
+        _parent->_Unlink(this);
+    }
+
+    for (auto tween : _tweens)
+    {
+        if (tween != nullptr)
+        {
+            tween->_parent = nullptr;
+        }
+    }
+
+    CAnimationManager::GetInstance().RemoveTween(this);
+}
+
+int CTween::GetType() const
+{
+    return _type;
+}
+
+int CTween::GetDuration() const
+{
+    return _duration;
+}
+
+int CTween::GetDelay() const
+{
+    return _delay;
+}
+
+int CTween::GetEasing() const
+{
+    return _easing;
+}
+
+int CTween::GetEndEvent() const
+{
+    return _endEvent;
+}
+
+bool CTween::IsPlaying() const
+{
+    return _isPlaying;
+}
+
+void CTween::SetLayoutTarget(CLayoutControl *layout)
+{
+    _target = TWEEN_TARGET_LAYOUT;
+    _layout = layout;
+    _index = 0;
+}
+
+void CTween::SetImageTarget(CLayoutControl *layout, int index)
+{
+    _target = TWEEN_TARGET_IMAGE;
+    _layout = layout;
+    _index = index;
+}
+
+void CTween::SetTextTarget(CLayoutControl *layout, int index)
+{
+    _target = TWEEN_TARGET_TEXT;
+    _layout = layout;
+    _index = index;
+}
+
+void CTween::SetDuration(int duration)
+{
+    _duration = duration > 0 ? duration : 0;
+}
+
+void CTween::SetDelay(int delay)
+{
+    _delay = delay > 0 ? delay : 0;
+}
+
+void CTween::SetEasing(int easing)
+{
+    _easing = easing;
+}
+
+void CTween::SetEndEvent()
+{
+    auto l = CLuaTinker::GetLuaTinker().GetLuaState();
+    if (lua_isfunction(l, -1))
+    {
+        lua_pushvalue(l, -1);
+        _endEvent = luaL_ref(l, LUA_REGISTRYINDEX);
+    }
+
+    lua_pop(l, 1);
+}
+
+void CTween::MoveTo(int x, int y)
+{
+    _isMove = true;
+    _to.x = x;
+    _to.y = y;
+}
+
+void CTween::FadeTo(int alpha)
+{
+    _isFade = true;
+    _toAlpha = alpha < 0 ? 0 : (alpha > 255 ? 255 : alpha);
+}
+
+void CTween::SetVisible(bool value)
+{
+    // 보이기는 시작할 때, 숨기기는 끝날 때 적용한다.
+    _isShow = value;
+    _isHide = !value;
+}
+
+void CTween::AddTween(CTween *tween)
+{
+    if (_type != TWEEN_SINGLE && tween != nullptr && tween != this)
+    {
+        if (tween->_parent != nullptr)
+        {
+            tween->_parent->_Unlink(tween);
+        }
+
+        tween->_parent = this;
+        _tweens.push_back(tween);
+    }
+}
+
+void CTween::ClearTweens()
+{
+    Stop();
+
+    for (auto tween : _tweens)
+    {
+        if (tween != nullptr)
+        {
+            tween->_parent = nullptr;
+        }
+    }
+    _tweens.clear();
+}
+
+void CTween::Play()
+{
+    _Reset();
+
+    _isPlaying = true;
+    CAnimationManager::GetInstance().AddTween(this);
+}
+
+void CTween::Stop()
+{
+    _isPlaying = false;
+}
+
+void CTween::Update(int elapsed)
+{
+    if (!_isPlaying)
+    {
+        return;
+    }
+
+    _Advance(elapsed);
+}
+
+double CTween::_Ease(int easing, double t)
+{
+    switch (easing)
+    {
+    case TWEEN_EASE_IN_QUAD:
+        return t * t;
+    case TWEEN_EASE_OUT_QUAD:
+        return 1.0 - (1.0 - t) * (1.0 - t);
+    case TWEEN_EASE_IN_OUT_QUAD:
+        return t < 0.5 ? 2.0 * t * t : 1.0 - std::pow(-2.0 * t + 2.0, 2) / 2.0;
+    case TWEEN_EASE_IN_CUBIC:
+        return t * t * t;
+    case TWEEN_EASE_OUT_CUBIC:
+        return 1.0 - std::pow(1.0 - t, 3);
+    case TWEEN_EASE_IN_OUT_CUBIC:
+        return t < 0.5 ? 4.0 * t * t * t : 1.0 - std::pow(-2.0 * t + 2.0, 3) / 2.0;
+    case TWEEN_EASE_OUT_BACK:
+    {
+        const double c1 = 1.70158;
+        const double c3 = c1 + 1.0;
+        return 1.0 + c3 * std::pow(t - 1.0, 3) + c1 * std::pow(t - 1.0, 2);
+    }
+    case TWEEN_EASE_OUT_BOUNCE:
+    {
+        const double n1 = 7.5625;
+        const double d1 = 2.75;
+        if (t < 1.0 / d1)
+        {
+            return n1 * t * t;
+        }
+        else if (t < 2.0 / d1)
+        {
+            t -= 1.5 / d1;
+            return n1 * t * t + 0.75;
+        }
+        else if (t < 2.5 / d1)
+        {
+            t -= 2.25 / d1;
+            return n1 * t * t + 0.9375;
+        }
+        t -= 2.625 / d1;
+        return n1 * t * t + 0.984375;
+    }
+    default:
+        return t;
+    }
+}
+
+void CTween::_Reset()
+{
+    _elapsed = 0;
+    _delayElapsed = 0;
+    _currentTween = 0;
+    _isStarted = false;
+    _isFinished = false;
+
+    for (auto tween : _tweens)
+    {
+        if (tween != nullptr)
+        {
+            tween->_Reset();
+        }
+    }
+}
+
+void CTween::_Start()
+{
+    _isStarted = true;
+
+    if (_layout == nullptr)
+    {
+        return;
+    }
+
+    // 시작 값은 재생 시점의 값으로 잡아야 시퀀스에서 이어서 움직일 수 있다.
+    switch (_target)
+    {
+    case TWEEN_TARGET_LAYOUT:
+        _from.x = _layout->GetX();
+        _from.y = _layout->GetY();
+        _fromAlpha = _layout->GetAlpha();
+        if (_isShow)
+        {
+            _layout->SetHide(false);
+        }
+        break;
+    case TWEEN_TARGET_IMAGE:
+        _from.x = _layout->GetImageX(_index);
+        _from.y = _layout->GetImageY(_index);
+        _fromAlpha = _layout->GetImageAlpha(_index);
+        if (_isShow)
+        {
+            _layout->ShowImage(_index, false);
+        }
+        break;
+    case TWEEN_TARGET_TEXT:
+        // 텍스트는 투명도를 따로 갖지 않는다.
+        _from.x = _layout->GetTextX(_index);
+        _from.y = _layout->GetTextY(_index);
+        if (_isShow)
+        {
+            _layout->ShowText(_index, false);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void CTween::_Apply(double progress)
+{
+    if (_layout == nullptr || _target == TWEEN_TARGET_NONE)
+    {
+        return;
+    }
+
+    double ratio = _Ease(_easing, progress);
+    int x = _from.x + int(std::lround((_to.x - _from.x) * ratio));
+    int y = _from.y + int(std::lround((_to.y - _from.y) * ratio));
+    int alpha = _fromAlpha + int(std::lround((_toAlpha - _fromAlpha) * ratio));
+
+    switch (_target)
+    {
+    case TWEEN_TARGET_LAYOUT:
+        if (_isMove)
+        {
+            _layout->SetPosition(x, y, true);
+        }
+        if (_isFade)
+        {
+            _layout->SetAlpha(alpha);
+        }
+        break;
+    case TWEEN_TARGET_IMAGE:
+        if (_isMove && (x != _layout->GetImageX(_index) || y != _layout->GetImageY(_index)))
+        {
+            _layout->MoveImage(_index, x, y, false);
+        }
+        if (_isFade)
+        {
+            _layout->SetImageAlpha(_index, alpha);
+        }
+        break;
+    case TWEEN_TARGET_TEXT:
+        if (_isMove && (x != _layout->GetTextX(_index) || y != _layout->GetTextY(_index)))
+        {
+            _layout->MoveText(_index, x, y, false);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void CTween::_Finish()
+{
+    _isFinished = true;
+    _isPlaying = false;
+
+    if (_isHide && _layout != nullptr)
+    {
+        switch (_target)
+        {
+        case TWEEN_TARGET_LAYOUT:
+            _layout->SetHide(true);
+            break;
+        case TWEEN_TARGET_IMAGE:
+            _layout->HideImage(_index, false);
+            break;
+        case TWEEN_TARGET_TEXT:
+            _layout->HideText(_index, false);
+            break;
+        default:
+            break;
+        }
+    }
+
+    // 끝 이벤트에서 다시 Play 를 호출할 수 있으므로 상태를 먼저 정리한다.
+    if (_endEvent != LUA_NOREF)
+    {
+        CLuaTinker::GetLuaTinker().Call(_endEvent, this);
+    }
+}
+
+void CTween::_Unlink(CTween *tween)
+{
+    // 재생 중에 해제될 수 있으므로 지우지 않고 빈 자리로 남긴다.
+    for (auto &child : _tweens)
+    {
+        if (child == tween)
+        {
+            child = nullptr;
+        }
+    }
+}
+
+int CTween::_Advance(int elapsed)
+{
+    if (_isFinished)
+    {
+        return elapsed;
+    }
+
+    if (!_isStarted)
+    {
+        _delayElapsed += elapsed;
+        if (_delayElapsed < _delay)
+        {
+            return 0;
+        }
+
+        elapsed = _delayElapsed - _delay;
+        _delayElapsed = _delay;
+        _Start();
+    }
+
+    int leftover = 0;
+    if (_type == TWEEN_SEQUENCE)
+    {
+        // 앞의 트윈이 끝나고 남은 시간은 다음 트윈으로 넘긴다.
+        leftover = elapsed;
+        while (_currentTween < _tweens.size())
+        {
+            if (_tweens[_currentTween] == nullptr)
+            {
+                ++_currentTween;
+                continue;
+            }
+
+            leftover = _tweens[_currentTween]->_Advance(leftover);
+            if (!_tweens[_currentTween]->_isFinished)
+            {
+                return 0;
+            }
+            ++_currentTween;
+        }
+    }
+    else if (_type == TWEEN_PARALLEL)
+    {
+        bool isAllFinished = true;
+        leftover = elapsed;
+        for (auto tween : _tweens)
+        {
+            if (tween == nullptr || tween->_isFinished)
+            {
+                continue;
+            }
+
+            int tweenLeftover = tween->_Advance(elapsed);
+            if (tween->_isFinished)
+            {
+                leftover = tweenLeftover < leftover ? tweenLeftover : leftover;
+            }
+            else
+            {
+                isAllFinished = false;
+            }
+        }
+
+        if (!isAllFinished)
+        {
+            return 0;
+        }
+    }
+    else
+    {
+        _elapsed += elapsed;
+        if (_elapsed < _duration)
+        {
+            _Apply(double(_elapsed) / _duration);
+            return 0;
+        }
+
+        leftover = _elapsed - _duration;
+        _elapsed = _duration;
+        _Apply(1.0);
+    }
+
+    _Finish();
+    return leftover;
+}
+} // namespace jojogame
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "LuaLib\LuaTinker.h"
+
+#include <vector>
+
+namespace jojogame
+{
+class CLayoutControl;
+
+enum TWEEN_TYPE
+{
+    TWEEN_SINGLE = 0,
+    TWEEN_SEQUENCE = 1,
+    TWEEN_PARALLEL = 2,
+};
+
+enum TWEEN_TARGET
+{
+    TWEEN_TARGET_NONE = 0,
+    TWEEN_TARGET_LAYOUT = 1,
+    TWEEN_TARGET_IMAGE = 2,
+    TWEEN_TARGET_TEXT = 3,
+};
+
+enum TWEEN_EASING
+{
+    TWEEN_LINEAR = 0,
+    TWEEN_EASE_IN_QUAD = 1,
+    TWEEN_EASE_OUT_QUAD = 2,
+    TWEEN_EASE_IN_OUT_QUAD = 3,
+    TWEEN_EASE_IN_CUBIC = 4,
+    TWEEN_EASE_OUT_CUBIC = 5,
+    TWEEN_EASE_IN_OUT_CUBIC = 6,
+    TWEEN_EASE_OUT_BACK = 7,
+    TWEEN_EASE_OUT_BOUNCE = 8,
+};
+
+class CTween
+{
+public:
+    static void RegisterFunctions(lua_State *L);
+
+    CTween(int type = TWEEN_SINGLE);
+    virtual ~CTween();
+
+    int GetType() const;
+    int GetDuration() const;
+    int GetDelay() const;
+    int GetEasing() const;
+    int GetEndEvent() const;
+    bool IsPlaying() const;
+
+    void SetLayoutTarget(CLayoutControl *layout);
+    void SetImageTarget(CLayoutControl *layout, int index);
+    void SetTextTarget(CLayoutControl *layout, int index);
+    void SetDuration(int duration);
+    void SetDelay(int delay);
+    void SetEasing(int easing);
+    void SetEndEvent();
+
+    void MoveTo(int x, int y);
+    void FadeTo(int alpha);
+    void SetVisible(bool value);
+
+    void AddTween(CTween *tween);
+    void ClearTweens();
+
+    void Play();
+    void Stop();
+
+    void Update(int elapsed);
+
+private:
+    static double _Ease(int easing, double t);
+
+    void _Reset();
+    void _Start();
+    void _Apply(double progress);
+    void _Finish();
+    void _Unlink(CTween *tween);
+    int _Advance(int elapsed);
+
+    int _type;
+    int _target = TWEEN_TARGET_NONE;
+    CLayoutControl *_layout = nullptr;
+    int _index = 0;
+
+    bool _isMove = false;
+    bool _isFade = false;
+    bool _isShow = false;
+    bool _isHide = false;
+    POINT _from{};
+    POINT _to{};
+    int _fromAlpha = 255;
+    int _toAlpha = 255;
+
+    int _duration = 0;
+    int _delay = 0;
+    int _easing = TWEEN_LINEAR;
+    int _elapsed = 0;
+    int _delayElapsed = 0;
+    bool _isStarted = false;
+    bool _isFinished = false;
+    bool _isPlaying = false;
+
+    CTween *_parent = nullptr;
+    std::vector<CTween *> _tweens;
+    size_t _currentTween = 0;
+
+    int _endEvent = LUA_NOREF;
+};
+} // namespace jojogame
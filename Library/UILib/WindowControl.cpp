@@ -13,6 +13,11 @@
 #include "GroupBoxControl.h"
 #include "CheckBoxControl.h"
 #include "RadioButtonControl.h"
+#include "TileRenderer.h"
+#include "WindowTransition.h"
+#include "InputManager.h"
+#include "PerformanceHud.h"
+#include "BaseLib/Profiler.h"
 
 #include <Uxtheme.h>
 #include <Vsstyle.h>
@@ -48,95 +53,61 @@ LRESULT CALLBACK CWindowControl::OnControlProc(HWND hWnd, UINT iMessage, WPARAM
         break;
     }
 
+    // 입력은 바로 루아를 부르지 않고 모아 두었다가 틱마다 한 번에 보낸다.
     case WM_KEYDOWN:
     {
         auto window = reinterpret_cast<CWindowControl *>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
-        auto keyDownEvent = window->GetKeyDownEvent();
-        if (keyDownEvent != LUA_NOREF)
-        {
-            CLuaTinker::GetLuaTinker().Call(keyDownEvent,
-                                            window,
-                                            (int)wParam);
-        }
+        CInputManager::GetInstance().Push(window, INPUT_KEY_DOWN, (int)wParam, 0, 0);
         break;
     }
 
     case WM_KEYUP:
     {
         auto window = reinterpret_cast<CWindowControl *>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
-        auto keyUpEvent = window->GetKeyUpEvent();
-        if (keyUpEvent != LUA_NOREF)
-        {
-            CLuaTinker::GetLuaTinker().Call(keyUpEvent,
-                                            window,
-                                            (int)wParam);
-        }
+        CInputManager::GetInstance().Push(window, INPUT_KEY_UP, (int)wParam, 0, 0);
         break;
     }
 
     case WM_LBUTTONUP:
     {
         auto window = reinterpret_cast<CWindowControl *>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
-        auto mouseLButtonUpEvent = window->GetMouseLButtonUpEvent();
-        if (mouseLButtonUpEvent != LUA_NOREF)
+        int y = GET_Y_LPARAM(lParam);
+        auto toolbar = window->GetToolbar();
+        if (toolbar)
         {
-            int y = GET_Y_LPARAM(lParam);
-            auto toolbar = window->GetToolbar();
-            if (toolbar)
-            {
-                y -= toolbar->GetHeight();
-            }
-
-            CLuaTinker::GetLuaTinker().Call(mouseLButtonUpEvent,
-                                            window,
-                                            (int)wParam,
-                                            GET_X_LPARAM(lParam),
-                                            y);
+            y -= toolbar->GetHeight();
         }
+
+        CInputManager::GetInstance().Push(window, INPUT_MOUSE_LBUTTON_UP, (int)wParam, GET_X_LPARAM(lParam), y);
         break;
     }
 
     case WM_LBUTTONDOWN:
     {
         auto window = reinterpret_cast<CWindowControl *>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
-        auto mouseLButtonDownEvent = window->GetMouseLButtonDownEvent();
-        if (mouseLButtonDownEvent != LUA_NOREF)
+        int y = GET_Y_LPARAM(lParam);
+        auto toolbar = window->GetToolbar();
+        if (toolbar)
         {
-            int y = GET_Y_LPARAM(lParam);
-            auto toolbar = window->GetToolbar();
-            if (toolbar)
-            {
-                y -= toolbar->GetHeight();
-            }
-
-            CLuaTinker::GetLuaTinker().Call(mouseLButtonDownEvent,
-                                            window,
-                                            (int)wParam,
-                                            GET_X_LPARAM(lParam),
-                                            y);
+            y -= toolbar->GetHeight();
         }
+
+        CInputManager::GetInstance().Push(window, INPUT_MOUSE_LBUTTON_DOWN, (int)wParam, GET_X_LPARAM(lParam), y);
         break;
     }
 
     case WM_MOUSEMOVE:
     {
         auto window = reinterpret_cast<CWindowControl *>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
-        auto mouseMoveEvent = window->GetMouseMoveEvent();
-        if (mouseMoveEvent != LUA_NOREF)
+        int y = GET_Y_LPARAM(lParam);
+        auto toolbar = window->GetToolbar();
+        if (toolbar)
         {
-            int y = GET_Y_LPARAM(lParam);
-            auto toolbar = window->GetToolbar();
-            if (toolbar)
-            {
-                y -= toolbar->GetHeight();
-            }
-            CLuaTinker::GetLuaTinker().Call(mouseMoveEvent,
-                                            window,
-                                            (int)wParam,
-                                            GET_X_LPARAM(lParam),
-                                            y);
+            y -= toolbar->GetHeight();
         }
 
+        CInputManager::GetInstance().Push(window, INPUT_MOUSE_MOVE, (int)wParam, GET_X_LPARAM(lParam), y);
+
         if (!window->_isHover)
         {
             trackMouseEvent.cbSize = sizeof(TRACKMOUSEEVENT);
@@ -151,11 +122,7 @@ LRESULT CALLBACK CWindowControl::OnControlProc(HWND hWnd, UINT iMessage, WPARAM
     case WM_MOUSEHOVER:
     {
         auto window = reinterpret_cast<CWindowControl *>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
-        auto mouseHoverEvent = window->GetMouseEnterEvent();
-        if (mouseHoverEvent != LUA_NOREF)
-        {
-            CLuaTinker::GetLuaTinker().Call(mouseHoverEvent, window);
-        }
+        CInputManager::GetInstance().Push(window, INPUT_MOUSE_ENTER, 0, 0, 0);
 
         window->_isHover = true;
         trackMouseEvent.cbSize = sizeof(TRACKMOUSEEVENT);
@@ -168,11 +135,7 @@ LRESULT CALLBACK CWindowControl::OnControlProc(HWND hWnd, UINT iMessage, WPARAM
     case WM_MOUSELEAVE:
     {
         auto window = reinterpret_cast<CWindowControl *>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
-        auto mouseLeaveEvent = window->GetMouseLeaveEvent();
-        if (mouseLeaveEvent != LUA_NOREF)
-        {
-            CLuaTinker::GetLuaTinker().Call(mouseLeaveEvent, window);
-        }
+        CInputManager::GetInstance().Push(window, INPUT_MOUSE_LEAVE, 0, 0, 0);
 
         window->_isHover = false;
         break;
@@ -180,6 +143,9 @@ LRESULT CALLBACK CWindowControl::OnControlProc(HWND hWnd, UINT iMessage, WPARAM
 
     case WM_ACTIVATEAPP:
     {
+        // 비활성화되는 동안 뗀 키는 받지 못하므로 눌림 상태를 지운다.
+        CInputManager::GetInstance().ResetKeyStates();
+
         if (wParam == TRUE)
         {
             auto window = reinterpret_cast<CWindowControl *>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
@@ -263,6 +229,12 @@ LRESULT CALLBACK CWindowControl::OnControlProc(HWND hWnd, UINT iMessage, WPARAM
     case WM_DESTROY:
     {
         auto window = reinterpret_cast<CWindowControl *>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
+        CInputManager::GetInstance().RemoveWindow(window);
+        if (CPerformanceHud::GetInstance().GetWindow() == window)
+        {
+            CPerformanceHud::GetInstance().SetWindow(nullptr);
+        }
+
         auto destroyEvent = window->GetDestroyEvent();
         if (destroyEvent != LUA_NOREF)
         {
@@ -290,8 +262,8 @@ LRESULT CALLBACK CWindowControl::OnControlProc(HWND hWnd, UINT iMessage, WPARAM
             if (listView)
             {
                 auto lpnmia = (LPNMITEMACTIVATE)lParam;
-                auto row = listView->GetRow(lpnmia->iItem + 1);
-                if (row->IsEnabled())
+                auto row = listView->IsVirtual() ? listView->GetVirtualRow() : listView->GetRow(lpnmia->iItem + 1);
+                if (row != nullptr && row->IsEnabled())
                 {
                     auto itemActiveEvent = row->GetActiveEvent();
                     if (itemActiveEvent != LUA_NOREF)
@@ -304,6 +276,20 @@ LRESULT CALLBACK CWindowControl::OnControlProc(HWND hWnd, UINT iMessage, WPARAM
                 }
             }
         }
+        else if (pnmhdr->code == LVN_GETDISPINFO)
+        {
+            auto listView = reinterpret_cast<CListViewControl *>(GetWindowLongPtr(pnmhdr->hwndFrom, GWLP_USERDATA));
+
+            if (listView && listView->IsVirtual())
+            {
+                auto dispInfo = (NMLVDISPINFO *)lParam;
+                if ((dispInfo->item.mask & LVIF_TEXT) && dispInfo->item.cchTextMax > 0)
+                {
+                    auto text = listView->GetCellText(dispInfo->item.iItem, dispInfo->item.iSubItem);
+                    wcsncpy_s(dispInfo->item.pszText, dispInfo->item.cchTextMax, text.c_str(), _TRUNCATE);
+                }
+            }
+        }
 
         break;
     }
@@ -480,144 +466,160 @@ LRESULT CALLBACK CWindowControl::OnControlProc(HWND hWnd, UINT iMessage, WPARAM
         else if (item->CtlType == ODT_LISTVIEW)
         {
             auto listview = (CListViewControl *)item->CtlID;
-            auto row = (CListViewRow *)item->itemData;
-
-            int left = item->rcItem.left;
+            auto row = listview->IsVirtual() ? listview->FillVirtualRow(item->itemID) : (CListViewRow *)item->itemData;
+            bool isRowSelected = (item->itemState & ODS_SELECTED) != 0;
+
+            // 행 이미지는 열 너비, 글꼴, 투명 배경일 때의 위치가 같으면 다시 쓴다.
+            // 뒤의 레이아웃이 바뀌면 CLayoutControl::Refresh 가 겹치는 리스트뷰의 행 이미지를 지운다.
+            int rowWidth = 0;
+            int rowHeight = item->rcItem.bottom - item->rcItem.top;
+            ListViewRowImageKey imageKey;
+            imageKey.height = rowHeight;
             for (int i = 0; i < listview->GetColumnCount(); ++i)
             {
-                bool isSelected = false;
+                auto columnWidth = ListView_GetColumnWidth(item->hwndItem, i);
+                rowWidth += columnWidth;
+                imageKey.columnWidths.push_back(columnWidth);
+
                 auto listViewItem = row->GetItem(i + 1);
-                COLORREF backgroundColor;
+                imageKey.fontVersions.push_back(listViewItem->GetFont()->GetVersion());
+            }
+            if (listview->IsTransparentBackground())
+            {
+                imageKey.origin = POINT{item->rcItem.left, item->rcItem.top};
+                MapWindowPoints(item->hwndItem, hWnd, &imageKey.origin, 1);
+            }
 
-                if (row->IsEnabled())
-                {
-                    if (item->itemState & ODS_SELECTED)
-                    {
-                        backgroundColor = listViewItem->GetFocusedBackgroundColor();
-                        SetTextColor(item->hDC, listViewItem->GetFocusedTextColor());
-                        isSelected = true;
-                    }
-                    else
-                    {
-                        backgroundColor = listViewItem->GetNormalBackgroundColor();
-                        SetTextColor(item->hDC, listViewItem->GetNormalTextColor());
-                    }
-                }
-                else
-                {
-                    if (item->itemState & ODS_SELECTED)
-                    {
-                        backgroundColor = listViewItem->GetDisableFocusedBackgroundColor();
-                        SetTextColor(item->hDC, listViewItem->GetDisableFocusedTextColor());
-                        isSelected = true;
-                    }
-                    else
-                    {
-                        backgroundColor = listViewItem->GetDisabledBackgroundColor();
-                        SetTextColor(item->hDC, listViewItem->GetDisabledTextColor());
-                    }
-                }
+            if (rowWidth <= 0 || rowHeight <= 0)
+            {
+                break;
+            }
 
-                RECT rect;
-                auto columnWidth = ListView_GetColumnWidth(item->hwndItem, i);
-                SetRect(&rect, left, item->rcItem.top, left + columnWidth, item->rcItem.bottom);
+            HDC rowDC = CreateCompatibleDC(item->hDC);
+            HBITMAP rowImage = row->GetCachedImage(isRowSelected, imageKey);
+            if (rowImage == nullptr)
+            {
+                rowImage = CreateCompatibleBitmap(item->hDC, rowWidth, rowHeight);
+                auto oldRowImage = SelectBitmap(rowDC, rowImage);
+                SetViewportOrgEx(rowDC, -item->rcItem.left, -item->rcItem.top, nullptr);
 
-                if (listview->IsTransparentBackground())
+                int left = item->rcItem.left;
+                for (int i = 0; i < listview->GetColumnCount(); ++i)
                 {
-                    auto window = reinterpret_cast<CWindowControl *>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
+                    bool isSelected = false;
+                    auto listViewItem = row->GetItem(i + 1);
+                    COLORREF backgroundColor;
 
-                    if (isSelected)
+                    if (row->IsEnabled())
                     {
-                        HBRUSH backgroundBrush = CreateSolidBrush(backgroundColor);
-                        FillRect(item->hDC, &rect, backgroundBrush);
-                        DeleteBrush(backgroundBrush);
+                        if (isRowSelected)
+                        {
+                            backgroundColor = listViewItem->GetFocusedBackgroundColor();
+                            SetTextColor(rowDC, listViewItem->GetFocusedTextColor());
+                            isSelected = true;
+                        }
+                        else
+                        {
+                            backgroundColor = listViewItem->GetNormalBackgroundColor();
+                            SetTextColor(rowDC, listViewItem->GetNormalTextColor());
+                        }
                     }
                     else
                     {
-                        FillRect(item->hDC, &rect, window->GetBackgroundBrush());
-                    }
-
-                    RECT rectByWindow;
-                    SetRect(&rectByWindow, rect.left, rect.top, rect.right, rect.bottom);
-                    ClientToScreen(listview->GetHWnd(), reinterpret_cast<POINT *>(&rectByWindow.left));  // convert top-left
-                    ClientToScreen(listview->GetHWnd(), reinterpret_cast<POINT *>(&rectByWindow.right)); // convert bottom-right
-                    ScreenToClient(hWnd, reinterpret_cast<POINT *>(&rectByWindow.left));
-                    ScreenToClient(hWnd, reinterpret_cast<POINT *>(&rectByWindow.right));
-                    rectByWindow.left -= rect.left;
-                    rectByWindow.top -= rect.top;
-
-                    bool isFitWidth = false;
-                    bool isFitHeight = false;
-
-                    for (auto layout : window->_layouts)
-                    {
-                        isFitWidth = isFitHeight = false;
-
-                        if (layout->GetWidth() == 0)
+                        if (isRowSelected)
                         {
-                            isFitWidth = true;
-                            layout->SetWidth(window->GetWidth());
+                            backgroundColor = listViewItem->GetDisableFocusedBackgroundColor();
+                            SetTextColor(rowDC, listViewItem->GetDisableFocusedTextColor());
+                            isSelected = true;
                         }
-                        if (layout->GetHeight() == 0)
+                        else
                         {
-                            isFitHeight = true;
-                            layout->SetHeight(window->GetHeight());
+                            backgroundColor = listViewItem->GetDisabledBackgroundColor();
+                            SetTextColor(rowDC, listViewItem->GetDisabledTextColor());
                         }
+                    }
+
+                    RECT rect;
+                    auto columnWidth = ListView_GetColumnWidth(item->hwndItem, i);
+                    SetRect(&rect, left, item->rcItem.top, left + columnWidth, item->rcItem.bottom);
 
-                        layout->SetX(layout->GetX() - rectByWindow.left);
-                        layout->SetY(layout->GetY() - rectByWindow.top);
+                    if (listview->IsTransparentBackground())
+                    {
+                        auto window = reinterpret_cast<CWindowControl *>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
 
                         if (isSelected)
                         {
-                            layout->Draw(item->hDC, rect, backgroundColor);
+                            HBRUSH backgroundBrush = CreateSolidBrush(backgroundColor);
+                            FillRect(rowDC, &rect, backgroundBrush);
+                            DeleteBrush(backgroundBrush);
                         }
                         else
                         {
-                            layout->Draw(item->hDC, rect);
+                            FillRect(rowDC, &rect, window->GetBackgroundBrush());
                         }
 
-                        layout->SetX(layout->GetX() + rectByWindow.left);
-                        layout->SetY(layout->GetY() + rectByWindow.top);
-
-                        if (isFitWidth)
-                        {
-                            layout->SetWidth(0);
-                        }
-                        if (isFitHeight)
+                        RECT rectByWindow;
+                        SetRect(&rectByWindow, rect.left, rect.top, rect.right, rect.bottom);
+                        ClientToScreen(listview->GetHWnd(), reinterpret_cast<POINT *>(&rectByWindow.left));  // convert top-left
+                        ClientToScreen(listview->GetHWnd(), reinterpret_cast<POINT *>(&rectByWindow.right)); // convert bottom-right
+                        ScreenToClient(hWnd, reinterpret_cast<POINT *>(&rectByWindow.left));
+                        ScreenToClient(hWnd, reinterpret_cast<POINT *>(&rectByWindow.right));
+                        rectByWindow.left -= rect.left;
+                        rectByWindow.top -= rect.top;
+
+                        POINT offset{-rectByWindow.left, -rectByWindow.top};
+                        SIZE fitSize{window->GetWidth(), window->GetHeight()};
+                        for (auto layout : window->_layouts)
                         {
-                            layout->SetHeight(0);
+                            if (isSelected)
+                            {
+                                layout->Draw(rowDC, rect, backgroundColor, offset, fitSize);
+                            }
+                            else
+                            {
+                                layout->Draw(rowDC, rect, offset, fitSize);
+                            }
                         }
                     }
-                }
-                else
-                {
-                    HBRUSH backgroundBrush = CreateSolidBrush(backgroundColor);
-                    FillRect(item->hDC, &rect, backgroundBrush);
-                    DeleteBrush(backgroundBrush);
-                }
+                    else
+                    {
+                        HBRUSH backgroundBrush = CreateSolidBrush(backgroundColor);
+                        FillRect(rowDC, &rect, backgroundBrush);
+                        DeleteBrush(backgroundBrush);
+                    }
 
-                auto originalFont = SelectFont(item->hDC, listViewItem->GetFont()->GetHFont());
-                SetBkMode(item->hDC, TRANSPARENT);
-                if (listViewItem->GetAlign() == 0)
-                {
-                    DrawText(item->hDC, listViewItem->GetText().c_str(), -1, &rect,
-                             DT_LEFT | DT_VCENTER | DT_SINGLELINE);
-                }
-                else if (listViewItem->GetAlign() == 1)
-                {
-                    DrawText(item->hDC, listViewItem->GetText().c_str(), -1, &rect,
-                             DT_RIGHT | DT_VCENTER | DT_SINGLELINE);
-                }
-                else if (listViewItem->GetAlign() == 2)
-                {
-                    DrawText(item->hDC, listViewItem->GetText().c_str(), -1, &rect,
-                             DT_CENTER | DT_VCENTER | DT_SINGLELINE);
+                    auto originalFont = SelectFont(rowDC, listViewItem->GetFont()->GetHFont());
+                    SetBkMode(rowDC, TRANSPARENT);
+                    if (listViewItem->GetAlign() == 0)
+                    {
+                        DrawText(rowDC, listViewItem->GetText().c_str(), -1, &rect,
+                                 DT_LEFT | DT_VCENTER | DT_SINGLELINE);
+                    }
+                    else if (listViewItem->GetAlign() == 1)
+                    {
+                        DrawText(rowDC, listViewItem->GetText().c_str(), -1, &rect,
+                                 DT_RIGHT | DT_VCENTER | DT_SINGLELINE);
+                    }
+                    else if (listViewItem->GetAlign() == 2)
+                    {
+                        DrawText(rowDC, listViewItem->GetText().c_str(), -1, &rect,
+                                 DT_CENTER | DT_VCENTER | DT_SINGLELINE);
+                    }
+                    SelectFont(rowDC, originalFont);
+                    SetBkMode(rowDC, OPAQUE);
+
+                    left += columnWidth;
                 }
-                SelectFont(item->hDC, originalFont);
-                SetBkMode(item->hDC, OPAQUE);
 
-                left += columnWidth;
+                SetViewportOrgEx(rowDC, 0, 0, nullptr);
+                SelectBitmap(rowDC, oldRowImage);
+                row->SetCachedImage(isRowSelected, imageKey, rowImage);
             }
+
+            auto oldRowImage = SelectBitmap(rowDC, rowImage);
+            BitBlt(item->hDC, item->rcItem.left, item->rcItem.top, rowWidth, rowHeight, rowDC, 0, 0, SRCCOPY);
+            SelectBitmap(rowDC, oldRowImage);
+            DeleteDC(rowDC);
         }
         else if (item->CtlType == ODT_STATIC)
         {
@@ -882,22 +884,21 @@ LRESULT CALLBACK CWindowControl::OnControlProc(HWND hWnd, UINT iMessage, WPARAM
 
     case WM_PAINT:
     {
+        PROFILE_ZONE("WM_PAINT");
+
         auto window = reinterpret_cast<CWindowControl *>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
         PAINTSTRUCT ps;
         HDC hdc = BeginPaint(hWnd, &ps);
-        bool isFitWidth = false;
-        bool isFitHeight = false;
+        std::vector<std::pair<bool, bool>> fitSizes;
 
-        HDC memDC = CreateCompatibleDC(hdc);
-        HBITMAP bitmap = CreateCompatibleBitmap(hdc, window->GetWidth(), window->GetHeight());
-        HBITMAP oldBitmap = SelectBitmap(memDC, bitmap);
-        RECT rect;
-        SetRect(&rect, 0, 0, window->GetWidth(), window->GetHeight());
-        FillRect(memDC, &rect, window->GetBackgroundBrush());
+        // 백 버퍼는 창 크기가 바뀔 때만 다시 만들고, 무효화된 영역만 지우고 그린다.
+        HDC memDC = window->_GetBackBuffer(hdc);
+        IntersectClipRect(memDC, ps.rcPaint.left, ps.rcPaint.top, ps.rcPaint.right, ps.rcPaint.bottom);
 
         for (auto layout : window->_layouts)
         {
-            isFitWidth = isFitHeight = false;
+            bool isFitWidth = false;
+            bool isFitHeight = false;
 
             if (layout->GetWidth() == 0)
             {
@@ -910,22 +911,90 @@ LRESULT CALLBACK CWindowControl::OnControlProc(HWND hWnd, UINT iMessage, WPARAM
                 layout->SetHeight(window->GetHeight());
             }
 
-            layout->Draw(memDC, ps.rcPaint);
+            fitSizes.emplace_back(isFitWidth, isFitHeight);
+        }
+
+        bool isBackgroundCovered = false;
+        if (window->_isOcclusionCulling)
+        {
+            HRGN coverage = CreateRectRgn(0, 0, 0, 0);
+            LONGLONG visibleArea = 0;
+            LONGLONG drawnArea = 0;
+
+            for (auto layout = window->_layouts.rbegin(); layout != window->_layouts.rend(); ++layout)
+            {
+                (*layout)->Cull(memDC, coverage, ps.rcPaint, visibleArea, drawnArea);
+            }
+
+            HRGN paintRegion = CreateRectRgnIndirect(&ps.rcPaint);
+            isBackgroundCovered = CombineRgn(paintRegion, paintRegion, coverage, RGN_DIFF) == NULLREGION;
+            DeleteRgn(paintRegion);
+            DeleteRgn(coverage);
 
-            if (isFitWidth)
+            LONGLONG paintArea = LONGLONG(ps.rcPaint.right - ps.rcPaint.left) * (ps.rcPaint.bottom - ps.rcPaint.top);
+            if (paintArea > 0)
+            {
+                window->_overdraw = double(drawnArea) / paintArea;
+                window->_overdrawWithoutCulling = double(visibleArea) / paintArea;
+            }
+        }
+
+        // 소프트웨어로 그릴 수 없는 레이아웃이 있으면 GDI 로 그린다.
+        bool isRendered = window->_isParallelRendering &&
+                          CTileRenderer::GetInstance().Render(memDC, ps.rcPaint, window->_layouts,
+                                                              window->GetBackgroundColor(), isBackgroundCovered);
+        if (!isRendered)
+        {
+            if (!isBackgroundCovered)
+            {
+                FillRect(memDC, &ps.rcPaint, window->GetBackgroundBrush());
+            }
+
+            for (auto layout : window->_layouts)
+            {
+                layout->Draw(memDC, ps.rcPaint);
+            }
+        }
+
+        for (size_t i = 0; i < window->_layouts.size(); ++i)
+        {
+            auto layout = window->_layouts[i];
+            if (window->_isOcclusionCulling)
+            {
+                layout->ResetCulling();
+            }
+
+            if (fitSizes[i].first)
             {
                 layout->SetWidth(0);
             }
-            if (isFitHeight)
+            if (fitSizes[i].second)
             {
                 layout->SetHeight(0);
             }
         }
-        BitBlt(hdc, 0, 0, window->GetWidth(), window->GetHeight(), memDC, 0, 0, SRCCOPY);
 
-        SelectBitmap(memDC, oldBitmap);
-        DeleteBitmap(bitmap);
-        DeleteDC(memDC);
+        // 장면 전환 효과는 다 그린 프레임 위에 픽셀 단위로 덧씌운다.
+        if (window->_transition != nullptr && window->_backBufferBits != nullptr)
+        {
+            GdiFlush();
+            CFrameBuffer frame(window->_backBufferBits, window->_backBufferSize.cx, window->_backBufferSize.cy,
+                               window->_backBufferSize.cx);
+            window->_transition->Apply(frame, FrameRect{ps.rcPaint.left, ps.rcPaint.top, ps.rcPaint.right,
+                                                        ps.rcPaint.bottom});
+        }
+
+        // 성능 표시는 모든 레이어 위에 마지막으로 그린다.
+        auto &performanceHud = CPerformanceHud::GetInstance();
+        performanceHud.AddPaint(window, ps.rcPaint);
+        if (performanceHud.IsVisible() && performanceHud.GetWindow() == window)
+        {
+            performanceHud.Draw(memDC, ps.rcPaint);
+        }
+
+        BitBlt(hdc, ps.rcPaint.left, ps.rcPaint.top, ps.rcPaint.right - ps.rcPaint.left,
+               ps.rcPaint.bottom - ps.rcPaint.top, memDC, ps.rcPaint.left, ps.rcPaint.top, SRCCOPY);
+        SelectClipRgn(memDC, nullptr);
 
         EndPaint(hWnd, &ps);
         break;
@@ -958,6 +1027,10 @@ void CWindowControl::RegisterFunctions(lua_State *L)
     LUA_METHOD(GetKeyUpEvent);
     LUA_METHOD(GetMenu);
     LUA_METHOD(GetBackgroundColor);
+    LUA_METHOD(IsOcclusionCulling);
+    LUA_METHOD(IsParallelRendering);
+    LUA_METHOD(GetOverdraw);
+    LUA_METHOD(GetOverdrawWithoutCulling);
 
     LUA_METHOD(SetLuaHeight);
     LUA_METHOD(SetParentWindow);
@@ -976,6 +1049,8 @@ void CWindowControl::RegisterFunctions(lua_State *L)
     LUA_METHOD(SetBackgroundColor);
     LUA_METHOD(SetDialogResult);
     LUA_METHOD(SetMenu);
+    LUA_METHOD(SetOcclusionCulling);
+    LUA_METHOD(SetParallelRendering);
 
     LUA_METHOD(AddLayout);
     LUA_METHOD(DeleteLayout);
@@ -1015,6 +1090,8 @@ CWindowControl::~CWindowControl()
         DeleteBrush(_backBrush);
     }
 
+    _DeleteBackBuffer();
+
     if (_hWnd != nullptr)
     {
         DestroyWindow(_hWnd);
@@ -1130,6 +1207,31 @@ CToolbarControl *CWindowControl::GetToolbar()
     return _toolbar;
 }
 
+bool CWindowControl::IsOcclusionCulling() const
+{
+    return _isOcclusionCulling;
+}
+
+bool CWindowControl::IsParallelRendering() const
+{
+    return _isParallelRendering;
+}
+
+CWindowTransition *CWindowControl::GetTransition()
+{
+    return _transition;
+}
+
+double CWindowControl::GetOverdraw() const
+{
+    return _overdraw;
+}
+
+double CWindowControl::GetOverdrawWithoutCulling() const
+{
+    return _overdrawWithoutCulling;
+}
+
 void CWindowControl::SetY(const int y)
 {
     _position.y = y;
@@ -1481,6 +1583,36 @@ void CWindowControl::SetToolbar(CToolbarControl *toolbar)
     _toolbar = toolbar;
 }
 
+void CWindowControl::SetOcclusionCulling(bool isOcclusionCulling)
+{
+    _isOcclusionCulling = isOcclusionCulling;
+    _overdraw = _overdrawWithoutCulling = 0.0;
+}
+
+void CWindowControl::SetParallelRendering(bool isParallelRendering)
+{
+    _isParallelRendering = isParallelRendering;
+}
+
+void CWindowControl::SetTransition(CWindowTransition *transition)
+{
+    _transition = transition;
+}
+
+bool CWindowControl::CaptureFrame(CFrameBuffer &frame)
+{
+    // 백 버퍼에는 마지막으로 그린 화면이 그대로 남아 있다.
+    if (_backBufferBits == nullptr)
+    {
+        return false;
+    }
+
+    GdiFlush();
+    frame.Resize(_backBufferSize.cx, _backBufferSize.cy);
+    memcpy(frame.GetPixels(), _backBufferBits, sizeof(uint32_t) * _backBufferSize.cx * _backBufferSize.cy);
+    return true;
+}
+
 void CWindowControl::AddLayout(CLayoutControl *layout, bool isShow)
 {
     layout->SetHide(!isShow);
@@ -1634,6 +1766,11 @@ int CWindowControl::ShowModalWindow()
                 break;
             }
         }
+        else
+        {
+            // 모달 창이 떠 있는 동안에는 메인 루프가 돌지 않으므로 여기서 입력을 보낸다.
+            CInputManager::GetInstance().Dispatch();
+        }
     }
     SetWindowPos(_parentControl->GetHWnd(), HWND_NOTOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE);
     EnableWindow(_parentControl->GetHWnd(), TRUE);
@@ -1650,4 +1787,52 @@ void CWindowControl::SetDialogResult(const int value) const
 {
     *_dialogResult = value;
 }
+
+HDC CWindowControl::_GetBackBuffer(HDC hdc)
+{
+    int width = GetWidth() > 0 ? GetWidth() : 1;
+    int height = GetHeight() > 0 ? GetHeight() : 1;
+    if (_backBufferDC != nullptr && _backBufferSize.cx == width && _backBufferSize.cy == height)
+    {
+        return _backBufferDC;
+    }
+
+    _DeleteBackBuffer();
+
+    // 글리프 아틀라스가 픽셀을 직접 쓸 수 있도록 위에서 아래로 쌓인 32비트 DIB 로 만든다.
+    BITMAPINFO bitmapInfo{};
+    bitmapInfo.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bitmapInfo.bmiHeader.biWidth = width;
+    bitmapInfo.bmiHeader.biHeight = -height;
+    bitmapInfo.bmiHeader.biPlanes = 1;
+    bitmapInfo.bmiHeader.biBitCount = 32;
+    bitmapInfo.bmiHeader.biCompression = BI_RGB;
+
+    void *bits = nullptr;
+    _backBufferDC = CreateCompatibleDC(hdc);
+    _backBuffer = CreateDIBSection(hdc, &bitmapInfo, DIB_RGB_COLORS, &bits, nullptr, 0);
+    _oldBackBuffer = SelectBitmap(_backBufferDC, _backBuffer);
+    _backBufferBits = static_cast<uint32_t *>(bits);
+    _backBufferSize.cx = width;
+    _backBufferSize.cy = height;
+
+    return _backBufferDC;
+}
+
+void CWindowControl::_DeleteBackBuffer()
+{
+    if (_backBufferDC != nullptr)
+    {
+        SelectBitmap(_backBufferDC, _oldBackBuffer);
+        DeleteBitmap(_backBuffer);
+        DeleteDC(_backBufferDC);
+
+        _backBufferDC = nullptr;
+        _backBuffer = nullptr;
+        _oldBackBuffer = nullptr;
+        _backBufferBits = nullptr;
+    }
+    _backBufferSize.cx = 0;
+    _backBufferSize.cy = 0;
+}
 } // namespace jojogame
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "BaseControl.h"
+#include "BaseLib\FrameBuffer.h"
 #include "LuaLib\LuaTinker.h"
 
 #include <Windows.h>
@@ -14,6 +15,7 @@ class CMoviePlayer;
 class CMenu;
 class CLayoutControl;
 class CToolbarControl;
+class CWindowTransition;
 
 class CWindowControl : public CBaseControl
 {
@@ -41,6 +43,11 @@ public:
     HBRUSH GetBackgroundBrush();
     CMenu *GetMenu();
     CToolbarControl *GetToolbar();
+    bool IsOcclusionCulling() const;
+    bool IsParallelRendering() const;
+    double GetOverdraw() const;
+    double GetOverdrawWithoutCulling() const;
+    CWindowTransition *GetTransition();
 
     void SetY(int y) override;
     void SetX(int x) override;
@@ -63,6 +70,11 @@ public:
     void SetMenu(CMenu *menu);
     void SetParentWindow(CWindowControl *parent);
     void SetToolbar(CToolbarControl *toolbar);
+    void SetOcclusionCulling(bool isOcclusionCulling);
+    void SetParallelRendering(bool isParallelRendering);
+    void SetTransition(CWindowTransition *transition);
+
+    bool CaptureFrame(CFrameBuffer &frame);
 
     void AddLayout(CLayoutControl *layout, bool isShow);
     void DeleteLayout(CLayoutControl *layout);
@@ -79,6 +91,9 @@ public:
     static LRESULT CALLBACK OnControlProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
 private:
+    HDC _GetBackBuffer(HDC hdc);
+    void _DeleteBackBuffer();
+
     bool _isMaxButton = false;
     bool _isMinButton = true;
     bool _isControlBox = true;
@@ -101,5 +116,17 @@ private:
     std::vector<CLayoutControl *> _layouts;
     CMenu *_menu = nullptr;
     CToolbarControl *_toolbar = nullptr;
+    CWindowTransition *_transition = nullptr;
+
+    bool _isOcclusionCulling = true;
+    bool _isParallelRendering = false;
+    double _overdraw = 0.0;
+    double _overdrawWithoutCulling = 0.0;
+
+    HDC _backBufferDC = nullptr;
+    HBITMAP _backBuffer = nullptr;
+    HBITMAP _oldBackBuffer = nullptr;
+    uint32_t *_backBufferBits = nullptr;
+    SIZE _backBufferSize{0, 0};
 };
 } // namespace jojogame
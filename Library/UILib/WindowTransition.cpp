@@ -0,0 +1,253 @@
+#include "WindowTransition.h"
+
+#include "AnimationManager.h"
+#include "WindowControl.h"
+#include "BaseLib\FrameBlend.h"
+
+#include <cstring>
+
+namespace jojogame
+{
+void CWindowTransition::RegisterFunctions(lua_State *L)
+{
+    LUA_BEGIN(CWindowTransition, "_Transition");
+
+    LUA_METHOD(GetType);
+    LUA_METHOD(GetDuration);
+    LUA_METHOD(GetColor);
+    LUA_METHOD(GetProgress);
+    LUA_METHOD(IsPlaying);
+
+    LUA_METHOD(SetType);
+    LUA_METHOD(SetDuration);
+    LUA_METHOD(SetColor);
+    LUA_METHOD(SetEndEvent);
+
+    LUA_METHOD(Play);
+    LUA_METHOD(Stop);
+
+    lua_tinker::set(L, "TRANSITION_FADE_OUT", static_cast<int>(TRANSITION_FADE_OUT));
+    lua_tinker::set(L, "TRANSITION_FADE_IN", static_cast<int>(TRANSITION_FADE_IN));
+    lua_tinker::set(L, "TRANSITION_CROSSFADE", static_cast<int>(TRANSITION_CROSSFADE));
+    lua_tinker::set(L, "TRANSITION_WIPE", static_cast<int>(TRANSITION_WIPE));
+}
+
+CWindowTransition::CWindowTransition(CWindowControl *window) : _window(window)
+{
+}
+
+CWindowTransition::~CWindowTransition()
+{
+    CAnimationManager::GetInstance().RemoveTransition(this);
+
+    if (_window != nullptr && _window->GetTransition() == this)
+    {
+        _window->SetTransition(nullptr);
+    }
+
+    if (_endEvent != LUA_NOREF)
+    {
+        luaL_unref(CLuaTinker::GetLuaTinker().GetLuaState(), LUA_REGISTRYINDEX, _endEvent);
+    }
+}
+
+int CWindowTransition::GetType() const
+{
+    return _type;
+}
+
+int CWindowTransition::GetDuration() const
+{
+    return _duration;
+}
+
+COLORREF CWindowTransition::GetColor() const
+{
+    return _color;
+}
+
+double CWindowTransition::GetProgress() const
+{
+    if (_duration <= 0)
+    {
+        return 1.0;
+    }
+
+    return _elapsed >= _duration ? 1.0 : double(_elapsed) / _duration;
+}
+
+bool CWindowTransition::IsPlaying() const
+{
+    return _isPlaying;
+}
+
+void CWindowTransition::SetType(int type)
+{
+    _type = type;
+}
+
+void CWindowTransition::SetDuration(int duration)
+{
+    _duration = duration > 0 ? duration : 0;
+}
+
+void CWindowTransition::SetColor(COLORREF color)
+{
+    _color = color;
+}
+
+void CWindowTransition::SetEndEvent()
+{
+    auto l = CLuaTinker::GetLuaTinker().GetLuaState();
+    if (lua_isfunction(l, -1))
+    {
+        if (_endEvent != LUA_NOREF)
+        {
+            luaL_unref(l, LUA_REGISTRYINDEX, _endEvent);
+        }
+
+        lua_pushvalue(l, -1);
+        _endEvent = luaL_ref(l, LUA_REGISTRYINDEX);
+    }
+
+    lua_pop(l, 1);
+}
+
+void CWindowTransition::Play()
+{
+    if (_window == nullptr)
+    {
+        return;
+    }
+
+    if (_type == TRANSITION_CROSSFADE || _type == TRANSITION_WIPE)
+    {
+        if (!_window->CaptureFrame(_fromFrame))
+        {
+            return;
+        }
+    }
+
+    _elapsed = 0;
+    _isPlaying = true;
+    _window->SetTransition(this);
+    CAnimationManager::GetInstance().AddTransition(this);
+    _Invalidate();
+}
+
+void CWindowTransition::Stop()
+{
+    _isPlaying = false;
+
+    if (_window != nullptr && _window->GetTransition() == this)
+    {
+        _window->SetTransition(nullptr);
+        _Invalidate();
+    }
+}
+
+void CWindowTransition::Update(int elapsed)
+{
+    if (!_isPlaying)
+    {
+        return;
+    }
+
+    _elapsed += elapsed;
+    _Invalidate();
+
+    if (_elapsed < _duration)
+    {
+        return;
+    }
+
+    _elapsed = _duration;
+    _isPlaying = false;
+
+    // 페이드 아웃은 다음 전환이 올 때까지 색을 덮은 채로 남겨 둔다.
+    if (_type != TRANSITION_FADE_OUT && _window->GetTransition() == this)
+    {
+        _window->SetTransition(nullptr);
+    }
+    _fromFrame.Resize(0, 0);
+
+    if (_endEvent != LUA_NOREF)
+    {
+        CLuaTinker::GetLuaTinker().Call(_endEvent, this);
+    }
+}
+
+void CWindowTransition::Apply(CFrameBuffer &frame, const FrameRect &rect)
+{
+    FrameRect applyRect;
+    if (!CFrameBuffer::IntersectFrameRect(applyRect, rect, frame.GetBounds()))
+    {
+        return;
+    }
+
+    int weight = int(GetProgress() * 256);
+    int width = applyRect.right - applyRect.left;
+    uint32_t color = 0xFF000000 | (GetRValue(_color) << 16) | (GetGValue(_color) << 8) | GetBValue(_color);
+
+    switch (_type)
+    {
+    case TRANSITION_FADE_OUT:
+    case TRANSITION_FADE_IN:
+    {
+        int colorWeight = _type == TRANSITION_FADE_OUT ? weight : 256 - weight;
+        for (int y = applyRect.top; y < applyRect.bottom; ++y)
+        {
+            auto row = frame.GetRow(y) + applyRect.left;
+            FadePixels(row, row, width, color, colorWeight);
+        }
+        break;
+    }
+    case TRANSITION_CROSSFADE:
+    {
+        // 창 크기가 바뀌어 찍어 둔 화면과 맞지 않으면 현재 화면만 보여 준다.
+        if (_fromFrame.GetWidth() != frame.GetWidth() || _fromFrame.GetHeight() != frame.GetHeight())
+        {
+            break;
+        }
+
+        for (int y = applyRect.top; y < applyRect.bottom; ++y)
+        {
+            auto row = frame.GetRow(y) + applyRect.left;
+            CrossfadePixels(row, _fromFrame.GetRow(y) + applyRect.left, row, width, weight);
+        }
+        break;
+    }
+    case TRANSITION_WIPE:
+    {
+        if (_fromFrame.GetWidth() != frame.GetWidth() || _fromFrame.GetHeight() != frame.GetHeight())
+        {
+            break;
+        }
+
+        // 왼쪽에서부터 현재 화면이 드러난다.
+        int boundary = int(GetProgress() * frame.GetWidth());
+        int left = boundary > applyRect.left ? boundary : applyRect.left;
+        if (left >= applyRect.right)
+        {
+            break;
+        }
+
+        for (int y = applyRect.top; y < applyRect.bottom; ++y)
+        {
+            memcpy(frame.GetRow(y) + left, _fromFrame.GetRow(y) + left, sizeof(uint32_t) * (applyRect.right - left));
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void CWindowTransition::_Invalidate()
+{
+    if (_window != nullptr && _window->GetHWnd() != nullptr)
+    {
+        InvalidateRect(_window->GetHWnd(), nullptr, FALSE);
+    }
+}
+} // namespace jojogame
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "BaseLib\FrameBuffer.h"
+#include "LuaLib\LuaTinker.h"
+
+#include <Windows.h>
+
+namespace jojogame
+{
+class CWindowControl;
+
+enum TRANSITION_TYPE
+{
+    TRANSITION_FADE_OUT = 0,
+    TRANSITION_FADE_IN = 1,
+    TRANSITION_CROSSFADE = 2,
+    TRANSITION_WIPE = 3,
+};
+
+// 창 전체 프레임에 덧씌우는 장면 전환 효과
+class CWindowTransition
+{
+public:
+    static void RegisterFunctions(lua_State *L);
+
+    CWindowTransition(CWindowControl *window);
+    virtual ~CWindowTransition();
+
+    int GetType() const;
+    int GetDuration() const;
+    COLORREF GetColor() const;
+    double GetProgress() const;
+    bool IsPlaying() const;
+
+    void SetType(int type);
+    void SetDuration(int duration);
+    void SetColor(COLORREF color);
+    void SetEndEvent();
+
+    void Play();
+    void Stop();
+
+    void Update(int elapsed);
+    void Apply(CFrameBuffer &frame, const FrameRect &rect);
+
+private:
+    void _Invalidate();
+
+    CWindowControl *_window;
+    int _type = TRANSITION_FADE_OUT;
+    int _duration = 500;
+    int _elapsed = 0;
+    COLORREF _color = RGB(0, 0, 0);
+    bool _isPlaying = false;
+
+    // 교차 페이드와 와이프는 시작할 때 화면을 찍어 둔 것에서 현재 화면으로 넘어간다.
+    CFrameBuffer _fromFrame;
+
+    int _endEvent = LUA_NOREF;
+};
+} // namespace jojogame
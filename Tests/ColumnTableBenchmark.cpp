@@ -0,0 +1,125 @@
+#include "Test.h"
+
+#include "BaseLib/ColumnTable.h"
+
+#include <random>
+#include <string>
+
+using namespace jojogame;
+
+namespace
+{
+const int ROW_COUNT = 10000;
+const int VISIBLE_ROW_COUNT = 30;
+const int REPEAT_COUNT = 20;
+const double FRAME_BUDGET = 1.0 / 60.0;
+
+// 읽은 글자 수를 남겨서 최적화로 읽기가 빠지지 않게 한다.
+volatile size_t s_textLength = 0;
+
+void FillTable(CColumnTable &table)
+{
+    std::mt19937 random(1234);
+    std::uniform_int_distribution<int> levelDistribution(1, 50);
+    std::uniform_int_distribution<int> statDistribution(1, 100);
+    std::uniform_int_distribution<int> syllableDistribution(0, 2349);
+
+    int name = table.AddStringColumn();
+    int columns[5];
+    for (auto &column : columns)
+    {
+        column = table.AddNumberColumn();
+    }
+
+    for (int i = 0; i < ROW_COUNT; ++i)
+    {
+        int row = table.AddRow();
+
+        std::wstring text;
+        for (int j = 0; j < 3; ++j)
+        {
+            text += wchar_t(0xAC00 + syllableDistribution(random));
+        }
+        table.SetString(row, name, text);
+
+        table.SetNumber(row, columns[0], levelDistribution(random));
+        for (int j = 1; j < 5; ++j)
+        {
+            table.SetNumber(row, columns[j], statDistribution(random));
+        }
+    }
+}
+
+// 보이는 행의 셀 글자를 만드는 데까지 포함해야 리스트뷰가 실제로 하는 일과 같다.
+size_t ReadVisibleRows(const CColumnTable &table)
+{
+    size_t length = 0;
+    for (int i = 0; i < VISIBLE_ROW_COUNT && i < table.GetViewRowCount(); ++i)
+    {
+        for (int column = 0; column < table.GetColumnCount(); ++column)
+        {
+            length += table.GetText(table.GetViewRow(i), column).size();
+        }
+    }
+
+    return length;
+}
+
+template <typename Function>
+void Measure(const char *name, CColumnTable &table, Function function)
+{
+    size_t length = 0;
+    double begin = test::GetSeconds();
+    for (int i = 0; i < REPEAT_COUNT; ++i)
+    {
+        function(table);
+        table.Update();
+        length += ReadVisibleRows(table);
+    }
+    double elapsed = (test::GetSeconds() - begin) / REPEAT_COUNT;
+
+    s_textLength = length;
+
+    std::printf("%-32s %8.3f ms %6.1f%% of a frame, %5d rows\n", name, elapsed * 1000.0,
+                elapsed / FRAME_BUDGET * 100.0, table.GetViewRowCount());
+}
+} // namespace
+
+int main()
+{
+    CColumnTable table;
+
+    double begin = test::GetSeconds();
+    FillTable(table);
+    std::printf("ColumnTable: %d rows, fill %.3f ms\n", ROW_COUNT, (test::GetSeconds() - begin) * 1000.0);
+
+    Measure("no sort, no filter", table, [](CColumnTable &) {});
+    Measure("sort level desc", table, [](CColumnTable &target) {
+        target.ClearSortKeys();
+        target.AddSortKey(1, false);
+    });
+    Measure("sort level desc, attack asc", table, [](CColumnTable &target) {
+        target.ClearSortKeys();
+        target.AddSortKey(1, false);
+        target.AddSortKey(2, true);
+    });
+    Measure("sort name asc", table, [](CColumnTable &target) {
+        target.ClearSortKeys();
+        target.AddSortKey(0, true);
+    });
+    Measure("range filter + 2-key sort", table, [](CColumnTable &target) {
+        target.ClearFilters();
+        target.AddRangeFilter(1, 10, 30);
+        target.ClearSortKeys();
+        target.AddSortKey(1, false);
+        target.AddSortKey(2, true);
+    });
+    Measure("prefix filter + name sort", table, [](CColumnTable &target) {
+        target.ClearFilters();
+        target.AddPrefixFilter(0, std::wstring(1, wchar_t(0xAC00 + 588)));
+        target.ClearSortKeys();
+        target.AddSortKey(0, true);
+    });
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include "Test.h"
+
+#include "BaseLib/ColumnTable.h"
+
+using namespace jojogame;
+
+namespace
+{
+// 이름, 레벨, 공격력 세 열을 가진 표
+void FillTable(CColumnTable &table)
+{
+    const wchar_t *names[] = {L"Cao Cao", L"Xiahou Dun", L"Cao Ren", L"Xu Chu", L"Cao Hong"};
+    const double levels[] = {10, 8, 8, 9, 8};
+    const double attacks[] = {70, 90, 75, 95, 72.5};
+
+    int name = table.AddStringColumn();
+    int level = table.AddNumberColumn();
+    int attack = table.AddNumberColumn();
+    for (int i = 0; i < 5; ++i)
+    {
+        int row = table.AddRow();
+        table.SetString(row, name, names[i]);
+        table.SetNumber(row, level, levels[i]);
+        table.SetNumber(row, attack, attacks[i]);
+    }
+}
+
+void TestCells()
+{
+    CColumnTable table;
+    FillTable(table);
+
+    TEST_CHECK(table.GetColumnCount() == 3);
+    TEST_CHECK(table.GetRowCount() == 5);
+    TEST_CHECK(table.GetColumnType(0) == COLUMN_TABLE_STRING);
+    TEST_CHECK(table.GetColumnType(1) == COLUMN_TABLE_NUMBER);
+    TEST_CHECK(table.GetColumnType(3) == -1);
+    TEST_CHECK(table.GetString(1, 0) == L"Xiahou Dun");
+    TEST_CHECK(table.GetNumber(3, 2) == 95);
+
+    // 다른 형식의 열이나 범위 밖은 기본값을 돌려준다.
+    TEST_CHECK(table.GetString(1, 1) == L"");
+    TEST_CHECK(table.GetNumber(5, 1) == 0.0);
+    TEST_CHECK(table.GetText(0, 1) == L"10");
+    TEST_CHECK(table.GetText(4, 2) == L"72.5");
+    TEST_CHECK(table.GetText(-1, 0) == L"");
+}
+
+void TestViewBeforeUpdate()
+{
+    CColumnTable table;
+    FillTable(table);
+
+    TEST_CHECK(table.GetViewRowCount() == 0);
+    TEST_CHECK(table.GetViewRow(0) == -1);
+
+    table.Update();
+    TEST_CHECK(table.GetViewRowCount() == 5);
+    for (int i = 0; i < 5; ++i)
+    {
+        TEST_CHECK(table.GetViewRow(i) == i);
+    }
+}
+
+void TestStableMultiKeySort()
+{
+    CColumnTable table;
+    FillTable(table);
+
+    // 레벨 내림차순, 같은 레벨은 원래 순서를 지킨다.
+    TEST_CHECK(table.AddSortKey(1, false));
+    table.Update();
+    int expected[] = {0, 3, 1, 2, 4};
+    for (int i = 0; i < 5; ++i)
+    {
+        TEST_CHECK(table.GetViewRow(i) == expected[i]);
+    }
+
+    // 두 번째 키로 같은 레벨 안에서 공격력 오름차순
+    TEST_CHECK(table.AddSortKey(2, true));
+    table.Update();
+    int expectedByAttack[] = {0, 3, 4, 2, 1};
+    for (int i = 0; i < 5; ++i)
+    {
+        TEST_CHECK(table.GetViewRow(i) == expectedByAttack[i]);
+    }
+
+    TEST_CHECK(!table.AddSortKey(3, true));
+}
+
+void TestFilters()
+{
+    CColumnTable table;
+    FillTable(table);
+
+    TEST_CHECK(table.AddPrefixFilter(0, L"Cao"));
+    table.Update();
+    TEST_CHECK(table.GetViewRowCount() == 3);
+    TEST_CHECK(table.GetViewRow(0) == 0 && table.GetViewRow(1) == 2 && table.GetViewRow(2) == 4);
+
+    TEST_CHECK(table.AddRangeFilter(2, 72, 80));
+    table.Update();
+    TEST_CHECK(table.GetViewRowCount() == 2);
+    TEST_CHECK(table.GetViewRow(0) == 2 && table.GetViewRow(1) == 4);
+
+    // 형식이 맞지 않는 필터는 받지 않는다.
+    TEST_CHECK(!table.AddPrefixFilter(1, L"1"));
+    TEST_CHECK(!table.AddRangeFilter(0, 0, 1));
+
+    table.ClearFilters();
+    table.Update();
+    TEST_CHECK(table.GetViewRowCount() == 5);
+}
+
+void TestClear()
+{
+    CColumnTable table;
+    FillTable(table);
+    table.Update();
+
+    table.Clear();
+    TEST_CHECK(table.GetRowCount() == 0);
+    TEST_CHECK(table.GetViewRowCount() == 0);
+    TEST_CHECK(table.GetColumnCount() == 3);
+
+    int row = table.AddRow();
+    TEST_CHECK(row == 0);
+    TEST_CHECK(table.GetString(0, 0) == L"");
+    TEST_CHECK(table.GetNumber(0, 1) == 0.0);
+}
+} // namespace
+
+int main()
+{
+    TEST_RUN(TestCells);
+    TEST_RUN(TestViewBeforeUpdate);
+    TEST_RUN(TestStableMultiKeySort);
+    TEST_RUN(TestFilters);
+    TEST_RUN(TestClear);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,241 @@
+#include "Test.h"
+
+#include "BaseLib/FrameScheduler.h"
+
+using namespace jojogame;
+
+namespace
+{
+const int64_t MILLISECOND = 1000000;
+const int64_t TIMESTEP = 16 * MILLISECOND;
+
+// 테스트가 직접 시각을 옮기는 시계
+class CFakeFrameClock : public IFrameClock
+{
+public:
+    CFakeFrameClock(int64_t *now) : _now(now)
+    {
+    }
+
+    int64_t GetNow() override
+    {
+        return *_now;
+    }
+
+private:
+    int64_t *_now;
+};
+
+std::unique_ptr<IFrameClock> CreateClock(int64_t *now)
+{
+    return std::unique_ptr<IFrameClock>(new CFakeFrameClock(now));
+}
+
+void TestAdvanceCountsWholeSteps()
+{
+    int64_t now = 1000 * MILLISECOND;
+    CFrameScheduler scheduler(CreateClock(&now));
+    scheduler.SetTimestep(TIMESTEP);
+    scheduler.Start();
+
+    TEST_CHECK(scheduler.Advance() == 0);
+
+    now += TIMESTEP * 5 / 2;
+    TEST_CHECK(scheduler.Advance() == 2);
+    TEST_CHECK(scheduler.GetInterpolationAlpha() == 0.5);
+    TEST_CHECK(scheduler.GetLateFrameCount() == 1);
+
+    now += TIMESTEP / 2;
+    TEST_CHECK(scheduler.Advance() == 1);
+    TEST_CHECK(scheduler.GetInterpolationAlpha() == 0.0);
+    TEST_CHECK(scheduler.GetSkippedUpdateCount() == 0);
+}
+
+void TestCatchUpDropClamps()
+{
+    int64_t now = 0;
+    CFrameScheduler scheduler(CreateClock(&now));
+    scheduler.SetTimestep(TIMESTEP);
+    scheduler.SetMaxCatchUpSteps(5);
+    scheduler.SetCatchUpPolicy(FRAME_CATCH_UP_DROP);
+    scheduler.Start();
+
+    // 멈춰 있던 동안 밀린 10 스텝 중 5 스텝만 돌리고 나머지는 버린다.
+    now += TIMESTEP * 10 + TIMESTEP / 4;
+    TEST_CHECK(scheduler.Advance() == 5);
+    TEST_CHECK(scheduler.GetSkippedUpdateCount() == 5);
+    TEST_CHECK(scheduler.GetInterpolationAlpha() == 0.25);
+
+    TEST_CHECK(scheduler.Advance() == 0);
+
+    scheduler.ResetCounters();
+    TEST_CHECK(scheduler.GetSkippedUpdateCount() == 0);
+    TEST_CHECK(scheduler.GetLateFrameCount() == 0);
+}
+
+void TestCatchUpDilateSpreadsLag()
+{
+    int64_t now = 0;
+    CFrameScheduler scheduler(CreateClock(&now));
+    scheduler.SetTimestep(TIMESTEP);
+    scheduler.SetMaxCatchUpSteps(5);
+    scheduler.SetCatchUpPolicy(FRAME_CATCH_UP_DILATE);
+    scheduler.Start();
+
+    // 20 스텝이 밀리면 5 스텝을 돌리고, 넘겨 둘 수 있는 10 스텝을 넘는 5 스텝은 버린다.
+    now += TIMESTEP * 20;
+    TEST_CHECK(scheduler.Advance() == 5);
+    TEST_CHECK(scheduler.GetSkippedUpdateCount() == 5);
+    TEST_CHECK(scheduler.GetInterpolationAlpha() == 1.0);
+
+    TEST_CHECK(scheduler.Advance() == 5);
+    TEST_CHECK(scheduler.Advance() == 5);
+    TEST_CHECK(scheduler.Advance() == 0);
+    TEST_CHECK(scheduler.GetSkippedUpdateCount() == 5);
+}
+
+void TestMaxCatchUpStepsIsAtLeastOne()
+{
+    int64_t now = 0;
+    CFrameScheduler scheduler(CreateClock(&now));
+    scheduler.SetMaxCatchUpSteps(0);
+    TEST_CHECK(scheduler.GetMaxCatchUpSteps() == 1);
+
+    scheduler.SetTimestep(0);
+    TEST_CHECK(scheduler.GetTimestep() == 1);
+}
+
+void TestUncappedRendersOnlyWhenDirty()
+{
+    int64_t now = 0;
+    CFrameScheduler scheduler(CreateClock(&now));
+    scheduler.SetPacing(FRAME_PACING_UNCAPPED);
+    scheduler.Start();
+
+    // 시작 직후에는 첫 화면을 그려야 한다.
+    TEST_CHECK(scheduler.ShouldRender(false));
+    scheduler.OnRendered();
+
+    TEST_CHECK(!scheduler.ShouldRender(false));
+    TEST_CHECK(scheduler.ShouldRender(true));
+    TEST_CHECK(scheduler.ShouldRender(false));
+    scheduler.OnRendered();
+    TEST_CHECK(!scheduler.ShouldRender(false));
+}
+
+void TestFixedPacing()
+{
+    int64_t now = 0;
+    CFrameScheduler scheduler(CreateClock(&now));
+    scheduler.SetTargetFrameRate(50);
+    scheduler.SetPacing(FRAME_PACING_FIXED);
+    scheduler.Start();
+
+    TEST_CHECK(scheduler.ShouldRender(true));
+    scheduler.OnRendered();
+
+    // 50 fps 는 20ms 간격이고, 그 사이에 더러워져도 간격을 지킨다.
+    now = 10 * MILLISECOND;
+    TEST_CHECK(!scheduler.ShouldRender(true));
+    now = 19 * MILLISECOND;
+    TEST_CHECK(!scheduler.ShouldRender(false));
+    now = 20 * MILLISECOND;
+    TEST_CHECK(scheduler.ShouldRender(false));
+    scheduler.OnRendered();
+
+    // 제때 그리면 다음 시각은 그린 시각이 아니라 예정 시각 기준으로 잡힌다.
+    now = 45 * MILLISECOND;
+    TEST_CHECK(scheduler.ShouldRender(true));
+    now = 47 * MILLISECOND;
+    scheduler.OnRendered();
+    now = 59 * MILLISECOND;
+    TEST_CHECK(!scheduler.ShouldRender(true));
+    now = 60 * MILLISECOND;
+    TEST_CHECK(scheduler.ShouldRender(true));
+}
+
+void TestLateRenderRestartsInterval()
+{
+    int64_t now = 0;
+    CFrameScheduler scheduler(CreateClock(&now));
+    scheduler.SetTargetFrameRate(50);
+    scheduler.SetPacing(FRAME_PACING_FIXED);
+    scheduler.Start();
+
+    TEST_CHECK(scheduler.ShouldRender(true));
+    scheduler.OnRendered();
+
+    // 세 간격 넘게 늦었으면 밀린 프레임을 몰아 그리지 않고 지금부터 20ms 뒤를 기다린다.
+    now = 75 * MILLISECOND;
+    TEST_CHECK(scheduler.ShouldRender(true));
+    scheduler.OnRendered();
+    now = 94 * MILLISECOND;
+    TEST_CHECK(!scheduler.ShouldRender(true));
+    now = 95 * MILLISECOND;
+    TEST_CHECK(scheduler.ShouldRender(true));
+}
+
+void TestVsyncUsesRefreshRate()
+{
+    int64_t now = 0;
+    CFrameScheduler scheduler(CreateClock(&now));
+    scheduler.SetTargetFrameRate(30);
+    scheduler.SetRefreshRate(100);
+    scheduler.SetPacing(FRAME_PACING_VSYNC);
+    scheduler.Start();
+
+    TEST_CHECK(scheduler.ShouldRender(true));
+    scheduler.OnRendered();
+    now = 9 * MILLISECOND;
+    TEST_CHECK(!scheduler.ShouldRender(true));
+    now = 10 * MILLISECOND;
+    TEST_CHECK(scheduler.ShouldRender(true));
+}
+
+void TestWaitTime()
+{
+    int64_t now = 0;
+    CFrameScheduler scheduler(CreateClock(&now));
+    scheduler.SetTimestep(TIMESTEP);
+    scheduler.SetTargetFrameRate(125);
+    scheduler.SetPacing(FRAME_PACING_FIXED);
+    scheduler.Start();
+
+    TEST_CHECK(scheduler.ShouldRender(true));
+    scheduler.OnRendered();
+
+    // 그릴 것이 없으면 다음 업데이트 시각까지 쉰다.
+    now = 5 * MILLISECOND;
+    TEST_CHECK(scheduler.Advance() == 0);
+    TEST_CHECK(scheduler.GetWaitTime() == TIMESTEP - 5 * MILLISECOND);
+
+    // 그릴 것이 있으면 다음 화면 갱신 시각(8ms)이 더 빠르다.
+    TEST_CHECK(!scheduler.ShouldRender(true));
+    TEST_CHECK(scheduler.GetWaitTime() == 3 * MILLISECOND);
+
+    now = 20 * MILLISECOND;
+    TEST_CHECK(scheduler.GetWaitTime() == 0);
+
+    scheduler.SetPacing(FRAME_PACING_UNCAPPED);
+    now = 21 * MILLISECOND;
+    TEST_CHECK(scheduler.Advance() == 1);
+    TEST_CHECK(scheduler.GetWaitTime() == 0);
+    scheduler.OnRendered();
+    TEST_CHECK(scheduler.GetWaitTime() == TIMESTEP - 5 * MILLISECOND);
+}
+} // namespace
+
+int main()
+{
+    TEST_RUN(TestAdvanceCountsWholeSteps);
+    TEST_RUN(TestCatchUpDropClamps);
+    TEST_RUN(TestCatchUpDilateSpreadsLag);
+    TEST_RUN(TestMaxCatchUpStepsIsAtLeastOne);
+    TEST_RUN(TestUncappedRendersOnlyWhenDirty);
+    TEST_RUN(TestFixedPacing);
+    TEST_RUN(TestLateRenderRestartsInterval);
+    TEST_RUN(TestVsyncUsesRefreshRate);
+    TEST_RUN(TestWaitTime);
+
+    return TEST_RESULT();
+}
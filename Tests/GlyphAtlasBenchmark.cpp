@@ -0,0 +1,204 @@
+#include "Test.h"
+
+#include "BaseLib/GlyphAtlas.h"
+
+#ifdef _WIN32
+// 윈도우에서는 UILib/GdiGlyphSource.cpp 와 gdi32.lib 를 함께 빌드하면 DrawText 와 직접 비교한다.
+#include "UILib/GdiGlyphSource.h"
+#endif
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace jojogame;
+
+namespace
+{
+const int FRAME_COUNT = 200;
+const int TARGET_WIDTH = 640;
+const int TARGET_HEIGHT = 400;
+const int GLYPH_SIZE = 14;
+
+// GDI 없이 원 모양 커버리지를 계산하는 소스 (래스터화 비용을 흉내낸다)
+class CSyntheticGlyphSource : public IGlyphSource
+{
+public:
+    int GetLineHeight() const override
+    {
+        return GLYPH_SIZE + 2;
+    }
+
+    bool RasterizeGlyph(wchar_t ch, GlyphBitmap &glyph) override
+    {
+        glyph.advance = ch < 0x80 ? GLYPH_SIZE / 2 + 1 : GLYPH_SIZE + 1;
+        glyph.offsetX = 0;
+        glyph.offsetY = 1;
+        glyph.width = ch == L' ' ? 0 : glyph.advance - 1;
+        glyph.height = ch == L' ' ? 0 : GLYPH_SIZE;
+        glyph.coverage.resize(size_t(glyph.width) * glyph.height);
+
+        double radius = glyph.height / 2.0;
+        for (int y = 0; y < glyph.height; ++y)
+        {
+            for (int x = 0; x < glyph.width; ++x)
+            {
+                double dx = (x + 0.5 - glyph.width / 2.0) / (glyph.width / 2.0) * radius;
+                double dy = y + 0.5 - radius;
+                double distance = std::sqrt(dx * dx + dy * dy);
+                double coverage = radius - distance;
+                coverage = coverage < 0.0 ? 0.0 : (coverage > 1.0 ? 1.0 : coverage);
+                glyph.coverage[size_t(y) * glyph.width + x] = uint8_t(coverage * 255);
+            }
+        }
+
+        return true;
+    }
+};
+
+// 대화창 한 장 분량: 한글 문장 여러 줄과 숫자가 섞인 목록 줄
+std::vector<std::wstring> CreateDialogueLines()
+{
+    std::vector<std::wstring> lines;
+    for (int i = 0; i < 20; ++i)
+    {
+        std::wstring line;
+        for (int j = 0; j < 24; ++j)
+        {
+            line += wchar_t(0xAC00 + (i * 131 + j * 17) % 2350);
+            if (j % 5 == 4)
+            {
+                line += L' ';
+            }
+        }
+        line += L" HP " + std::to_wstring(100 + i * 7) + L"/" + std::to_wstring(250 + i);
+        lines.push_back(line);
+    }
+
+    return lines;
+}
+
+size_t CountCharacters(const std::vector<std::wstring> &lines)
+{
+    size_t count = 0;
+    for (auto &line : lines)
+    {
+        count += line.size();
+    }
+
+    return count;
+}
+
+void DrawFrame(CGlyphAtlas &atlas, CFrameBuffer &target, const std::vector<std::wstring> &lines)
+{
+    int y = 0;
+    for (auto &line : lines)
+    {
+        atlas.DrawString(target, 4, y, line, 0xFFFFFFFF, target.GetBounds());
+        y += atlas.GetLineHeight();
+    }
+}
+
+void Report(const char *name, double seconds, size_t characters)
+{
+    std::printf("%-28s %8.3f ms/frame %10.1f Mglyph/s\n", name, seconds * 1000.0 / FRAME_COUNT,
+                characters * double(FRAME_COUNT) / seconds / 1000000.0);
+}
+
+void BenchmarkSynthetic(const std::vector<std::wstring> &lines, size_t characters)
+{
+    CFrameBuffer target(TARGET_WIDTH, TARGET_HEIGHT);
+
+    // 매번 래스터화하는 경우 (DrawText 처럼 그릴 때마다 글자 모양을 다시 만든다)
+    double begin = test::GetSeconds();
+    for (int frame = 0; frame < FRAME_COUNT; ++frame)
+    {
+        CGlyphAtlas atlas(std::unique_ptr<IGlyphSource>(new CSyntheticGlyphSource()));
+        DrawFrame(atlas, target, lines);
+    }
+    Report("synthetic, rasterize/frame", test::GetSeconds() - begin, characters);
+
+    CGlyphAtlas atlas(std::unique_ptr<IGlyphSource>(new CSyntheticGlyphSource()));
+    DrawFrame(atlas, target, lines);
+
+    begin = test::GetSeconds();
+    for (int frame = 0; frame < FRAME_COUNT; ++frame)
+    {
+        DrawFrame(atlas, target, lines);
+    }
+    Report("synthetic, atlas", test::GetSeconds() - begin, characters);
+}
+
+#ifdef _WIN32
+void BenchmarkGdi(const std::vector<std::wstring> &lines, size_t characters)
+{
+    BITMAPINFO info{};
+    info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    info.bmiHeader.biWidth = TARGET_WIDTH;
+    info.bmiHeader.biHeight = -TARGET_HEIGHT;
+    info.bmiHeader.biPlanes = 1;
+    info.bmiHeader.biBitCount = 32;
+    info.bmiHeader.biCompression = BI_RGB;
+
+    void *bits = nullptr;
+    HDC dc = CreateCompatibleDC(nullptr);
+    HBITMAP bitmap = CreateDIBSection(dc, &info, DIB_RGB_COLORS, &bits, nullptr, 0);
+    HGDIOBJ oldBitmap = SelectObject(dc, bitmap);
+    HFONT font = CreateFontW(GLYPH_SIZE, 0, 0, 0, FW_NORMAL, 0, 0, 0, HANGEUL_CHARSET, 0, 0, 0,
+                             VARIABLE_PITCH | FF_ROMAN, L"\xAD74\xB9BC");
+    HGDIOBJ oldFont = SelectObject(dc, font);
+    SetBkMode(dc, TRANSPARENT);
+    SetTextColor(dc, RGB(255, 255, 255));
+
+    double begin = test::GetSeconds();
+    for (int frame = 0; frame < FRAME_COUNT; ++frame)
+    {
+        int y = 0;
+        for (auto &line : lines)
+        {
+            RECT rect{4, y, TARGET_WIDTH, TARGET_HEIGHT};
+            DrawTextW(dc, line.c_str(), int(line.size()), &rect, DT_NOPREFIX | DT_SINGLELINE);
+            y += GLYPH_SIZE + 2;
+        }
+    }
+    GdiFlush();
+    Report("gdi, DrawText", test::GetSeconds() - begin, characters);
+
+    SelectObject(dc, oldFont);
+
+    // 글리프 소스가 폰트를 선택해 두므로 폰트를 지우기 전에 아틀라스를 먼저 해제한다.
+    {
+        CFrameBuffer target(static_cast<uint32_t *>(bits), TARGET_WIDTH, TARGET_HEIGHT, TARGET_WIDTH);
+        CGlyphAtlas atlas(std::unique_ptr<IGlyphSource>(new CGdiGlyphSource(font)));
+        DrawFrame(atlas, target, lines);
+
+        begin = test::GetSeconds();
+        for (int frame = 0; frame < FRAME_COUNT; ++frame)
+        {
+            DrawFrame(atlas, target, lines);
+        }
+        Report("gdi, atlas", test::GetSeconds() - begin, characters);
+    }
+
+    SelectObject(dc, oldBitmap);
+    DeleteObject(bitmap);
+    DeleteDC(dc);
+    DeleteObject(font);
+}
+#endif
+} // namespace
+
+int main()
+{
+    auto lines = CreateDialogueLines();
+    size_t characters = CountCharacters(lines);
+    std::printf("GlyphAtlas: %d frames of %d lines, %d characters\n", FRAME_COUNT, int(lines.size()),
+                int(characters));
+
+    BenchmarkSynthetic(lines, characters);
+#ifdef _WIN32
+    BenchmarkGdi(lines, characters);
+#endif
+
+    return 0;
+}
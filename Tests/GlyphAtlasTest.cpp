@@ -0,0 +1,179 @@
+#include "Test.h"
+
+#include "BaseLib/GlyphAtlas.h"
+
+using namespace jojogame;
+
+namespace
+{
+const int GLYPH_WIDTH = 6;
+const int GLYPH_HEIGHT = 8;
+const int LINE_HEIGHT = 12;
+
+// 공백은 빈 글리프, 나머지는 꽉 찬 사각형을 돌려주는 글리프 소스
+class CFakeGlyphSource : public IGlyphSource
+{
+public:
+    CFakeGlyphSource(int *rasterizeCount) : _rasterizeCount(rasterizeCount)
+    {
+    }
+
+    int GetLineHeight() const override
+    {
+        return LINE_HEIGHT;
+    }
+
+    bool RasterizeGlyph(wchar_t ch, GlyphBitmap &glyph) override
+    {
+        ++*_rasterizeCount;
+        if (ch == L'\n')
+        {
+            return false;
+        }
+
+        glyph.advance = GLYPH_WIDTH + 1;
+        glyph.offsetX = 0;
+        glyph.offsetY = 1;
+        if (ch == L' ')
+        {
+            glyph.width = 0;
+            glyph.height = 0;
+            return true;
+        }
+
+        glyph.width = GLYPH_WIDTH;
+        glyph.height = GLYPH_HEIGHT;
+        glyph.coverage.assign(size_t(GLYPH_WIDTH) * GLYPH_HEIGHT, 255);
+        return true;
+    }
+
+private:
+    int *_rasterizeCount;
+};
+
+void TestGlyphIsRasterizedOnce()
+{
+    int rasterizeCount = 0;
+    CGlyphAtlas atlas(std::unique_ptr<IGlyphSource>(new CFakeGlyphSource(&rasterizeCount)));
+
+    auto first = atlas.GetGlyph(L'A');
+    auto second = atlas.GetGlyph(L'A');
+    TEST_CHECK(first == second);
+    TEST_CHECK(rasterizeCount == 1);
+    TEST_CHECK(atlas.GetGlyphCount() == 1);
+    TEST_CHECK(atlas.GetLineHeight() == LINE_HEIGHT);
+
+    atlas.MeasureString(L"AAAA");
+    TEST_CHECK(rasterizeCount == 1);
+}
+
+void TestMeasureString()
+{
+    int rasterizeCount = 0;
+    CGlyphAtlas atlas(std::unique_ptr<IGlyphSource>(new CFakeGlyphSource(&rasterizeCount)));
+
+    TEST_CHECK(atlas.MeasureString(L"") == 0);
+    TEST_CHECK(atlas.MeasureString(L"AB C") == 4 * (GLYPH_WIDTH + 1));
+    TEST_CHECK(atlas.MeasureString(L"\xc548\xb155") == 2 * (GLYPH_WIDTH + 1));
+}
+
+void TestEmptyGlyphHasNoPage()
+{
+    int rasterizeCount = 0;
+    CGlyphAtlas atlas(std::unique_ptr<IGlyphSource>(new CFakeGlyphSource(&rasterizeCount)));
+
+    auto space = atlas.GetGlyph(L' ');
+    TEST_CHECK(space->page == -1);
+    TEST_CHECK(space->advance == GLYPH_WIDTH + 1);
+    TEST_CHECK(atlas.GetPageCount() == 0);
+
+    // 래스터화에 실패한 글자도 다시 묻지 않도록 빈 글리프로 기억한다.
+    auto newline = atlas.GetGlyph(L'\n');
+    TEST_CHECK(newline->page == -1);
+    TEST_CHECK(newline->advance == 0);
+    atlas.GetGlyph(L'\n');
+    TEST_CHECK(rasterizeCount == 2);
+}
+
+void TestShelfPacking()
+{
+    int rasterizeCount = 0;
+    const int pageSize = 16;
+    CGlyphAtlas atlas(std::unique_ptr<IGlyphSource>(new CFakeGlyphSource(&rasterizeCount)), pageSize);
+
+    // 16x16 페이지에는 6x8 글리프가 한 줄에 두 개, 두 줄 들어간다.
+    auto a = atlas.GetGlyph(L'a');
+    auto b = atlas.GetGlyph(L'b');
+    auto c = atlas.GetGlyph(L'c');
+    auto d = atlas.GetGlyph(L'd');
+    TEST_CHECK(a->page == 0 && a->x == 0 && a->y == 0);
+    TEST_CHECK(b->page == 0 && b->x == GLYPH_WIDTH && b->y == 0);
+    TEST_CHECK(c->page == 0 && c->x == 0 && c->y == GLYPH_HEIGHT);
+    TEST_CHECK(d->page == 0 && d->x == GLYPH_WIDTH && d->y == GLYPH_HEIGHT);
+    TEST_CHECK(atlas.GetPageCount() == 1);
+
+    auto e = atlas.GetGlyph(L'e');
+    TEST_CHECK(e->page == 1 && e->x == 0 && e->y == 0);
+    TEST_CHECK(atlas.GetPageCount() == 2);
+}
+
+void TestDrawString()
+{
+    int rasterizeCount = 0;
+    CGlyphAtlas atlas(std::unique_ptr<IGlyphSource>(new CFakeGlyphSource(&rasterizeCount)));
+
+    CFrameBuffer target(64, 16);
+    target.Clear(0xFF000000);
+    atlas.DrawString(target, 2, 3, L"A B", 0xFFFFFFFF, target.GetBounds());
+
+    // 첫 글자는 (2, 3 + offsetY) 부터 그려지고 공백 자리는 비어 있어야 한다.
+    TEST_CHECK(target.GetRow(4)[2] == 0xFFFFFFFF);
+    TEST_CHECK(target.GetRow(4 + GLYPH_HEIGHT - 1)[2 + GLYPH_WIDTH - 1] == 0xFFFFFFFF);
+    TEST_CHECK(target.GetRow(3)[2] == 0xFF000000);
+    TEST_CHECK(target.GetRow(4)[2 + GLYPH_WIDTH] == 0xFF000000);
+    TEST_CHECK(target.GetRow(4)[2 + (GLYPH_WIDTH + 1)] == 0xFF000000);
+    TEST_CHECK(target.GetRow(4)[2 + (GLYPH_WIDTH + 1) * 2] == 0xFFFFFFFF);
+}
+
+void TestDrawStringClip()
+{
+    int rasterizeCount = 0;
+    CGlyphAtlas atlas(std::unique_ptr<IGlyphSource>(new CFakeGlyphSource(&rasterizeCount)));
+
+    CFrameBuffer target(32, 16);
+    target.Clear(0xFF000000);
+    FrameRect clipingRect{0, 0, 4, 16};
+    atlas.DrawString(target, 0, 0, L"AA", 0xFF00FF00, clipingRect);
+
+    TEST_CHECK(target.GetRow(1)[3] == 0xFF00FF00);
+    TEST_CHECK(target.GetRow(1)[4] == 0xFF000000);
+    TEST_CHECK(target.GetRow(1)[GLYPH_WIDTH + 1] == 0xFF000000);
+}
+
+void TestDrawStringOpacity()
+{
+    int rasterizeCount = 0;
+    CGlyphAtlas atlas(std::unique_ptr<IGlyphSource>(new CFakeGlyphSource(&rasterizeCount)));
+
+    CFrameBuffer target(16, 16);
+    target.Clear(0xFF000000);
+    atlas.DrawString(target, 0, 0, L"A", 0x80FFFFFF, target.GetBounds());
+
+    uint32_t pixel = target.GetRow(1)[0];
+    TEST_CHECK((pixel & 0xFF) == 0x80);
+    TEST_CHECK((pixel >> 24) == 0xFF);
+}
+} // namespace
+
+int main()
+{
+    TEST_RUN(TestGlyphIsRasterizedOnce);
+    TEST_RUN(TestMeasureString);
+    TEST_RUN(TestEmptyGlyphHasNoPage);
+    TEST_RUN(TestShelfPacking);
+    TEST_RUN(TestDrawString);
+    TEST_RUN(TestDrawStringClip);
+    TEST_RUN(TestDrawStringOpacity);
+
+    return TEST_RESULT();
+}
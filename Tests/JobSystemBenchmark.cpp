@@ -0,0 +1,83 @@
+#include "Test.h"
+
+#include "BaseLib/JobSystem.h"
+
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+using namespace jojogame;
+
+namespace
+{
+const int JOB_COUNT = 100000;
+const int PARALLEL_FOR_COUNT = 10000;
+
+// 결과를 남겨서 최적화로 계산이 빠지지 않게 한다.
+volatile double s_result = 0.0;
+
+double Work(int seed, int amount)
+{
+    double value = seed;
+    for (int i = 0; i < amount; ++i)
+    {
+        value = std::sqrt(value + i);
+    }
+
+    return value;
+}
+
+template <typename Function>
+void Measure(const char *name, int jobCount, Function function)
+{
+    double begin = test::GetSeconds();
+    function();
+    double elapsed = test::GetSeconds() - begin;
+
+    std::printf("%-40s %9.3f ms %8.0f jobs/ms\n", name, elapsed * 1000.0, jobCount / (elapsed * 1000.0));
+}
+
+void Run(int workerCount)
+{
+    CJobSystem jobSystem(workerCount);
+    std::printf("JobSystem: %d workers\n", jobSystem.GetWorkerCount());
+
+    Measure("empty jobs", JOB_COUNT, [&] {
+        CJobCounter counter;
+        for (int i = 0; i < JOB_COUNT; ++i)
+        {
+            jobSystem.Schedule([] {}, &counter);
+        }
+        jobSystem.Wait(counter);
+    });
+
+    std::vector<double> results(JOB_COUNT);
+    Measure("jobs with ~1us of work", JOB_COUNT, [&] {
+        CJobCounter counter;
+        for (int i = 0; i < JOB_COUNT; ++i)
+        {
+            jobSystem.Schedule([&results, i] { results[i] = Work(i, 64); }, &counter);
+        }
+        jobSystem.Wait(counter);
+    });
+    s_result = results[JOB_COUNT - 1];
+
+    // 프레임마다 작은 ParallelFor 를 부르는 경우로, 스택 카운터를 만들고 기다리는 비용이 드러난다.
+    Measure("small ParallelFor(8) calls", PARALLEL_FOR_COUNT * 8, [&] {
+        std::atomic<int> total{0};
+        for (int i = 0; i < PARALLEL_FOR_COUNT; ++i)
+        {
+            jobSystem.ParallelFor(8, [&total](int) { ++total; });
+        }
+        s_result = total;
+    });
+}
+} // namespace
+
+int main()
+{
+    Run(0);
+    Run(3);
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include "Test.h"
+
+#include "BaseLib/JobSystem.h"
+
+#include <atomic>
+#include <vector>
+
+using namespace jojogame;
+
+namespace
+{
+void TestScheduleAndWait()
+{
+    CJobSystem jobSystem(3);
+    CJobCounter counter;
+    std::atomic<int> sum{0};
+
+    for (int i = 1; i <= 100; ++i)
+    {
+        jobSystem.Schedule([&sum, i] { sum += i; }, &counter);
+    }
+    jobSystem.Wait(counter);
+
+    TEST_CHECK(counter.IsDone());
+    TEST_CHECK(sum == 5050);
+}
+
+void TestScheduleAfter()
+{
+    CJobSystem jobSystem(3);
+    CJobCounter first;
+    CJobCounter second;
+    std::atomic<int> firstCount{0};
+    std::atomic<int> seenCount{-1};
+
+    for (int i = 0; i < 50; ++i)
+    {
+        jobSystem.Schedule([&firstCount] { ++firstCount; }, &first);
+    }
+    jobSystem.ScheduleAfter(first, [&] { seenCount = firstCount.load(); }, &second);
+    jobSystem.Wait(second);
+
+    // 다음 작업은 앞의 작업이 모두 끝난 뒤에만 돈다.
+    TEST_CHECK(seenCount == 50);
+
+    // 이미 끝난 카운터 뒤에 붙이면 바로 큐에 들어간다.
+    jobSystem.ScheduleAfter(first, [&seenCount] { seenCount = 0; }, &second);
+    jobSystem.Wait(second);
+    TEST_CHECK(seenCount == 0);
+}
+
+void TestParallelFor()
+{
+    CJobSystem jobSystem(3);
+    std::vector<int> values(1000, 0);
+
+    jobSystem.ParallelFor(int(values.size()), [&values](int i) { values[i] = i * 2; });
+
+    bool isFilled = true;
+    for (int i = 0; i < int(values.size()); ++i)
+    {
+        isFilled = isFilled && values[i] == i * 2;
+    }
+    TEST_CHECK(isFilled);
+}
+
+void TestRepeatedParallelFor()
+{
+    // 스택에 있는 카운터가 Wait 직후 지워지므로, 작업 스레드가 그 뒤에 카운터를 건드리면 TSAN 이 잡는다.
+    CJobSystem jobSystem(3);
+    std::atomic<int> total{0};
+
+    for (int round = 0; round < 2000; ++round)
+    {
+        jobSystem.ParallelFor(4, [&total](int) { ++total; });
+    }
+    TEST_CHECK(total == 8000);
+}
+
+void TestNoWorkers()
+{
+    // 작업 스레드가 없으면 부른 자리에서 바로 실행한다.
+    CJobSystem jobSystem(0);
+    CJobCounter counter;
+    int value = 0;
+
+    TEST_CHECK(jobSystem.GetWorkerCount() == 0);
+    TEST_CHECK(jobSystem.GetThreadCount() == 1);
+
+    jobSystem.Schedule([&value] { value = 1; }, &counter);
+    TEST_CHECK(value == 1);
+    TEST_CHECK(counter.IsDone());
+
+    jobSystem.ParallelFor(3, [&value](int i) { value += i; });
+    TEST_CHECK(value == 4);
+}
+
+void TestMainThreadJobs()
+{
+    CJobSystem jobSystem(2);
+    std::atomic<int> wakeUpCount{0};
+    int value = 0;
+
+    jobSystem.SetMainThreadWakeUp([&wakeUpCount] { ++wakeUpCount; });
+
+    CJobCounter counter;
+    jobSystem.Schedule([&] { jobSystem.PostToMainThread([&value] { value = 7; }); }, &counter);
+    jobSystem.Wait(counter);
+
+    TEST_CHECK(value == 0);
+    TEST_CHECK(wakeUpCount == 1);
+    TEST_CHECK(jobSystem.RunMainThreadJobs() == 1);
+    TEST_CHECK(value == 7);
+    TEST_CHECK(jobSystem.RunMainThreadJobs() == 0);
+}
+} // namespace
+
+int main()
+{
+    TEST_RUN(TestScheduleAndWait);
+    TEST_RUN(TestScheduleAfter);
+    TEST_RUN(TestParallelFor);
+    TEST_RUN(TestRepeatedParallelFor);
+    TEST_RUN(TestNoWorkers);
+    TEST_RUN(TestMainThreadJobs);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+#include <string>
+
+#ifndef TEST_OUTPUT_DIR
+#define TEST_OUTPUT_DIR "."
+#endif
+
+namespace jojogame
+{
+namespace test
+{
+inline std::string GetOutputPath(const char *fileName)
+{
+    return std::string(TEST_OUTPUT_DIR) + "/" + fileName;
+}
+
+inline int &GetFailureCount()
+{
+    static int s_failureCount = 0;
+    return s_failureCount;
+}
+
+inline double GetSeconds()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+} // namespace test
+} // namespace jojogame
+
+// 실패해도 멈추지 않고 개수를 센 뒤, 테스트 프로그램의 종료 코드로 돌려준다.
+#define TEST_CHECK(expression)                                                                                         \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expression))                                                                                             \
+        {                                                                                                              \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expression);                                 \
+            ++jojogame::test::GetFailureCount();                                                                       \
+        }                                                                                                              \
+    } while (false)
+
+#define TEST_RUN(function)                                                                                             \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        int failureCount = jojogame::test::GetFailureCount();                                                          \
+        function();                                                                                                    \
+        std::printf("%s %s\n", failureCount == jojogame::test::GetFailureCount() ? "[ OK ]" : "[FAIL]", #function);    \
+    } while (false)
+
+#define TEST_RESULT() (jojogame::test::GetFailureCount() == 0 ? 0 : 1)
@@ -0,0 +1,78 @@
+#include "Test.h"
+
+#include "BaseLib/TimerQueue.h"
+
+#include <random>
+
+using namespace jojogame;
+
+namespace
+{
+const int TIMER_COUNT = 100000;
+const int ROUND_COUNT = 10;
+const int64_t MILLISECOND = 1000000;
+
+template <typename Function>
+void Measure(const char *name, int operationCount, Function function)
+{
+    double begin = test::GetSeconds();
+    function();
+    double elapsed = test::GetSeconds() - begin;
+
+    std::printf("%-36s %9.3f ms %8.1f ns/op\n", name, elapsed * 1000.0, elapsed * 1e9 / operationCount);
+}
+} // namespace
+
+int main()
+{
+    std::mt19937 random(1234);
+    std::uniform_int_distribution<int64_t> dueTimeDistribution(0, 10000 * MILLISECOND);
+
+    CTimerQueue queue;
+    std::vector<int> ids;
+    ids.reserve(TIMER_COUNT);
+
+    std::printf("TimerQueue: %d timers\n", TIMER_COUNT);
+
+    Measure("add", TIMER_COUNT, [&] {
+        for (int i = 0; i < TIMER_COUNT; ++i)
+        {
+            ids.push_back(queue.Add(dueTimeDistribution(random)));
+        }
+    });
+
+    // 예전에는 다시 잡을 때마다 버려진 항목이 힙에 쌓였다.
+    Measure("reschedule all x10", TIMER_COUNT * ROUND_COUNT, [&] {
+        for (int round = 0; round < ROUND_COUNT; ++round)
+        {
+            for (int id : ids)
+            {
+                queue.Reschedule(id, dueTimeDistribution(random));
+            }
+        }
+    });
+
+    // 살아 있는 타이머 수는 그대로 두고 더하고 지우기를 반복한다.
+    Measure("add + remove churn x10", TIMER_COUNT * ROUND_COUNT, [&] {
+        for (int round = 0; round < ROUND_COUNT; ++round)
+        {
+            for (int i = 0; i < TIMER_COUNT; ++i)
+            {
+                queue.Remove(ids[i]);
+                ids[i] = queue.Add(dueTimeDistribution(random));
+            }
+        }
+    });
+
+    std::vector<int> expired;
+    expired.reserve(TIMER_COUNT);
+    Measure("pop all in 100 frames", TIMER_COUNT, [&] {
+        for (int frame = 1; frame <= 100; ++frame)
+        {
+            queue.PopExpired(frame * 100 * MILLISECOND, expired);
+        }
+    });
+
+    std::printf("expired %d, remaining %d\n", int(expired.size()), queue.GetCount());
+    return 0;
+}
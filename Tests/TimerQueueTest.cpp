@@ -0,0 +1,130 @@
+#include "Test.h"
+
+#include "BaseLib/TimerQueue.h"
+
+using namespace jojogame;
+
+namespace
+{
+void TestOrder()
+{
+    CTimerQueue queue;
+    int late = queue.Add(30);
+    int first = queue.Add(10);
+    int second = queue.Add(10);
+
+    TEST_CHECK(queue.GetCount() == 3);
+    TEST_CHECK(queue.GetNextDueTime() == 10);
+
+    // 같은 시각이면 등록한 순서대로 나온다.
+    std::vector<int> expired;
+    TEST_CHECK(queue.PopExpired(20, expired) == 2);
+    TEST_CHECK(expired.size() == 2 && expired[0] == first && expired[1] == second);
+    TEST_CHECK(!queue.IsExist(first));
+    TEST_CHECK(queue.IsExist(late));
+    TEST_CHECK(queue.GetNextDueTime() == 30);
+}
+
+void TestInterval()
+{
+    CTimerQueue queue;
+    int id = queue.Add(10, 10);
+
+    std::vector<int> expired;
+    TEST_CHECK(queue.PopExpired(10, expired) == 1);
+    TEST_CHECK(queue.IsExist(id));
+    TEST_CHECK(queue.GetNextDueTime() == 20);
+
+    // 많이 밀렸으면 한 번만 부르고 지금부터 다시 센다.
+    expired.clear();
+    TEST_CHECK(queue.PopExpired(55, expired) == 1);
+    TEST_CHECK(queue.GetNextDueTime() == 65);
+}
+
+void TestRescheduleAndRemove()
+{
+    CTimerQueue queue;
+    int first = queue.Add(10);
+    int second = queue.Add(20);
+
+    TEST_CHECK(queue.Reschedule(first, 30));
+    TEST_CHECK(queue.GetNextDueTime() == 20);
+
+    TEST_CHECK(queue.Remove(second));
+    TEST_CHECK(!queue.Remove(second));
+    TEST_CHECK(!queue.Reschedule(second, 5));
+    TEST_CHECK(queue.GetNextDueTime() == 30);
+
+    std::vector<int> expired;
+    TEST_CHECK(queue.PopExpired(100, expired) == 1);
+    TEST_CHECK(expired[0] == first);
+    TEST_CHECK(queue.IsEmpty());
+    TEST_CHECK(queue.GetNextDueTime() == INT64_MAX);
+}
+
+void TestManyStaleEntries()
+{
+    // 힙을 다시 만든 뒤에도 남은 타이머의 순서와 만료가 그대로여야 한다.
+    CTimerQueue queue;
+    std::vector<int> ids;
+    for (int i = 0; i < 1000; ++i)
+    {
+        ids.push_back(queue.Add(1000 + i));
+    }
+
+    for (int round = 0; round < 5; ++round)
+    {
+        for (int i = 0; i < 1000; i += 2)
+        {
+            TEST_CHECK(queue.Reschedule(ids[i], 5000 - i - round));
+        }
+    }
+    for (int i = 1; i < 1000; i += 4)
+    {
+        TEST_CHECK(queue.Remove(ids[i]));
+    }
+
+    TEST_CHECK(queue.GetCount() == 750);
+    TEST_CHECK(queue.GetNextDueTime() == 1003);
+
+    std::vector<int> expired;
+    TEST_CHECK(queue.PopExpired(10000, expired) == 750);
+
+    bool isSorted = true;
+    int64_t lastDueTime = 0;
+    for (int id : expired)
+    {
+        int index = id - ids[0];
+        int64_t dueTime = index % 2 == 0 ? 5000 - index - 4 : 1000 + index;
+        isSorted = isSorted && dueTime >= lastDueTime;
+        lastDueTime = dueTime;
+    }
+    TEST_CHECK(isSorted);
+    TEST_CHECK(queue.IsEmpty());
+}
+
+void TestClear()
+{
+    CTimerQueue queue;
+    int id = queue.Add(10);
+    queue.Clear();
+
+    TEST_CHECK(queue.IsEmpty());
+    TEST_CHECK(!queue.IsExist(id));
+
+    std::vector<int> expired;
+    TEST_CHECK(queue.PopExpired(100, expired) == 0);
+    TEST_CHECK(queue.Add(10) != id);
+}
+} // namespace
+
+int main()
+{
+    TEST_RUN(TestOrder);
+    TEST_RUN(TestInterval);
+    TEST_RUN(TestRescheduleAndRemove);
+    TEST_RUN(TestManyStaleEntries);
+    TEST_RUN(TestClear);
+
+    return TEST_RESULT();
+}
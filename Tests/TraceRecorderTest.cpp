@@ -0,0 +1,97 @@
+#include "Test.h"
+
+#include "BaseLib/TraceRecorder.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace jojogame;
+
+namespace
+{
+std::string Record(void (*function)())
+{
+    std::string path = test::GetOutputPath("TraceRecorderTest.json");
+
+    auto &recorder = CTraceRecorder::GetInstance();
+    TEST_CHECK(recorder.Start(path));
+    function();
+    recorder.Stop();
+
+    std::ifstream file(path);
+    std::stringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+bool Contains(const std::string &text, const std::string &part)
+{
+    return text.find(part) != std::string::npos;
+}
+
+void TestNameBeforeRecording()
+{
+    // 기록을 시작하기 전에 붙인 이름도 첫 이벤트와 함께 써야 한다.
+    std::thread([] {
+        TRACE_THREAD_NAME("Named Early");
+        TRACE_THREAD_NAME("Named Early");
+
+        std::string text = Record([] { TRACE_SCOPE("EarlyScope"); });
+        TEST_CHECK(Contains(text, "\"name\":\"Named Early\""));
+        TEST_CHECK(Contains(text, "\"name\":\"EarlyScope\""));
+    }).join();
+}
+
+void TestRename()
+{
+    std::thread([] {
+        std::string text = Record([] {
+            TRACE_THREAD_NAME("First");
+            TRACE_SCOPE("RenameScope");
+            TRACE_THREAD_NAME("Second");
+        });
+        TEST_CHECK(Contains(text, "\"name\":\"Second\""));
+    }).join();
+}
+
+void TestEventsOfFinishedThread()
+{
+    // 기록 중에 끝난 스레드의 이벤트도 빠지지 않는다.
+    std::string text = Record([] {
+        std::thread([] {
+            TRACE_THREAD_NAME("Short Lived");
+            TRACE_COUNTER("ShortCounter", 7);
+        }).join();
+    });
+    TEST_CHECK(Contains(text, "\"name\":\"Short Lived\""));
+    TEST_CHECK(Contains(text, "\"name\":\"ShortCounter\""));
+
+    // 이미 끝난 스레드의 이름이 다음 기록에 다시 나오지 않는다.
+    text = Record([] { TRACE_SCOPE("NextScope"); });
+    TEST_CHECK(!Contains(text, "Short Lived"));
+}
+
+void TestNotRecording()
+{
+    std::thread([] {
+        TRACE_THREAD_NAME("Idle");
+        TRACE_COUNTER("IdleCounter", 1);
+        TRACE_SCOPE("IdleScope");
+    }).join();
+
+    std::string text = Record([] {});
+    TEST_CHECK(!Contains(text, "Idle"));
+}
+} // namespace
+
+int main()
+{
+    TEST_RUN(TestNameBeforeRecording);
+    TEST_RUN(TestRename);
+    TEST_RUN(TestEventsOfFinishedThread);
+    TEST_RUN(TestNotRecording);
+
+    return TEST_RESULT();
+}
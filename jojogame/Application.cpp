@@ -3,13 +3,21 @@
 #include "Application.h"
 #include "LuaConsole.h"
 
+#include "BaseLib/JobSystem.h"
 #include "BaseLib/MemoryPool.h"
 #include "CommonLib/GameManager.h"
 #include "CommonLib/FileManager.h"
+#include "CommonLib/ProfileManager.h"
 #include "LuaLib/LuaTinker.h"
 #include "UILib/ControlManager.h"
 #include "UILib/WindowControl.h"
 #include "UILib/LayoutControl.h"
+#include "UILib/ScaledImageCache.h"
+#include "UILib/FontCache.h"
+#include "UILib/TileRenderer.h"
+#include "UILib/AnimationManager.h"
+#include "UILib/InputManager.h"
+#include "UILib/PerformanceHud.h"
 #include "CommonLib/ME5File.h"
 
 using namespace std::chrono_literals;
@@ -41,11 +49,9 @@ HINSTANCE Application::GetHInstance()
 
 void Application::Render()
 {
-    auto layouts = _controlManager->GetLayouts();
-    for (auto layout : layouts)
-    {
-        layout->Refresh();
-    }
+    PROFILE_ZONE("Render");
+
+    _controlManager->RefreshDirtyLayouts();
 }
 
 int Application::Run()
@@ -72,38 +78,120 @@ int Application::Run()
     luaTinker.RegisterClassToLua<CME5File>();
     luaTinker.RegisterClassToLua<CGameManager>();
     luaTinker.RegisterClassToLua<CFileManager>();
+    luaTinker.RegisterClassToLua<CProfileManager>();
 
     luaTinker.RegisterVariable("controlManager", _controlManager);
     luaTinker.RegisterVariable("gameManager", _gameManager);
     luaTinker.RegisterVariable("fileManager", _fileManager);
+    luaTinker.RegisterVariable("profileManager", &CProfileManager::GetInstance());
+    luaTinker.RegisterVariable("imageCache", &CScaledImageCache::GetInstance());
+    luaTinker.RegisterVariable("fontCache", &CFontCache::GetInstance());
+    luaTinker.RegisterVariable("tileRenderer", &CTileRenderer::GetInstance());
+    luaTinker.RegisterVariable("inputManager", &CInputManager::GetInstance());
+    luaTinker.RegisterVariable("performanceHud", &CPerformanceHud::GetInstance());
 
     luaTinker.RegisterFunction("OUTPUT", &CConsoleOutput::OutputConsoles);
     luaTinker.RegisterFunction("DEBUG", &CLuaConsole::SetDebugFlag);
+    luaTinker.RegisterFunction("HUD", &CPerformanceHud::SetHudFlag);
 
     luaTinker.Run("./Script/main.lua");
 
-    using clock = std::chrono::high_resolution_clock;
-
     constexpr std::chrono::nanoseconds timestep(16ms);
-    std::chrono::nanoseconds lag(0ns);
-    auto time_start = clock::now();
+    const int timestepMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(timestep).count());
+
+    CFrameScheduler &scheduler = _gameManager->GetFrameScheduler();
+    CProfiler &profiler = CProfiler::GetInstance();
+    CTraceRecorder &traceRecorder = CTraceRecorder::GetInstance();
+    CPerformanceHud &performanceHud = CPerformanceHud::GetInstance();
+    int64_t frameUpdateTime = 0;
+    TRACE_THREAD_NAME("Main");
+    scheduler.SetTimestep(timestep.count());
+    scheduler.Start();
+
+    // 메인 루프 밖에서 메시지를 처리하며 기다리는 동안에도 모인 입력을 보낸다.
+    _gameManager->SetInputDispatch([]() {
+        CInputManager::GetInstance().Dispatch();
+    });
+
+    DWORD mainThreadId = GetCurrentThreadId();
+    CJobSystem::GetInstance().SetMainThreadWakeUp([mainThreadId]() {
+        // 메인 스레드에서 올린 작업은 이번 루프에서 바로 처리되므로 깨울 필요가 없다.
+        if (GetCurrentThreadId() != mainThreadId)
+        {
+            PostThreadMessage(mainThreadId, WM_NULL, 0, 0);
+        }
+    });
+
+    // 고해상도 타이머를 지원하지 않는 OS 에서는 일반 대기 타이머를 쓴다.
+    HANDLE timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (timer == nullptr)
+    {
+        timer = CreateWaitableTimer(nullptr, FALSE, nullptr);
+    }
 
     while (WM_QUIT != message.message)
     {
-        auto delta_time = clock::now() - time_start;
-        time_start = clock::now();
-        lag += std::chrono::duration_cast<std::chrono::nanoseconds>(delta_time);
+        bool isDirty = false;
+        {
+            PROFILE_ZONE("Message");
+            while (PeekMessage(&message, nullptr, 0, 0, PM_REMOVE))
+            {
+                if (message.message == WM_QUIT)
+                {
+                    break;
+                }
+
+                // Ctrl+F11 로 트레이스 기록을 켜고 끈다.
+                if (message.message == WM_KEYDOWN && message.wParam == VK_F11 && GetKeyState(VK_CONTROL) < 0)
+                {
+                    if (CTraceRecorder::IsRecording())
+                    {
+                        traceRecorder.Stop();
+                    }
+                    else
+                    {
+                        traceRecorder.Start("trace.json");
+                    }
+                    continue;
+                }
 
-        if (PeekMessage(&message, nullptr, 0, 0, PM_NOREMOVE))
+                // Ctrl+F9 로 성능 표시를 켜고 끈다.
+                if (message.message == WM_KEYDOWN && message.wParam == VK_F9 && GetKeyState(VK_CONTROL) < 0)
+                {
+                    performanceHud.Toggle();
+                    continue;
+                }
+
+                TranslateMessage(&message);
+                DispatchMessage(&message);
+                isDirty = true;
+            }
+        }
+
+        if (message.message == WM_QUIT)
         {
-            GetMessage(&message, 0, 0, 0);
-            TranslateMessage(&message);
-            DispatchMessage(&message);
+            break;
         }
 
-        while (lag >= timestep)
+        if (_gameManager->UpdateTimers() > 0)
         {
-            lag -= timestep;
+            isDirty = true;
+        }
+
+        if (CJobSystem::GetInstance().RunMainThreadJobs() > 0)
+        {
+            isDirty = true;
+        }
+
+        int updateCount = scheduler.Advance();
+        int64_t updateBegin = scheduler.GetNow();
+        for (int i = 0; i < updateCount; ++i)
+        {
+            PROFILE_ZONE("Update");
+
+            CAnimationManager::GetInstance().Update(timestepMs);
+            _gameManager->UpdateYieldedCoroutines();
+            CInputManager::GetInstance().Dispatch();
 
             auto updateEvent = _gameManager->GetUpdateEvent();
             if (updateEvent != LUA_NOREF)
@@ -111,9 +199,62 @@ int Application::Run()
                 CLuaTinker::GetLuaTinker().Call(updateEvent);
             }
         }
+        if (updateCount > 0)
+        {
+            frameUpdateTime += scheduler.GetNow() - updateBegin;
+        }
+
+        if (CProfiler::IsRecording())
+        {
+            profiler.SetCounter("skipped updates", scheduler.GetSkippedUpdateCount());
+            profiler.SetCounter("late frames", scheduler.GetLateFrameCount());
+            profiler.Collect();
+        }
+
+        TRACE_COUNTER("Skipped Updates", scheduler.GetSkippedUpdateCount());
+        TRACE_COUNTER("Late Frames", scheduler.GetLateFrameCount());
+
+        if (scheduler.ShouldRender(isDirty || updateCount > 0))
+        {
+            int64_t renderBegin = scheduler.GetNow();
+            Render();
+            performanceHud.EndFrame(frameUpdateTime, scheduler.GetNow() - renderBegin);
+            frameUpdateTime = 0;
+            scheduler.OnRendered();
+            continue;
+        }
+
+        // 다음 업데이트나 렌더 시점, 또는 입력이 들어올 때까지 쉰다.
+        int64_t waitTime = _gameManager->GetWaitTime();
+        if (waitTime > 0)
+        {
+            if (timer != nullptr)
+            {
+                LARGE_INTEGER dueTime;
+                dueTime.QuadPart = -(waitTime / 100);
+                SetWaitableTimer(timer, &dueTime, 0, nullptr, nullptr, FALSE);
+                MsgWaitForMultipleObjectsEx(1, &timer, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+            }
+            else
+            {
+                MsgWaitForMultipleObjectsEx(0, nullptr, static_cast<DWORD>(waitTime / 1000000), QS_ALLINPUT,
+                                            MWMO_INPUTAVAILABLE);
+            }
+        }
+    }
 
-        Render();
+    if (timer != nullptr)
+    {
+        CloseHandle(timer);
     }
+    CJobSystem::GetInstance().SetMainThreadWakeUp(nullptr);
+    _gameManager->SetInputDispatch(nullptr);
+
+#if JOJO_PROFILE
+    // 기록한 구역이 있을 때만 남긴다.
+    profiler.SaveCsv("profile.csv");
+#endif
+    traceRecorder.Stop();
 
     _gameManager->SetQuit(true);
     CMemoryPoolManager::GetInstance().DestroyAllMemoryPool();